@@ -0,0 +1,31 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class FaerieDataSystemTests : ModuleRules
+{
+    public FaerieDataSystemTests(ReadOnlyTargetRules Target) : base(Target)
+    {
+        FaerieDataUtils.ApplySharedModuleSetup(this, Target);
+
+        // Engine dependencies
+        PrivateDependencyModuleNames.AddRange(
+            new []
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "GameplayTags"
+            });
+
+        // Plugin dependencies
+        PrivateDependencyModuleNames.AddRange(
+            new []
+            {
+                "FaerieDataUtils",
+                "FaerieInventory",
+                "FaerieInventoryContent",
+                "FaerieItemData"
+            });
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieInventoryHashStatics.h"
+#include "FaerieItem.h"
+#include "FaerieItemStorage.h"
+#include "FaerieTestTokens.h"
+#include "FaerieTestUtils.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFaerieHashBenchmark, "Faerie.Benchmarks.Hashing",
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags_ApplicationContextMask)
+
+bool FFaerieHashBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Faerie::Tests;
+
+	FBenchmarkReport Report(TEXT("Hashing"));
+
+	auto ContentHash = [](const UFaerieItem* Item)
+		{
+			return Item->GetContentHash();
+		};
+
+	for (const int32 Num : {10, 1000, 100000})
+	{
+		TStrongObjectPtr<UFaerieItemStorage> Storage(MakeStorage());
+		TArray<FFaerieItemStack> Stacks;
+		Stacks.Reserve(Num);
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Stacks.Add({MakeItem(i), 1});
+		}
+		Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::OnlyNewStacks);
+
+		TSet<const UFaerieItem*> ItemSet;
+		ItemSet.Reserve(Num);
+		for (const FFaerieItemStack& Stack : Stacks)
+		{
+			ItemSet.Add(Stack.Item.Get());
+		}
+
+		// Results are accumulated, so the calls can't be optimized away.
+		uint32 Accumulated = 0;
+
+		Report.Measure(TEXT("HashObjectByProps"), Num, Num, [&]()
+		{
+			for (const FFaerieItemStack& Stack : Stacks)
+			{
+				Accumulated ^= Faerie::Hash::HashObjectByProps(Stack.Item->GetToken<UFaerieTestToken>(), true);
+			}
+		});
+
+		Report.Measure(TEXT("GetContentHash"), Num, Num, [&]()
+		{
+			for (const FFaerieItemStack& Stack : Stacks)
+			{
+				Accumulated ^= Stack.Item->GetContentHash();
+			}
+		});
+
+		Report.Measure(TEXT("HashItemSet"), Num, Num, [&]()
+		{
+			Accumulated ^= Faerie::Hash::HashItemSet(ItemSet, ContentHash).Hash;
+		});
+
+		Report.Measure(TEXT("HashContainer"), Num, Num, [&]()
+		{
+			Accumulated ^= Faerie::Hash::HashContainer(Storage.Get(), ContentHash).Hash;
+		});
+
+		AddInfo(FString::Printf(TEXT("%i items hashed to %u"), Num, Accumulated));
+	}
+
+	const FString Path = Report.WriteCsv();
+	TestFalse(TEXT("CSV written"), Path.IsEmpty());
+	AddInfo(FString::Printf(TEXT("Wrote %s"), *Path));
+	return true;
+}
+
+#endif
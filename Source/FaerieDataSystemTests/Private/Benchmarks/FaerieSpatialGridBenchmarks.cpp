@@ -0,0 +1,139 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieItemStorage.h"
+#include "FaerieTestUtils.h"
+#include "ItemContainerEvent.h"
+#include "Extensions/InventorySpatialGridExtension.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFaerieSpatialGridBenchmark, "Faerie.Benchmarks.SpatialGrid",
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags_ApplicationContextMask)
+
+bool FFaerieSpatialGridBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Faerie::Tests;
+
+	FBenchmarkReport Report(TEXT("SpatialGrid"));
+
+	for (const int32 Size : {8, 32, 64, 128})
+	{
+		// The same seed for every size, so runs are comparable between builds.
+		FRandomStream Stream(1337);
+
+		TStrongObjectPtr<UFaerieItemStorage> Storage(MakeStorage());
+		UInventorySpatialGridExtension* Grid = CastChecked<UInventorySpatialGridExtension>(
+			Storage->AddExtensionByClass(UInventorySpatialGridExtension::StaticClass()));
+		Grid->SetGridSize(FIntPoint(Size));
+
+		// Shapes average about three cells, so this is enough to fill the grid, and have the last adds fail.
+		const int32 Cells = Size * Size;
+		const int32 Attempts = Cells / 2;
+
+		TArray<FFaerieItemStack> Stacks;
+		Stacks.Reserve(Attempts);
+		for (int32 i = 0; i < Attempts; ++i)
+		{
+			Stacks.Add({MakeShapedItem(i, MakeRandomShape(Stream, 5)), 1});
+		}
+
+		int32 Added = 0;
+		Report.Measure(TEXT("AddShapedStack"), Cells, Attempts, [&]()
+		{
+			for (const FFaerieItemStack& Stack : Stacks)
+			{
+				Added += Storage->AddItemStack(Stack, EFaerieStorageAddStackBehavior::OnlyNewStacks) ? 1 : 0;
+			}
+		});
+		AddInfo(FString::Printf(TEXT("%ix%i grid placed %i of %i shapes"), Size, Size, Added, Attempts));
+
+		constexpr int32 Queries = 1000;
+		TArray<FFaerieGridShape> QueryShapes;
+		QueryShapes.Reserve(Queries);
+		for (int32 i = 0; i < Queries; ++i)
+		{
+			QueryShapes.Add(MakeRandomShape(Stream, 5));
+		}
+
+		int32 Fits = 0;
+		Report.Measure(TEXT("CanAddItemToGrid"), Cells, Queries, [&]()
+		{
+			for (const FFaerieGridShape& Shape : QueryShapes)
+			{
+				Fits += Grid->CanAddItemToGrid(Shape) ? 1 : 0;
+			}
+		});
+		AddInfo(FString::Printf(TEXT("%ix%i grid had room for %i of %i queried shapes"), Size, Size, Fits, Queries));
+
+		const int32 Entries = Storage->GetStackCount();
+		Report.Measure(TEXT("Clear"), Cells, Entries, [&]()
+		{
+			Storage->Clear(Faerie::Inventory::Tags::RemovalDeletion);
+		});
+		TestEqual(TEXT("Entries after clear"), Storage->GetStackCount(), 0);
+	}
+
+	const FString Path = Report.WriteCsv();
+	TestFalse(TEXT("CSV written"), Path.IsEmpty());
+	AddInfo(FString::Printf(TEXT("Wrote %s"), *Path));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFaerieSpatialGridAutoArrangeBenchmark, "Faerie.Benchmarks.SpatialGridAutoArrange",
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags_ApplicationContextMask)
+
+bool FFaerieSpatialGridAutoArrangeBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Faerie::Tests;
+
+	FBenchmarkReport Report(TEXT("SpatialGridAutoArrange"));
+
+	for (const int32 Size : {8, 32, 64})
+	{
+		// Several shape sets per size, as how well and how fast shapes pack depends on the set.
+		for (const int32 Seed : {1, 2, 3})
+		{
+			FRandomStream Stream(Seed);
+
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeStorage());
+			UInventorySpatialGridExtension* Grid = CastChecked<UInventorySpatialGridExtension>(
+				Storage->AddExtensionByClass(UInventorySpatialGridExtension::StaticClass()));
+			Grid->SetGridSize(FIntPoint(Size));
+
+			const int32 Cells = Size * Size;
+			for (int32 i = 0; i < Cells / 2; ++i)
+			{
+				Storage->AddItemStack({MakeShapedItem(i, MakeRandomShape(Stream, 5)), 1}, EFaerieStorageAddStackBehavior::OnlyNewStacks);
+			}
+
+			// Remove every other entry, leaving the grid fragmented.
+			TArray<FEntryKey> Keys;
+			Storage->GetAllKeys(Keys);
+			TArray<FEntryKey> Removed;
+			for (int32 i = 0; i < Keys.Num(); i += 2)
+			{
+				Removed.Add(Keys[i]);
+			}
+			Storage->RemoveBatch(Removed, Faerie::Inventory::Tags::RemovalDeletion);
+
+			const int32 Entries = Storage->GetStackCount();
+			bool bArranged = false;
+			Report.Measure(*FString::Printf(TEXT("AutoArrange_Seed%i"), Seed), Cells, Entries, [&]()
+			{
+				bArranged = Grid->AutoArrange(0.f);
+			});
+			AddInfo(FString::Printf(TEXT("%ix%i grid with seed %i %s %i stacks"),
+				Size, Size, Seed, bArranged ? TEXT("arranged") : TEXT("could not arrange"), Entries));
+		}
+	}
+
+	const FString Path = Report.WriteCsv();
+	TestFalse(TEXT("CSV written"), Path.IsEmpty());
+	AddInfo(FString::Printf(TEXT("Wrote %s"), *Path));
+	return true;
+}
+
+#endif
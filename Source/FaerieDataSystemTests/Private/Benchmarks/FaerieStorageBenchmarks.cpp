@@ -0,0 +1,221 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieItemStorage.h"
+#include "FaerieTestUtils.h"
+#include "ItemContainerEvent.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Faerie::Tests
+{
+	// Fill a new storage with Num distinct entries, each holding Copies copies.
+	static UFaerieItemStorage* MakeFilledStorage(const int32 Num, const int32 Copies, TArray<FEntryKey>& OutKeys)
+	{
+		UFaerieItemStorage* Storage = MakeStorage();
+		TArray<FFaerieItemStack> Stacks;
+		Stacks.Reserve(Num);
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Stacks.Add({MakeItem(i), Copies});
+		}
+		Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::OnlyNewStacks);
+		Storage->GetAllKeys(OutKeys);
+		return Storage;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFaerieItemStorageBenchmark, "Faerie.Benchmarks.ItemStorage",
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags_ApplicationContextMask)
+
+bool FFaerieItemStorageBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Faerie::Tests;
+
+	FBenchmarkReport Report(TEXT("ItemStorage"));
+
+	for (const int32 Num : {10, 1000, 100000})
+	{
+		// Items are made before timing starts, so only storage work is measured.
+		TArray<UFaerieItem*> Items;
+		Items.Reserve(Num);
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Items.Add(MakeItem(i));
+		}
+
+		// Add
+		{
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeStorage());
+			Report.Measure(TEXT("AddItemStack"), Num, Num, [&]()
+			{
+				for (UFaerieItem* Item : Items)
+				{
+					Storage->AddItemStack({Item, 1}, EFaerieStorageAddStackBehavior::AddToAnyStack);
+				}
+			});
+			TestEqual(TEXT("AddItemStack entries"), Storage->GetStackCount(), Num);
+		}
+
+		{
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeStorage());
+			TArray<FFaerieItemStack> Stacks;
+			Stacks.Reserve(Num);
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Stacks.Add({MakeItem(i), 1});
+			}
+			Report.Measure(TEXT("AddBatch"), Num, Num, [&]()
+			{
+				Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::AddToAnyStack);
+			});
+			TestEqual(TEXT("AddBatch entries"), Storage->GetStackCount(), Num);
+		}
+
+		// Query
+		{
+			TArray<FEntryKey> Keys;
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeFilledStorage(Num, 1, Keys));
+
+			int32 Found = 0;
+			Report.Measure(TEXT("KeyLookup"), Num, Num, [&]()
+			{
+				for (const FEntryKey Key : Keys)
+				{
+					Found += Storage->GetStack(Key);
+				}
+			});
+			TestEqual(TEXT("KeyLookup found"), Found, Num);
+
+			Faerie::FStorageViewQuery Query;
+			Query.Filter.BindLambda([](const FFaerieItemStackView View)
+			{
+				return GetItemValue(View.Item.Get()) % 2 == 0;
+			});
+			Query.Sort.BindLambda([](const FFaerieItemStackView A, const FFaerieItemStackView B)
+			{
+				return GetItemValue(A.Item.Get()) > GetItemValue(B.Item.Get());
+			});
+
+			constexpr int32 Queries = 10;
+			TArray<FKeyedInventoryEntry> Results;
+			Report.Measure(TEXT("QueryAllView"), Num, Queries, [&]()
+			{
+				for (int32 i = 0; i < Queries; ++i)
+				{
+					Storage->QueryAllView(Query, Results);
+				}
+			});
+		}
+
+		// Split and merge
+		{
+			TArray<FEntryKey> Keys;
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeFilledStorage(Num, 2, Keys));
+
+			TArray<FStackKey> StackKeys;
+			StackKeys.Reserve(Num);
+			for (const FEntryKey Key : Keys)
+			{
+				StackKeys.Add(Storage->GetInvKeysForEntry(Key)[0].StackKey);
+			}
+
+			int32 Split = 0;
+			Report.Measure(TEXT("SplitStack"), Num, Num, [&]()
+			{
+				for (int32 i = 0; i < Num; ++i)
+				{
+					Split += Storage->SplitStack(Keys[i], StackKeys[i], 1) ? 1 : 0;
+				}
+			});
+			TestEqual(TEXT("SplitStack succeeded"), Split, Num);
+
+			TArray<FStackKey> SplitKeys;
+			SplitKeys.Reserve(Num);
+			for (const FEntryKey Key : Keys)
+			{
+				SplitKeys.Add(Storage->GetInvKeysForEntry(Key).Last().StackKey);
+			}
+
+			int32 Merged = 0;
+			Report.Measure(TEXT("MergeStacks"), Num, Num, [&]()
+			{
+				for (int32 i = 0; i < Num; ++i)
+				{
+					Merged += Storage->MergeStacks(Keys[i], SplitKeys[i], StackKeys[i]) ? 1 : 0;
+				}
+			});
+			TestEqual(TEXT("MergeStacks succeeded"), Merged, Num);
+		}
+
+		// Move
+		{
+			TArray<FEntryKey> Keys;
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeFilledStorage(Num, 1, Keys));
+			TStrongObjectPtr<UFaerieItemStorage> Target(MakeStorage());
+
+			Report.Measure(TEXT("MoveEntry"), Num, Num, [&]()
+			{
+				for (const FEntryKey Key : Keys)
+				{
+					Storage->MoveEntry(Target.Get(), Key, EFaerieStorageAddStackBehavior::AddToAnyStack);
+				}
+			});
+			TestEqual(TEXT("MoveEntry entries"), Target->GetStackCount(), Num);
+
+			Report.Measure(TEXT("Dump"), Num, Num, [&]()
+			{
+				Target->Dump(Storage.Get());
+			});
+			TestEqual(TEXT("Dump entries"), Storage->GetStackCount(), Num);
+		}
+
+		// Remove
+		{
+			TArray<FEntryKey> Keys;
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeFilledStorage(Num, 1, Keys));
+
+			// Removed from the back, so this measures the cost of each removal, not of shifting the sorted array.
+			Report.Measure(TEXT("RemoveEntry"), Num, Num, [&]()
+			{
+				for (int32 i = Keys.Num() - 1; i >= 0; --i)
+				{
+					Storage->RemoveEntry(Keys[i], Faerie::Inventory::Tags::RemovalDeletion);
+				}
+			});
+			TestEqual(TEXT("RemoveEntry entries"), Storage->GetStackCount(), 0);
+		}
+
+		{
+			TArray<FEntryKey> Keys;
+			TStrongObjectPtr<UFaerieItemStorage> Storage(MakeFilledStorage(Num, 1, Keys));
+
+			TArray<FEntryKey> EveryOther;
+			for (int32 i = 0; i < Keys.Num(); i += 2)
+			{
+				EveryOther.Add(Keys[i]);
+			}
+
+			Report.Measure(TEXT("RemoveBatch"), Num, EveryOther.Num(), [&]()
+			{
+				Storage->RemoveBatch(EveryOther, Faerie::Inventory::Tags::RemovalDeletion);
+			});
+			TestEqual(TEXT("RemoveBatch entries"), Storage->GetStackCount(), Num - EveryOther.Num());
+
+			const int32 Remaining = Storage->GetStackCount();
+			Report.Measure(TEXT("Clear"), Num, Remaining, [&]()
+			{
+				Storage->Clear(Faerie::Inventory::Tags::RemovalDeletion);
+			});
+			TestEqual(TEXT("Clear entries"), Storage->GetStackCount(), 0);
+		}
+	}
+
+	const FString Path = Report.WriteCsv();
+	TestFalse(TEXT("CSV written"), Path.IsEmpty());
+	AddInfo(FString::Printf(TEXT("Wrote %s"), *Path));
+	return true;
+}
+
+#endif
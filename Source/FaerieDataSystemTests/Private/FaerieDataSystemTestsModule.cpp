@@ -0,0 +1,17 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieDataSystemTestsModule.h"
+
+#define LOCTEXT_NAMESPACE "FaerieDataSystemTestsModule"
+
+void FFaerieDataSystemTestsModule::StartupModule()
+{
+}
+
+void FFaerieDataSystemTestsModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FFaerieDataSystemTestsModule, FaerieDataSystemTests)
@@ -0,0 +1,12 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+class FFaerieDataSystemTestsModule final : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
@@ -0,0 +1,51 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "FaerieItemToken.h"
+#include "Tokens/FaerieShapeToken.h"
+#include "FaerieTestTokens.generated.h"
+
+/**
+ * A token used by tests to make items distinct from each other. Items whose test tokens share a Value are identical,
+ * and will stack, unless the token is mutable.
+ */
+UCLASS(HideDropdown, NotBlueprintable)
+class UFaerieTestToken : public UFaerieItemToken
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool IsMutable() const override { return bMutable; }
+
+protected:
+	virtual bool CompareWithImpl(const UFaerieItemToken* Other) const override
+	{
+		return CastChecked<ThisClass>(Other)->Value == Value;
+	}
+
+	virtual uint32 GetCompareHashImpl() const override
+	{
+		return GetTypeHash(Value);
+	}
+
+public:
+	UPROPERTY()
+	int32 Value = 0;
+
+	UPROPERTY()
+	bool bMutable = false;
+};
+
+/**
+ * A shape token whose shape can be set by tests.
+ */
+UCLASS(HideDropdown, NotBlueprintable)
+class UFaerieTestShapeToken : public UFaerieShapeToken
+{
+	GENERATED_BODY()
+
+public:
+	// Must be called before the shape is first compiled, as the compiled shape is cached.
+	void SetShape(const FFaerieGridShape& NewShape) { Shape = NewShape; }
+};
@@ -0,0 +1,103 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieTestUtils.h"
+#include "FaerieItem.h"
+#include "FaerieItemStorage.h"
+#include "FaerieTestTokens.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFaerieBenchmark, Log, All);
+
+namespace Faerie::Tests
+{
+	UFaerieItem* MakeItem(const int32 Value, const bool bMutable)
+	{
+		UFaerieItem* Item = UFaerieItem::CreateInstance();
+		UFaerieTestToken* Token = NewObject<UFaerieTestToken>(Item);
+		Token->Value = Value;
+		Token->bMutable = bMutable;
+		Item->AddToken(Token);
+		return Item;
+	}
+
+	UFaerieItem* MakeShapedItem(const int32 Value, const FFaerieGridShape& Shape)
+	{
+		UFaerieItem* Item = MakeItem(Value);
+		UFaerieTestShapeToken* Token = NewObject<UFaerieTestShapeToken>(Item);
+		Token->SetShape(Shape);
+		Item->AddToken(Token);
+		return Item;
+	}
+
+	FFaerieGridShape MakeRandomShape(FRandomStream& Stream, const int32 MaxCells)
+	{
+		static const FIntPoint Directions[] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+
+		FFaerieGridShape Shape;
+		Shape.Points.Add(FIntPoint::ZeroValue);
+
+		const int32 NumCells = Stream.RandRange(1, FMath::Max(1, MaxCells));
+		FIntPoint Point = FIntPoint::ZeroValue;
+		while (Shape.Points.Num() < NumCells)
+		{
+			Point += Directions[Stream.RandHelper(UE_ARRAY_COUNT(Directions))];
+			Shape.Points.AddUnique(Point);
+		}
+
+		Shape.NormalizeInline();
+		return Shape;
+	}
+
+	UFaerieItemStorage* MakeStorage()
+	{
+		return NewObject<UFaerieItemStorage>(GetTransientPackage());
+	}
+
+	int32 GetItemValue(const UFaerieItem* Item)
+	{
+		if (const UFaerieTestToken* Token = IsValid(Item) ? Item->GetToken<UFaerieTestToken>() : nullptr)
+		{
+			return Token->Value;
+		}
+		return INDEX_NONE;
+	}
+
+	FBenchmarkReport::FBenchmarkReport(const FString& Suite)
+	  : Suite(Suite)
+	{
+	}
+
+	void FBenchmarkReport::Add(const TCHAR* Name, const int32 Entries, const int32 Operations, const double Seconds)
+	{
+		const double NsPerOp = Operations > 0 ? Seconds * 1e9 / Operations : 0.0;
+		UE_LOG(LogFaerieBenchmark, Display, TEXT("%s: %s with %i entries: %i ops in %.3fms (%.1fns/op)"),
+			*Suite, Name, Entries, Operations, Seconds * 1000.0, NsPerOp);
+		Results.Add({Name, Entries, Operations, Seconds});
+	}
+
+	FString FBenchmarkReport::WriteCsv() const
+	{
+		FString Directory;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("FaerieBenchmarkDir="), Directory))
+		{
+			Directory = FPaths::Combine(FPaths::AutomationDir(), TEXT("FaerieBenchmarks"));
+		}
+		const FString Path = FPaths::Combine(Directory, Suite + TEXT(".csv"));
+
+		FString Csv = TEXT("Benchmark,Entries,Operations,TotalMs,NsPerOp\n");
+		for (const FResult& Result : Results)
+		{
+			const double NsPerOp = Result.Operations > 0 ? Result.Seconds * 1e9 / Result.Operations : 0.0;
+			Csv += FString::Printf(TEXT("%s,%i,%i,%f,%f\n"),
+				*Result.Name, Result.Entries, Result.Operations, Result.Seconds * 1000.0, NsPerOp);
+		}
+
+		if (!FFileHelper::SaveStringToFile(Csv, *Path))
+		{
+			return FString();
+		}
+		return Path;
+	}
+}
@@ -0,0 +1,63 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+class UFaerieItem;
+class UFaerieItemStorage;
+struct FFaerieGridShape;
+struct FRandomStream;
+
+namespace Faerie::Tests
+{
+	// Create an item with a test token. Items made with the same Value are identical, unless they are mutable.
+	UFaerieItem* MakeItem(int32 Value, bool bMutable = false);
+
+	// Create a uniquely valued item with a shape, for spatial grids.
+	UFaerieItem* MakeShapedItem(int32 Value, const FFaerieGridShape& Shape);
+
+	// Create a connected shape of 1 to MaxCells cells, by walking from the origin in random directions.
+	FFaerieGridShape MakeRandomShape(FRandomStream& Stream, int32 MaxCells);
+
+	// Create an empty storage in the transient package.
+	UFaerieItemStorage* MakeStorage();
+
+	// Get the value of an item's test token, or INDEX_NONE if it has none.
+	int32 GetItemValue(const UFaerieItem* Item);
+
+	/**
+	 * Collects the results of a benchmark suite, and writes them to a CSV file, so they can be tracked between builds.
+	 * Files are written to Saved/Automation/FaerieBenchmarks/<Suite>.csv, or the directory passed with
+	 * -FaerieBenchmarkDir=, and are overwritten by each run.
+	 */
+	class FBenchmarkReport
+	{
+	public:
+		explicit FBenchmarkReport(const FString& Suite);
+
+		// Time Func, which performs Operations operations on a container holding Entries entries, and record the result.
+		template <typename TFunc>
+		void Measure(const TCHAR* Name, const int32 Entries, const int32 Operations, TFunc&& Func)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Func();
+			Add(Name, Entries, Operations, FPlatformTime::Seconds() - Start);
+		}
+
+		void Add(const TCHAR* Name, int32 Entries, int32 Operations, double Seconds);
+
+		// Write every result recorded so far. Returns the path written, or an empty string if the file could not be saved.
+		FString WriteCsv() const;
+
+	private:
+		struct FResult
+		{
+			FString Name;
+			int32 Entries;
+			int32 Operations;
+			double Seconds;
+		};
+
+		FString Suite;
+		TArray<FResult> Results;
+	};
+}
@@ -0,0 +1,131 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "BinarySearchOptimizedArray.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Faerie::Tests
+{
+	struct FTestElement
+	{
+		int32 Key;
+		int32 Value;
+	};
+
+	struct FTestArray : TBinarySearchOptimizedArray<FTestArray, FTestElement>
+	{
+		TArray<FTestElement> Elements;
+
+		TArray<FTestElement>& GetArray() { return Elements; }
+
+		TArray<int32> GetKeys() const
+		{
+			TArray<int32> Keys;
+			for (const FTestElement& Element : Elements)
+			{
+				Keys.Add(Element.Key);
+			}
+			return Keys;
+		}
+	};
+}
+
+BEGIN_DEFINE_SPEC(FBinarySearchOptimizedArraySpec, "Faerie.Utils.BinarySearchOptimizedArray",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	Faerie::Tests::FTestArray Array;
+
+END_DEFINE_SPEC(FBinarySearchOptimizedArraySpec)
+
+void FBinarySearchOptimizedArraySpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Array.Elements.Reset();
+	});
+
+	Describe("Insert", [this]()
+	{
+		It("should keep keys sorted when inserted out of order", [this]()
+		{
+			for (const int32 Key : {5, 1, 9, 3, 7, 0})
+			{
+				Array.Insert({Key, Key * 10});
+			}
+			TestTrue(TEXT("Sorted"), Array.IsSorted());
+			TestTrue(TEXT("Keys"), Array.GetKeys() == TArray<int32>({0, 1, 3, 5, 7, 9}));
+		});
+
+		It("should overwrite the value of an existing key", [this]()
+		{
+			Array.Insert({1, 10});
+			Array.Insert({2, 20});
+			Array.Insert({3, 30});
+
+			// The last key is the case that upper bound places past the end of the array.
+			Array.Insert({3, 31});
+			Array.Insert({1, 11});
+
+			TestEqual(TEXT("Num"), Array.Elements.Num(), 3);
+			TestEqual(TEXT("First value"), Array[1], 11);
+			TestEqual(TEXT("Last value"), Array[3], 31);
+		});
+	});
+
+	Describe("Find", [this]()
+	{
+		It("should find present keys, and not missing ones", [this]()
+		{
+			for (int32 i = 0; i < 100; i += 2)
+			{
+				Array.Insert({i, i});
+			}
+			for (int32 i = 0; i < 100; ++i)
+			{
+				if (i % 2 == 0)
+				{
+					const int32* Value = Array.Find(i);
+					if (!TestNotNull(TEXT("Even key"), Value)) return;
+					TestEqual(TEXT("Value"), *Value, i);
+				}
+				else
+				{
+					TestNull(TEXT("Odd key"), Array.Find(i));
+				}
+			}
+		});
+	});
+
+	Describe("Remove", [this]()
+	{
+		It("should remove a single key", [this]()
+		{
+			for (int32 i = 0; i < 5; ++i)
+			{
+				Array.Insert({i, i});
+			}
+			TestTrue(TEXT("Removed"), Array.Remove(2));
+			TestFalse(TEXT("Removed again"), Array.Remove(2));
+			TestTrue(TEXT("Keys"), Array.GetKeys() == TArray<int32>({0, 1, 3, 4}));
+		});
+
+		It("should remove sorted keys in one pass", [this]()
+		{
+			for (int32 i = 0; i < 10; ++i)
+			{
+				Array.Insert({i, i});
+			}
+
+			int32 Visited = 0;
+			const int32 Removed = Array.RemoveSorted(TArray<int32>({0, 3, 4, 9, 12}),
+				[&Visited](const Faerie::Tests::FTestElement&) { ++Visited; });
+
+			TestEqual(TEXT("Removed"), Removed, 4);
+			TestEqual(TEXT("Visited"), Visited, 4);
+			TestTrue(TEXT("Keys"), Array.GetKeys() == TArray<int32>({1, 2, 5, 6, 7, 8}));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,250 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieItem.h"
+#include "Algo/IsSorted.h"
+#include "FaerieItemStorage.h"
+#include "FaerieTestUtils.h"
+#include "ItemContainerEvent.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FFaerieItemStorageSpec, "Faerie.Inventory.ItemStorage",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TStrongObjectPtr<UFaerieItemStorage> Storage;
+	TStrongObjectPtr<UFaerieItemStorage> OtherStorage;
+
+	// Add a single new entry, and return its key.
+	FEntryKey AddNew(UFaerieItem* Item, const int32 Copies = 1)
+	{
+		const FLoggedInventoryEvent Event = Storage->AddItemStackWithLog({Item, Copies}, EFaerieStorageAddStackBehavior::AddToAnyStack);
+		return Event.Event.EntryTouched;
+	}
+
+END_DEFINE_SPEC(FFaerieItemStorageSpec)
+
+void FFaerieItemStorageSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Storage.Reset(Faerie::Tests::MakeStorage());
+		OtherStorage.Reset(Faerie::Tests::MakeStorage());
+	});
+
+	AfterEach([this]()
+	{
+		Storage.Reset();
+		OtherStorage.Reset();
+	});
+
+	Describe("AddItemStack", [this]()
+	{
+		It("should create an entry for each distinct item", [this]()
+		{
+			for (int32 i = 0; i < 5; ++i)
+			{
+				TestTrue(TEXT("Added"), Storage->AddItemStack({Faerie::Tests::MakeItem(i), 1}, EFaerieStorageAddStackBehavior::AddToAnyStack));
+			}
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 5);
+		});
+
+		It("should stack identical immutable items into one entry", [this]()
+		{
+			const FEntryKey Key = AddNew(Faerie::Tests::MakeItem(7), 2);
+			Storage->AddItemStack({Faerie::Tests::MakeItem(7), 3}, EFaerieStorageAddStackBehavior::AddToAnyStack);
+
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 1);
+			TestEqual(TEXT("Copies"), Storage->GetStack(Key), 5);
+		});
+
+		It("should never stack mutable items", [this]()
+		{
+			AddNew(Faerie::Tests::MakeItem(7, true));
+			AddNew(Faerie::Tests::MakeItem(7, true));
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 2);
+		});
+
+		It("should keep keys in ascending order", [this]()
+		{
+			TArray<FEntryKey> Keys;
+			for (int32 i = 0; i < 10; ++i)
+			{
+				Keys.Add(AddNew(Faerie::Tests::MakeItem(i)));
+			}
+
+			TArray<FEntryKey> StoredKeys;
+			Storage->GetAllKeys(StoredKeys);
+			TestTrue(TEXT("Keys"), StoredKeys == Keys);
+			TestTrue(TEXT("Sorted"), Algo::IsSorted(StoredKeys));
+		});
+	});
+
+	Describe("AddBatch", [this]()
+	{
+		It("should add every stack", [this]()
+		{
+			TArray<FFaerieItemStack> Stacks;
+			for (int32 i = 0; i < 8; ++i)
+			{
+				Stacks.Add({Faerie::Tests::MakeItem(i), 1});
+			}
+			TestTrue(TEXT("Added"), Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::AddToAnyStack));
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 8);
+		});
+	});
+
+	Describe("RemoveEntry", [this]()
+	{
+		It("should remove part of an entry", [this]()
+		{
+			const FEntryKey Key = AddNew(Faerie::Tests::MakeItem(1), 5);
+			TestTrue(TEXT("Removed"), Storage->RemoveEntry(Key, Faerie::Inventory::Tags::RemovalDeletion, 2));
+			TestEqual(TEXT("Copies"), Storage->GetStack(Key), 3);
+		});
+
+		It("should remove the whole entry", [this]()
+		{
+			const FEntryKey Key = AddNew(Faerie::Tests::MakeItem(1), 5);
+			AddNew(Faerie::Tests::MakeItem(2));
+			TestTrue(TEXT("Removed"), Storage->RemoveEntry(Key, Faerie::Inventory::Tags::RemovalDeletion));
+			TestFalse(TEXT("Contains key"), Storage->ContainsKey(Key));
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 1);
+		});
+
+		It("should reject invalid keys", [this]()
+		{
+			TestFalse(TEXT("Removed"), Storage->RemoveEntry(FEntryKey(), Faerie::Inventory::Tags::RemovalDeletion));
+		});
+	});
+
+	Describe("RemoveBatch and Clear", [this]()
+	{
+		It("should remove only the given keys", [this]()
+		{
+			TArray<FEntryKey> Keys;
+			for (int32 i = 0; i < 6; ++i)
+			{
+				Keys.Add(AddNew(Faerie::Tests::MakeItem(i)));
+			}
+
+			TestTrue(TEXT("Removed"), Storage->RemoveBatch({Keys[4], Keys[1]}, Faerie::Inventory::Tags::RemovalDeletion));
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 4);
+			TestFalse(TEXT("Contains removed key"), Storage->ContainsKey(Keys[1]));
+			TestTrue(TEXT("Contains kept key"), Storage->ContainsKey(Keys[2]));
+		});
+
+		It("should empty the storage", [this]()
+		{
+			for (int32 i = 0; i < 6; ++i)
+			{
+				AddNew(Faerie::Tests::MakeItem(i));
+			}
+			Storage->Clear(Faerie::Inventory::Tags::RemovalDeletion);
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 0);
+		});
+	});
+
+	Describe("SplitStack and MergeStacks", [this]()
+	{
+		It("should split a stack in two, and merge it back", [this]()
+		{
+			const FEntryKey Key = AddNew(Faerie::Tests::MakeItem(1), 10);
+			const TArray<FInventoryKey> Before = Storage->GetInvKeysForEntry(Key);
+			if (!TestEqual(TEXT("Stacks before split"), Before.Num(), 1)) return;
+
+			TestTrue(TEXT("Split"), Storage->SplitStack(Key, Before[0].StackKey, 4));
+
+			const TArray<FInventoryKey> Split = Storage->GetInvKeysForEntry(Key);
+			if (!TestEqual(TEXT("Stacks after split"), Split.Num(), 2)) return;
+			TestEqual(TEXT("Split stack"), Storage->GetStackView(Split[1]).Copies, 4);
+			TestEqual(TEXT("Entry copies"), Storage->GetStack(Key), 10);
+
+			TestTrue(TEXT("Merged"), Storage->MergeStacks(Key, Split[1].StackKey, Split[0].StackKey));
+
+			const TArray<FInventoryKey> Merged = Storage->GetInvKeysForEntry(Key);
+			if (!TestEqual(TEXT("Stacks after merge"), Merged.Num(), 1)) return;
+			TestEqual(TEXT("Merged stack"), Storage->GetStackView(Merged[0]).Copies, 10);
+		});
+
+		It("should not split more than the stack holds", [this]()
+		{
+			const FEntryKey Key = AddNew(Faerie::Tests::MakeItem(1), 3);
+			TestFalse(TEXT("Split"), Storage->SplitStack(Key, Storage->GetInvKeysForEntry(Key)[0].StackKey, 3));
+		});
+
+		It("should not merge a stack into itself", [this]()
+		{
+			const FEntryKey Key = AddNew(Faerie::Tests::MakeItem(1), 3);
+			const FStackKey Stack = Storage->GetInvKeysForEntry(Key)[0].StackKey;
+			TestFalse(TEXT("Merged"), Storage->MergeStacks(Key, Stack, Stack));
+		});
+	});
+
+	Describe("MoveEntry and Dump", [this]()
+	{
+		It("should move an entry to another storage", [this]()
+		{
+			UFaerieItem* Item = Faerie::Tests::MakeItem(3);
+			const FEntryKey Key = AddNew(Item, 2);
+
+			const FEntryKey NewKey = Storage->MoveEntry(OtherStorage.Get(), Key, EFaerieStorageAddStackBehavior::AddToAnyStack);
+			TestTrue(TEXT("Moved"), NewKey.IsValid());
+			TestFalse(TEXT("Source contains key"), Storage->ContainsKey(Key));
+			TestEqual(TEXT("Target copies"), OtherStorage->GetStack(NewKey), 2);
+			TestTrue(TEXT("Target item"), OtherStorage->FindItem(Item, EFaerieItemEqualsCheck::ComparePointers) == NewKey);
+		});
+
+		It("should move every entry to another storage", [this]()
+		{
+			for (int32 i = 0; i < 6; ++i)
+			{
+				AddNew(Faerie::Tests::MakeItem(i));
+			}
+			Storage->Dump(OtherStorage.Get());
+			TestEqual(TEXT("Source entry count"), Storage->GetStackCount(), 0);
+			TestEqual(TEXT("Target entry count"), OtherStorage->GetStackCount(), 6);
+		});
+	});
+
+	Describe("Queries", [this]()
+	{
+		It("should find items by pointer and by data", [this]()
+		{
+			UFaerieItem* Item = Faerie::Tests::MakeItem(5);
+			AddNew(Faerie::Tests::MakeItem(4));
+			const FEntryKey Key = AddNew(Item);
+
+			TestTrue(TEXT("By pointer"), Storage->FindItem(Item, EFaerieItemEqualsCheck::ComparePointers) == Key);
+			TestTrue(TEXT("By data"), Storage->FindItem(Faerie::Tests::MakeItem(5), EFaerieItemEqualsCheck::UseCompareWith) == Key);
+			TestFalse(TEXT("Missing"), Storage->FindItem(Faerie::Tests::MakeItem(6), EFaerieItemEqualsCheck::UseCompareWith).IsValid());
+		});
+
+		It("should filter and sort entries without proxies", [this]()
+		{
+			for (int32 i = 0; i < 10; ++i)
+			{
+				AddNew(Faerie::Tests::MakeItem(i));
+			}
+
+			Faerie::FStorageViewQuery Query;
+			Query.Filter.BindLambda([](const FFaerieItemStackView View)
+			{
+				return Faerie::Tests::GetItemValue(View.Item.Get()) % 2 == 0;
+			});
+			Query.Sort.BindLambda([](const FFaerieItemStackView A, const FFaerieItemStackView B)
+			{
+				return Faerie::Tests::GetItemValue(A.Item.Get()) > Faerie::Tests::GetItemValue(B.Item.Get());
+			});
+
+			TArray<FKeyedInventoryEntry> Results;
+			Storage->QueryAllView(Query, Results);
+			if (!TestEqual(TEXT("Result count"), Results.Num(), 5)) return;
+			TestEqual(TEXT("First result"), Faerie::Tests::GetItemValue(Results[0].Value.ItemObject), 8);
+			TestEqual(TEXT("Last result"), Faerie::Tests::GetItemValue(Results[4].Value.ItemObject), 0);
+		});
+	});
+}
+
+#endif
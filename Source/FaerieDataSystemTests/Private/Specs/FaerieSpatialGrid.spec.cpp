@@ -0,0 +1,230 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieItemStorage.h"
+#include "FaerieTestUtils.h"
+#include "GridBitboard.h"
+#include "ItemContainerEvent.h"
+#include "Extensions/InventorySimpleGridExtension.h"
+#include "Extensions/InventorySpatialGridExtension.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FFaerieSpatialGridSpec, "Faerie.Inventory.SpatialGrid",
+	EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TStrongObjectPtr<UFaerieItemStorage> Storage;
+	UInventorySpatialGridExtension* Grid = nullptr;
+
+	void Setup(const FIntPoint GridSize)
+	{
+		Storage.Reset(Faerie::Tests::MakeStorage());
+		Grid = CastChecked<UInventorySpatialGridExtension>(Storage->AddExtensionByClass(UInventorySpatialGridExtension::StaticClass()));
+		Grid->SetGridSize(GridSize);
+	}
+
+	bool AddShape(const int32 Value, const FFaerieGridShape& Shape)
+	{
+		return Storage->AddItemStack({Faerie::Tests::MakeShapedItem(Value, Shape), 1}, EFaerieStorageAddStackBehavior::OnlyNewStacks);
+	}
+
+	// Get the shape of every stack as placed on the grid.
+	TArray<FFaerieGridShape> GetPlacedShapes() const
+	{
+		TArray<FFaerieGridShape> Shapes;
+		TArray<FEntryKey> Keys;
+		Storage->GetAllKeys(Keys);
+		for (const FEntryKey Key : Keys)
+		{
+			for (const FInventoryKey& InvKey : Storage->GetInvKeysForEntry(Key))
+			{
+				Shapes.Add(Grid->GetItemShapeOnGrid(InvKey));
+			}
+		}
+		return Shapes;
+	}
+
+END_DEFINE_SPEC(FFaerieSpatialGridSpec)
+
+void FFaerieSpatialGridSpec::Define()
+{
+	AfterEach([this]()
+	{
+		Grid = nullptr;
+		Storage.Reset();
+	});
+
+	Describe("Placement", [this]()
+	{
+		It("should place shapes without overlapping", [this]()
+		{
+			Setup(FIntPoint(8, 8));
+
+			FFaerieGridShape Corner;
+			Corner.Points = {{0, 0}, {1, 0}, {1, 1}};
+
+			const TArray<FFaerieGridShape> Shapes =
+			{
+				FFaerieGridShape::MakeSquare(2),
+				FFaerieGridShape::MakeRect(3, 1),
+				FFaerieGridShape::MakeRect(1, 4),
+				Corner,
+				FFaerieGridShape::MakeSquare(3),
+				FFaerieGridShape::MakeSquare(1),
+			};
+
+			int32 NumPoints = 0;
+			for (int32 i = 0; i < Shapes.Num(); ++i)
+			{
+				TestTrue(TEXT("Added"), AddShape(i, Shapes[i]));
+				NumPoints += Shapes[i].Points.Num();
+			}
+
+			const TArray<FFaerieGridShape> Placed = GetPlacedShapes();
+			if (!TestEqual(TEXT("Placed count"), Placed.Num(), Shapes.Num())) return;
+
+			for (int32 A = 0; A < Placed.Num(); ++A)
+			{
+				for (int32 B = A + 1; B < Placed.Num(); ++B)
+				{
+					TestFalse(FString::Printf(TEXT("Shape %i overlaps shape %i"), A, B), Placed[A].Overlaps(Placed[B]));
+				}
+			}
+
+			int32 NumOccupied = 0;
+			for (int32 Y = 0; Y < 8; ++Y)
+			{
+				for (int32 X = 0; X < 8; ++X)
+				{
+					NumOccupied += Grid->IsCellOccupied(FIntPoint(X, Y)) ? 1 : 0;
+				}
+			}
+			TestEqual(TEXT("Occupied cells"), NumOccupied, NumPoints);
+		});
+
+		It("should reject stacks once the grid is full", [this]()
+		{
+			Setup(FIntPoint(4, 4));
+			for (int32 i = 0; i < 16; ++i)
+			{
+				TestTrue(TEXT("Added"), AddShape(i, FFaerieGridShape::MakeSquare(1)));
+			}
+			TestFalse(TEXT("Added to full grid"), AddShape(16, FFaerieGridShape::MakeSquare(1)));
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 16);
+		});
+
+		It("should rotate shapes that only fit rotated", [this]()
+		{
+			Setup(FIntPoint(1, 3));
+			if (!TestTrue(TEXT("Added"), AddShape(0, FFaerieGridShape::MakeRect(3, 1)))) return;
+
+			const TArray<FFaerieGridShape> Placed = GetPlacedShapes();
+			if (!TestEqual(TEXT("Placed count"), Placed.Num(), 1)) return;
+			for (const FIntPoint& Point : Placed[0].Points)
+			{
+				TestTrue(TEXT("Point in bounds"), Point.X == 0 && Point.Y >= 0 && Point.Y < 3);
+			}
+		});
+
+		It("should free cells when a stack is removed", [this]()
+		{
+			Setup(FIntPoint(2, 2));
+			TestTrue(TEXT("Added"), AddShape(0, FFaerieGridShape::MakeSquare(2)));
+			TestFalse(TEXT("Added to full grid"), AddShape(1, FFaerieGridShape::MakeSquare(1)));
+
+			Storage->Clear(Faerie::Inventory::Tags::RemovalDeletion);
+			TestTrue(TEXT("Added after clear"), AddShape(1, FFaerieGridShape::MakeSquare(2)));
+		});
+	});
+
+	Describe("CompiledGridShape", [this]()
+	{
+		It("should find the first point of each rotation", [this]()
+		{
+			FRandomStream Stream(7);
+			for (int32 i = 0; i < 50; ++i)
+			{
+				const FFaerieGridShape Shape = Faerie::Tests::MakeRandomShape(Stream, 6);
+				const Faerie::FCompiledGridShape Compiled(Shape);
+
+				for (const ESpatialItemRotation Rotation : TEnumRange<ESpatialItemRotation>())
+				{
+					FIntPoint Expected(TNumericLimits<int32>::Max());
+					for (const FIntPoint& Point : Shape.Rotate(Rotation).Points)
+					{
+						if (Point.Y < Expected.Y || (Point.Y == Expected.Y && Point.X < Expected.X))
+						{
+							Expected = Point;
+						}
+					}
+					TestTrue(TEXT("First point"), Compiled.GetMask(Rotation).FirstPoint == Expected);
+				}
+			}
+		});
+
+		It("should place rotated shapes whose first point moves", [this]()
+		{
+			// An L whose top-left cell is at X 1 once rotated. On a 2x2 grid with the top-left cell taken, only a
+			// rotation aligned by its own first point fits.
+			Setup(FIntPoint(2, 2));
+			TestTrue(TEXT("Added blocker"), AddShape(0, FFaerieGridShape::MakeSquare(1)));
+
+			FFaerieGridShape Corner;
+			Corner.Points = {{0, 0}, {0, 1}, {1, 1}};
+			TestTrue(TEXT("Added corner"), AddShape(1, Corner));
+
+			const TArray<FFaerieGridShape> Placed = GetPlacedShapes();
+			if (!TestEqual(TEXT("Placed count"), Placed.Num(), 2)) return;
+			TestFalse(TEXT("Overlaps"), Placed[0].Overlaps(Placed[1]));
+		});
+	});
+
+	Describe("AddBatch", [this]()
+	{
+		It("should accept a batch whose shapes fit together", [this]()
+		{
+			Setup(FIntPoint(2, 2));
+			const TArray<FFaerieItemStack> Stacks =
+			{
+				{Faerie::Tests::MakeShapedItem(0, FFaerieGridShape::MakeRect(2, 1)), 1},
+				{Faerie::Tests::MakeShapedItem(1, FFaerieGridShape::MakeRect(2, 1)), 1},
+			};
+			TestTrue(TEXT("Added"), Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::OnlyNewStacks));
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 2);
+		});
+
+		It("should reject a batch whose shapes only fit alone", [this]()
+		{
+			Setup(FIntPoint(2, 2));
+			const TArray<FFaerieItemStack> Stacks =
+			{
+				{Faerie::Tests::MakeShapedItem(0, FFaerieGridShape::MakeRect(2, 1)), 1},
+				{Faerie::Tests::MakeShapedItem(1, FFaerieGridShape::MakeSquare(2)), 1},
+			};
+			TestFalse(TEXT("Added"), Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::OnlyNewStacks));
+			TestEqual(TEXT("Entry count"), Storage->GetStackCount(), 0);
+		});
+
+		It("should reject a batch with more stacks than a simple grid has cells", [this]()
+		{
+			Storage.Reset(Faerie::Tests::MakeStorage());
+			UInventorySimpleGridExtension* SimpleGrid = CastChecked<UInventorySimpleGridExtension>(
+				Storage->AddExtensionByClass(UInventorySimpleGridExtension::StaticClass()));
+			SimpleGrid->SetGridSize(FIntPoint(2, 2));
+
+			TArray<FFaerieItemStack> Stacks;
+			for (int32 i = 0; i < 5; ++i)
+			{
+				Stacks.Add({Faerie::Tests::MakeItem(i), 1});
+			}
+			TestFalse(TEXT("Added five"), Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::OnlyNewStacks));
+
+			Stacks.Pop();
+			TestTrue(TEXT("Added four"), Storage->AddBatch(Stacks, EFaerieStorageAddStackBehavior::OnlyNewStacks));
+		});
+	});
+}
+
+#endif
@@ -96,7 +96,7 @@ public:
 		// Find the index of either ahead of where Key currently is, or where it should be inserted if it isn't present.
 		const int32 NextIndex = Algo::UpperBoundBy(GetArray_Internal(), Element.Key, &TElementType::Key);
 
-		if (NextIndex < GetArray_Internal().Num())
+		if (NextIndex > 0)
 		{
 			// Check if the index-1 is our key, and overwrite the data there if so.
 			if (TElementType& CurrentEntry = GetArray_Internal()[NextIndex-1];
@@ -138,6 +138,66 @@ public:
 		return false;
 	}
 
+	/**
+	 * Removes every element whose key is in SortedKeys in a single pass, keeping the remaining elements in order.
+	 * SortedKeys must be sorted, and keys not in the array are ignored. Pred is called on each element to be removed
+	 * before any are removed, so the array is still intact while it runs.
+	 * Returns the number of elements removed.
+	 */
+	template <typename Predicate>
+	int32 RemoveSorted(const TConstArrayView<KeyType> SortedKeys, Predicate Pred)
+	{
+		TArray<TElementType>& Array = GetArray_Internal();
+
+		// Both arrays are sorted, so matching elements can be found by walking them together.
+		auto ForEachMatch = [&Array, SortedKeys](auto&& Func)
+		{
+			int32 KeyIndex = 0;
+			for (int32 Index = 0; Index < Array.Num() && KeyIndex < SortedKeys.Num(); ++Index)
+			{
+				while (KeyIndex < SortedKeys.Num() && SortedKeys[KeyIndex] < Array[Index].Key)
+				{
+					++KeyIndex;
+				}
+
+				if (KeyIndex < SortedKeys.Num() && SortedKeys[KeyIndex] == Array[Index].Key)
+				{
+					Func(Index);
+					++KeyIndex;
+				}
+			}
+		};
+
+		ForEachMatch([&Array, &Pred](const int32 Index) { Pred(Array[Index]); });
+
+		// Compact the array once, instead of shifting it for each removal.
+		int32 WriteIndex = 0;
+		int32 ReadIndex = 0;
+		ForEachMatch(
+			[&Array, &WriteIndex, &ReadIndex](const int32 Index)
+			{
+				for (; ReadIndex < Index; ++ReadIndex, ++WriteIndex)
+				{
+					if (WriteIndex != ReadIndex)
+					{
+						Array[WriteIndex] = MoveTemp(Array[ReadIndex]);
+					}
+				}
+				++ReadIndex;
+			});
+
+		const int32 Removed = ReadIndex - WriteIndex;
+		if (Removed > 0)
+		{
+			for (; ReadIndex < Array.Num(); ++ReadIndex, ++WriteIndex)
+			{
+				Array[WriteIndex] = MoveTemp(Array[ReadIndex]);
+			}
+			Array.SetNum(WriteIndex, EAllowShrinking::No);
+		}
+		return Removed;
+	}
+
 	// Debug function for checking if we are out of order
 	bool IsSorted() const
 	{
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Algo/IsSorted.h"
+#include "Algo/Unique.h"
 #include "Net/Serialization/FastArraySerializer.h"
 
 namespace Faerie::Hacks
@@ -138,16 +140,18 @@ namespace Faerie::Hacks
 			TArray<int32, TInlineAllocator<8>>& AddedIndices,
 			GuidMapType& GuidMap)
 		{
-			if (Items.Num() > 0)
+			// Changes and removals cannot break the order of Items, only additions can, since they are appended to the end.
+			// Those are usually in order anyway, as keys are given out sequentially, so only pay for the remap when needed.
+			if (AddedIndices.Num() > 0 && !Algo::IsSortedBy(Items, &Type::Key))
 			{
 				// Cache Old Position Data
-				TMap<int32, int32> OldIndexToReplicationIDMap;
-				OldIndexToReplicationIDMap.Reserve(Items.Num());
+				TArray<int32> OldIndexToReplicationID;
+				OldIndexToReplicationID.Reserve(Items.Num());
 				for (int32 i = 0; i < Items.Num(); ++i)
 				{
-					OldIndexToReplicationIDMap.Add(i, Items[i].ReplicationID);
+					OldIndexToReplicationID.Add(Items[i].ReplicationID);
 				}
-				
+
 				Algo::SortBy(Items, &Type::Key);
 
 				// Build a Map For Replication id to new index
@@ -165,12 +169,11 @@ namespace Faerie::Hacks
 				{
 					for (int32& Idx : Indices)
 					{
-						if (OldIndexToReplicationIDMap.Contains(Idx)) // Ensure the old index is valid
+						if (OldIndexToReplicationID.IsValidIndex(Idx)) // Ensure the old index is valid
 						{
-							const int32 ReplicationID = OldIndexToReplicationIDMap[Idx];
-							if (NewIndexMap.Contains(ReplicationID))
+							if (const int32* NewIndex = NewIndexMap.Find(OldIndexToReplicationID[Idx]))
 							{
-								Idx = NewIndexMap[ReplicationID];
+								Idx = *NewIndex;
 							}
 						}
 					}
@@ -267,20 +270,55 @@ namespace Faerie::Hacks
 			if (Header.DeletedIndices.Num() > 0)
 			{
 				Header.DeletedIndices.Sort();
-				for (int32 i = Header.DeletedIndices.Num() - 1; i >= 0; --i)
+				Header.DeletedIndices.SetNum(Algo::Unique(Header.DeletedIndices));
+				RemoveSortedIndices(Header.DeletedIndices);
+			}
+		}
+
+		/**
+		 * Removes the elements at these indices in one pass, keeping the rest in order. Rather than emptying the ItemMap,
+		 * which would force it to be rebuilt for the entire array, only the elements that moved are re-indexed.
+		 */
+		void RemoveSortedIndices(const TConstArrayView<int32> SortedIndices)
+		{
+			TMap<int32, int32>& ItemMap = ArraySerializer.ItemMap;
+			const bool ItemMapWasValid = ItemMap.Num() == Items.Num();
+
+			int32 DeleteCursor = 0;
+			while (DeleteCursor < SortedIndices.Num() && SortedIndices[DeleteCursor] < 0)
+			{
+				++DeleteCursor;
+			}
+			if (DeleteCursor == SortedIndices.Num() || SortedIndices[DeleteCursor] >= Items.Num())
+			{
+				return;
+			}
+
+			// Everything before the first deleted element stays where it is.
+			int32 WriteIndex = SortedIndices[DeleteCursor];
+			for (int32 ReadIndex = WriteIndex; ReadIndex < Items.Num(); ++ReadIndex)
+			{
+				if (DeleteCursor < SortedIndices.Num() && SortedIndices[DeleteCursor] == ReadIndex)
 				{
-					int32 DeleteIndex = Header.DeletedIndices[i];
-					if (Items.IsValidIndex(DeleteIndex))
-					{
-						Items.RemoveAt(DeleteIndex, 1, EAllowShrinking::No);
+					//UE_LOG(LogNetFastTArray, Log, TEXT("   Deleting: %d"), ReadIndex);
+					ItemMap.Remove(Items[ReadIndex].ReplicationID);
+					++DeleteCursor;
+					continue;
+				}
 
-						//UE_LOG(LogNetFastTArray, Log, TEXT("   Deleting: %d"), DeleteIndex);
-					}
+				Items[WriteIndex] = MoveTemp(Items[ReadIndex]);
+				if (Items[WriteIndex].ReplicationID != INDEX_NONE)
+				{
+					ItemMap.Add(Items[WriteIndex].ReplicationID, WriteIndex);
 				}
+				++WriteIndex;
+			}
+			Items.SetNum(WriteIndex, EAllowShrinking::No);
 
-				// Clear the map now that the indices are all shifted around. This kind of sucks, we could use slightly better data structures here I think.
-				// This will force the ItemMap to be rebuilt for the current Items array
-				ArraySerializer.ItemMap.Empty();
+			if (!ItemMapWasValid)
+			{
+				// The map was already out of date, so leave it to be rebuilt when next needed.
+				ItemMap.Empty();
 			}
 		}
 
@@ -392,6 +430,49 @@ namespace Faerie::Hacks
 		return false;
 	}
 
+	/**
+	 * Call after removing elements from Items, instead of MarkArrayDirty. The delta serializer already sends removals
+	 * as the ReplicationIDs missing since the last acked state, so a new ArrayReplicationKey is all that is needed for
+	 * clients to receive them. MarkArrayDirty also empties the ItemMap, forcing it to be rebuilt for the whole array,
+	 * so instead the removed IDs are dropped from the map, and only the elements that shifted down are re-indexed.
+	 * The remaining elements must have kept their order.
+	 */
+	template <typename Type>
+	void MarkItemsRemoved(FFastArraySerializer& ArraySerializer, const TArray<Type>& Items, const TConstArrayView<int32> RemovedIDs)
+	{
+		TMap<int32, int32>& ItemMap = ArraySerializer.ItemMap;
+
+		if (ItemMap.Num() == Items.Num() + RemovedIDs.Num())
+		{
+			int32 FirstShiftedIndex = Items.Num();
+			for (const int32 RemovedID : RemovedIDs)
+			{
+				int32 OldIndex;
+				if (!ItemMap.RemoveAndCopyValue(RemovedID, OldIndex))
+				{
+					ItemMap.Empty();
+					break;
+				}
+				FirstShiftedIndex = FMath::Min(FirstShiftedIndex, OldIndex);
+			}
+
+			if (!ItemMap.IsEmpty())
+			{
+				for (int32 i = FirstShiftedIndex; i < Items.Num(); ++i)
+				{
+					ItemMap.Add(Items[i].ReplicationID, i);
+				}
+			}
+		}
+		else
+		{
+			// The map was already out of date, so leave it to be rebuilt when next needed.
+			ItemMap.Empty();
+		}
+
+		ArraySerializer.IncrementArrayReplicationKey();
+	}
+
 	// We are overriding this to redirect the PostReceiveCleanup call to one that doesn't use RemoveAtSwap
 	template <typename Type, typename SerializerType>
 	bool FastArrayDeltaSerialize(TArray<Type>& Items, FNetDeltaSerializeInfo& Parms, SerializerType& ArraySerializer)
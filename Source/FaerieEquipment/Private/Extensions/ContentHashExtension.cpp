@@ -1,12 +1,32 @@
 ﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "Extensions/ContentHashExtension.h"
-#include "FaerieInventoryHashStatics.h"
+#include "FaerieHashStatics.h"
 #include "FaerieItemContainerBase.h"
+#include "ItemContainerEvent.h"
 #include "Net/UnrealNetwork.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ContentHashExtension)
 
+DECLARE_STATS_GROUP(TEXT("ContentHashExtension"), STATGROUP_FaerieContentHash, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Hash container"), STAT_ContentHash_Container, STATGROUP_FaerieContentHash);
+DECLARE_CYCLE_STAT(TEXT("Hash entry"), STAT_ContentHash_Entry, STATGROUP_FaerieContentHash);
+
+CSV_DEFINE_CATEGORY(FaerieContentHash, true);
+
+// WARNING: Changing this will desync checksums between clients and servers running different builds.
+#define ENTRY_HASHING_SEED 2166136261u
+
+namespace Faerie::Hash
+{
+	// Mix an item hash before summing, so that items with similar hashes don't cancel each other out.
+	static uint32 HashEntry(const UFaerieItem* Item)
+	{
+		return Combine(HashItemByName(Item), ENTRY_HASHING_SEED);
+	}
+}
+
 void UContentHashExtension::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -25,7 +45,11 @@ void UContentHashExtension::InitializeExtension(const UFaerieItemContainerBase*
 void UContentHashExtension::DeinitializeExtension(const UFaerieItemContainerBase* Container)
 {
 	Super::DeinitializeExtension(Container);
-	PerContainerHash.Remove(Container);
+	if (FContainerHashState State;
+		PerContainerHash.RemoveAndCopyValue(Container, State))
+	{
+		ChecksumSum -= State.Sum;
+	}
 	RecalcLocalChecksum();
 }
 
@@ -34,35 +58,83 @@ void UContentHashExtension::LoadSaveData(const UFaerieItemContainerBase* Contain
 	RecalcContainerHash(Container);
 }
 
-void UContentHashExtension::PostRemoval(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog&)
+void UContentHashExtension::PostRemoval(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event)
 {
-	RecalcContainerHash(Container);
+	UpdateEntryHash(Container, Event.EntryTouched);
 }
 
-void UContentHashExtension::PostEntryChanged(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog&)
+void UContentHashExtension::PostEntryChanged(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event)
 {
-	RecalcContainerHash(Container);
+	UpdateEntryHash(Container, Event.EntryTouched);
 }
 
-void UContentHashExtension::PostAddition(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog&)
+void UContentHashExtension::PostAddition(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event)
 {
-	RecalcContainerHash(Container);
+	UpdateEntryHash(Container, Event.EntryTouched);
 }
 
 void UContentHashExtension::RecalcContainerHash(const UFaerieItemContainerBase* Container)
 {
-	FFaerieHash& Hash = PerContainerHash.FindOrAdd(Container);
-	const FFaerieHash NewHash = Faerie::Hash::HashContainer(Container, &Faerie::Hash::HashItemByName);
-	Hash = NewHash;
+	SCOPE_CYCLE_COUNTER(STAT_ContentHash_Container);
+	CSV_SCOPED_TIMING_STAT(FaerieContentHash, HashContainer);
+
+	FContainerHashState& State = PerContainerHash.FindOrAdd(Container);
+	ChecksumSum -= State.Sum;
+
+	State.EntryHashes.Reset();
+	State.Sum = 0;
+
+	if (IsValid(Container))
+	{
+		Container->ForEachKey(
+			[Container, &State](const FEntryKey Key)
+			{
+				const uint32 EntryHash = Faerie::Hash::HashEntry(Container->View(Key).Item.Get());
+				State.EntryHashes.Add(Key, EntryHash);
+				State.Sum += EntryHash;
+			});
+	}
+
+	ChecksumSum += State.Sum;
+	RecalcLocalChecksum();
+}
+
+void UContentHashExtension::UpdateEntryHash(const UFaerieItemContainerBase* Container, const FEntryKey Key)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ContentHash_Entry);
+	CSV_SCOPED_TIMING_STAT(FaerieContentHash, HashEntry);
+
+	FContainerHashState* State = PerContainerHash.Find(Container);
+	if (!State)
+	{
+		// First event from a container we haven't hashed yet.
+		RecalcContainerHash(Container);
+		return;
+	}
+
+	// Remove the entry's old contribution
+	if (uint32 OldHash;
+		State->EntryHashes.RemoveAndCopyValue(Key, OldHash))
+	{
+		State->Sum -= OldHash;
+		ChecksumSum -= OldHash;
+	}
+
+	// Add its new contribution, if it still exists
+	if (IsValid(Container) && Container->IsValidKey(Key))
+	{
+		const uint32 NewHash = Faerie::Hash::HashEntry(Container->View(Key).Item.Get());
+		State->EntryHashes.Add(Key, NewHash);
+		State->Sum += NewHash;
+		ChecksumSum += NewHash;
+	}
+
 	RecalcLocalChecksum();
 }
 
 void UContentHashExtension::RecalcLocalChecksum()
 {
-	TArray<uint32> Hashes;
-	PerContainerHash.GenerateValueArray(*reinterpret_cast<TArray<FFaerieHash>*>(&Hashes));
-
-	LocalChecksum = Faerie::Hash::CombineHashes(Hashes);
+	LocalChecksum = FFaerieHash(ChecksumSum);
 
 	if (GetTypedOuter<AActor>()->GetNetMode() < NM_Client)
 	{
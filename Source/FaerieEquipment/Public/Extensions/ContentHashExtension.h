@@ -41,7 +41,12 @@ public:
 	//~ UItemContainerExtensionBase
 
 protected:
+	// Rehash every entry in a container. Only needed when a container is first seen, or loaded.
 	void RecalcContainerHash(const UFaerieItemContainerBase* Container);
+
+	// Rehash a single entry, or remove it if it no longer exists. Called for each event.
+	void UpdateEntryHash(const UFaerieItemContainerBase* Container, FEntryKey Key);
+
 	void RecalcLocalChecksum();
 
 	void CheckLocalChecksum();
@@ -78,5 +83,18 @@ private:
 	// Are our checksums known to currently match.
 	bool ChecksumsMatch = true;
 
-	TMap<FObjectKey, FFaerieHash> PerContainerHash;
+	struct FContainerHashState
+	{
+		// The contribution of each entry to Sum.
+		TMap<FEntryKey, uint32> EntryHashes;
+
+		// Wrapping sum of EntryHashes. Addition is order-independent, so this matches on client and server
+		// regardless of the order entries were added in.
+		uint32 Sum = 0;
+	};
+
+	TMap<FObjectKey, FContainerHashState> PerContainerHash;
+
+	// Wrapping sum of all container Sums. This is the raw value of LocalChecksum.
+	uint32 ChecksumSum = 0;
 };
\ No newline at end of file
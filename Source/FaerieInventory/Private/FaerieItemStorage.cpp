@@ -4,12 +4,20 @@
 #include "FaerieInventorySettings.h"
 
 #include "FaerieItem.h"
+#include "FaerieItemDataComparator.h"
+#include "FaerieItemDataFilter.h"
+#include "FaerieItemDataFilterProgram.h"
 #include "InventoryStorageProxy.h"
 #include "ItemContainerExtensionBase.h"
 #include "Tokens/FaerieItemStorageToken.h"
 #include "Tokens/FaerieStackLimiterToken.h"
 
+#include "Algo/IsSorted.h"
+#include "Algo/Unique.h"
+#include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "Providers/FlakesBinarySerializer.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FaerieItemStorage)
@@ -17,6 +25,22 @@
 DECLARE_STATS_GROUP(TEXT("FaerieItemStorage"), STATGROUP_FaerieItemStorage, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("Query (First)"), STAT_Storage_QueryFirst, STATGROUP_FaerieItemStorage);
 DECLARE_CYCLE_STAT(TEXT("Query (All)"), STAT_Storage_QueryAll, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Query View (First)"), STAT_Storage_QueryFirstView, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Query View (All)"), STAT_Storage_QueryAllView, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Find Stackable Entry"), STAT_Storage_FindStackable, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Add Stack"), STAT_Storage_AddStack, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Add Batch"), STAT_Storage_AddBatch, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Remove From Entry"), STAT_Storage_RemoveFromEntry, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Remove From Stack"), STAT_Storage_RemoveFromStack, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Remove Batch"), STAT_Storage_RemoveBatch, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Move Stack"), STAT_Storage_MoveStack, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Move Entry"), STAT_Storage_MoveEntry, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Merge Stacks"), STAT_Storage_MergeStacks, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Split Stack"), STAT_Storage_SplitStack, STATGROUP_FaerieItemStorage);
+DECLARE_CYCLE_STAT(TEXT("Compact Proxies"), STAT_Storage_CompactProxies, STATGROUP_FaerieItemStorage);
+
+// Timings for storage mutations are also recorded by the CSV profiler (-csvprofile, or "csvprofile start").
+CSV_DEFINE_CATEGORY(FaerieItemStorage, true);
 
 DEFINE_LOG_CATEGORY(LogFaerieItemStorage);
 
@@ -53,6 +77,9 @@ void UFaerieItemStorage::PostLoad()
 		KeyGen.SetPosition(EntryMap.GetKeyAt(EntryMap.Num()-1));
 	}
 	// See Footnote1
+
+	RebuildStackingIndex();
+	RebuildItemIndex();
 }
 
 void UFaerieItemStorage::AddSubobjectsForReplication(AActor* Actor)
@@ -94,6 +121,9 @@ void UFaerieItemStorage::LoadSaveData(const FFaerieContainerSaveData& SaveData)
 		KeyGen.SetPosition(EntryMap.GetKeyAt(EntryMap.Num()-1));
 	}
 
+	RebuildStackingIndex();
+	RebuildItemIndex();
+
 	// Rebuild extension state
 
 	//@todo broadcast full refresh event?
@@ -138,14 +168,29 @@ void UFaerieItemStorage::OnItemMutated(const UFaerieItem* Item, const UFaerieIte
 {
 	Super::OnItemMutated(Item, Token);
 
-	// @todo annoying but acceptable
-	for (const FKeyedInventoryEntry& Element : EntryMap)
+	const FEntryKey Key = FindItemByPointer(Item);
+	if (!Key.IsValid())
 	{
-		if (Element.Value.ItemObject == Item)
-		{
-			PostContentChanged(Element);
-			return;
-		}
+		return;
+	}
+
+	MutatedEntries.Add(Key);
+
+	if (MutationFlushTimer.IsValid())
+	{
+		return;
+	}
+
+	// Outside of play there is no tick to wait for, so notify immediately.
+	if (const UWorld* World = GetWorld();
+		World && World->HasBegunPlay())
+	{
+		MutationFlushTimer = World->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &ThisClass::FlushMutatedEntries));
+	}
+	else
+	{
+		FlushMutatedEntries();
 	}
 }
 
@@ -176,8 +221,10 @@ void UFaerieItemStorage::PostContentAdded(const FKeyedInventoryEntry& Entry)
 		return;
 	}
 
-	OnKeyAddedCallback.Broadcast(this, Entry.Key);
-	OnKeyAdded.Broadcast(this, Entry.Key);
+	AddToStackingIndex(Entry);
+	AddToItemIndex(Entry);
+
+	BroadcastKeyAdded(Entry.Key);
 
 	// Proxies may already exist for keys on the client if they are replicated by extensions or other means, and
 	// happened to arrive before we got them.
@@ -190,14 +237,15 @@ void UFaerieItemStorage::PostContentAdded(const FKeyedInventoryEntry& Entry)
 		}
 	}
 
-	for (auto&& Keys = GetInvKeysForEntry(Entry.Key);
-		auto&& Key : Keys)
+	if (auto&& StackProxies = LocalStackProxies.Find(Entry.Key))
 	{
-		if (auto&& StackProxy = LocalStackProxies.Find(Key))
+		// Copied, as creation callbacks may request more proxies for this entry.
+		const FStackProxyList Proxies = *StackProxies;
+		for (auto&& [StackKey, StackProxy] : Proxies)
 		{
-			if (StackProxy->IsValid())
+			if (StackProxy.IsValid() && Entry.Value.Contains(StackKey))
 			{
-				StackProxy->Get()->NotifyCreation();
+				StackProxy->NotifyCreation();
 			}
 		}
 	}
@@ -219,12 +267,18 @@ void UFaerieItemStorage::PostContentChanged(const FKeyedInventoryEntry& Entry)
 	// Call updates on any entry and stack proxies
 	if (IsValidKey(Entry.Key))
 	{
+		// On clients, the item object may not have been mapped yet when the entry was added.
+		if (!StackingHashes.Contains(Entry.Key))
+		{
+			AddToStackingIndex(Entry);
+		}
+		AddToItemIndex(Entry);
+
 		// @todo this is the usage of the Deprecated API that needs to be replaced, before we can remove it.
 		// It's the only time this API is called on the client (where we don't have event logs). Needs another solution!
 		Extensions->PostEntryChanged_DEPRECATED(this, Entry.Key);
 
-		OnKeyUpdatedCallback.Broadcast(this, Entry.Key);
-		OnKeyUpdated.Broadcast(this, Entry.Key);
+		BroadcastKeyUpdated(Entry.Key);
 
 		// Call update on the entry proxy
 		if (auto&& EntryProxy = LocalEntryProxies.Find(Entry.Key))
@@ -237,34 +291,45 @@ void UFaerieItemStorage::PostContentChanged(const FKeyedInventoryEntry& Entry)
 
 		// Call updates on any stack proxies.
 		// PostContentChanged is called when stacks are removed as well, so let's do some cleanup here.
-		// Start by getting all the Keys that we could have proxies for.
-		const TSet<FInventoryKey> Keys(GetInvKeysForEntry(Entry.Key));
-		TArray<FInventoryKey> Cleanup;
-		for (auto&& LocalStackProxy : LocalStackProxies)
+		if (auto&& StackProxies = LocalStackProxies.Find(Entry.Key))
 		{
-			// Check for local proxies that match this entry
-			if (!LocalStackProxy.Value.IsValid() ||
-				LocalStackProxy.Key.EntryKey != Entry.Key)
+			// Sort the proxies out before notifying any of them, as the callbacks may request more proxies.
+			TArray<UInventoryStackProxy*, TInlineAllocator<4>> Updated;
+			TArray<UInventoryStackProxy*, TInlineAllocator<4>> Removed;
+			for (int32 i = StackProxies->Num() - 1; i >= 0; --i)
 			{
-				continue;
+				auto&& [StackKey, StackProxy] = (*StackProxies)[i];
+
+				// If this is a key we are supposed to have update it.
+				if (UInventoryStackProxy* Proxy = StackProxy.Get();
+					IsValid(Proxy) && Entry.Value.Contains(StackKey))
+				{
+					Updated.Add(Proxy);
+				}
+				// Otherwise, discard it.
+				else
+				{
+					if (IsValid(Proxy))
+					{
+						Removed.Add(Proxy);
+					}
+					StackProxies->RemoveAtSwap(i, EAllowShrinking::No);
+				}
 			}
 
-			// If this is a key we are supposed to have update it.
-			if (Keys.Contains(LocalStackProxy.Key))
+			if (StackProxies->IsEmpty())
 			{
-				LocalStackProxy.Value->NotifyUpdate();
+				LocalStackProxies.Remove(Entry.Key);
 			}
-			// Otherwise, discard it.
-			else
+
+			for (UInventoryStackProxy* Proxy : Updated)
 			{
-				Cleanup.Add(LocalStackProxy.Key);
-				LocalStackProxy.Value->NotifyRemoval();
+				Proxy->NotifyUpdate();
+			}
+			for (UInventoryStackProxy* Proxy : Removed)
+			{
+				Proxy->NotifyRemoval();
 			}
-		}
-
-		for (const FInventoryKey Key : Cleanup)
-		{
-			LocalStackProxies.Remove(Key);
 		}
 	}
 	else
@@ -281,8 +346,11 @@ void UFaerieItemStorage::PreContentRemoved(const FKeyedInventoryEntry& Entry)
 		return;
 	}
 
-	OnKeyRemovedCallback.Broadcast(this, Entry.Key);
-	OnKeyRemoved.Broadcast(this, Entry.Key);
+	RemoveFromStackingIndex(Entry.Key);
+	RemoveFromItemIndex(Entry.Key);
+	MutatedEntries.Remove(Entry.Key);
+
+	BroadcastKeyRemoved(Entry.Key);
 
 	// Cleanup local views.
 
@@ -293,10 +361,10 @@ void UFaerieItemStorage::PreContentRemoved(const FKeyedInventoryEntry& Entry)
 		EntryProxy->NotifyRemoval();
 	}
 
-	for (auto&& Stack : Entry.Value.Stacks)
+	FStackProxyList StackProxies;
+	LocalStackProxies.RemoveAndCopyValue(Entry.Key, StackProxies);
+	for (auto&& [StackKey, StackProxy] : StackProxies)
 	{
-		TWeakObjectPtr<UInventoryStackProxy> StackProxy;
-		LocalStackProxies.RemoveAndCopyValue({Entry.Key, Stack.Key}, StackProxy);
 		if (StackProxy.IsValid())
 		{
 			StackProxy->NotifyRemoval();
@@ -329,10 +397,14 @@ UInventoryEntryProxy* UFaerieItemStorage::GetEntryProxyImpl(const FEntryKey Key)
 
 	ThisClass* This = const_cast<ThisClass*>(this);
 
-	const FName ProxyName = MakeUniqueObjectName(This, UInventoryEntryProxy::StaticClass(),
-												 *FString::Printf(TEXT("ENTRY_PROXY_%s"), *Key.ToString()));
-	UInventoryEntryProxy* NewEntryProxy = NewObject<UInventoryEntryProxy>(This, UInventoryEntryProxy::StaticClass(),
-																	ProxyName);
+	if (LocalEntryProxies.Num() + LocalStackProxies.Num() >= ProxyCompactionThreshold)
+	{
+		This->CompactLocalProxies();
+	}
+
+	// Proxies are left to take a generated name. Building one from the key costs a string format and a name lookup
+	// for every proxy, and the key is already logged by VerifyStatus.
+	UInventoryEntryProxy* NewEntryProxy = NewObject<UInventoryEntryProxy>(This, UInventoryEntryProxy::StaticClass());
 	check(IsValid(NewEntryProxy));
 
 	NewEntryProxy->Key = Key;
@@ -353,35 +425,322 @@ UInventoryStackProxy* UFaerieItemStorage::GetStackProxyImpl(const FInventoryKey
 	// Don't create proxies for invalid keys.
 	if (!Key.IsValid()) return nullptr;
 
-	if (auto&& ExistingProxy = LocalStackProxies.Find(Key))
+	TWeakObjectPtr<UInventoryStackProxy>* Slot = nullptr;
+
+	if (auto&& ExistingProxies = LocalStackProxies.Find(Key.EntryKey))
 	{
-		if (ExistingProxy && ExistingProxy->IsValid())
+		for (auto&& [StackKey, StackProxy] : *ExistingProxies)
 		{
-			return ExistingProxy->Get();
+			if (StackKey == Key.StackKey)
+			{
+				if (StackProxy.IsValid())
+				{
+					return StackProxy.Get();
+				}
+
+				// Reuse the slot of the proxy that died.
+				Slot = &StackProxy;
+				break;
+			}
 		}
 	}
 
 	ThisClass* This = const_cast<ThisClass*>(this);
 
-	const FName ProxyName = MakeUniqueObjectName(This, UInventoryStackProxy::StaticClass(),
-												 *FString::Printf(TEXT("ENTRY_PROXY_%s_%s"),
-												 *Key.EntryKey.ToString(), *Key.StackKey.ToString()));
-	UInventoryStackProxy* NewEntryProxy = NewObject<UInventoryStackProxy>(This, UInventoryStackProxy::StaticClass(), ProxyName);
+	if (!Slot && LocalEntryProxies.Num() + LocalStackProxies.Num() >= ProxyCompactionThreshold)
+	{
+		This->CompactLocalProxies();
+	}
+
+	UInventoryStackProxy* NewEntryProxy = NewObject<UInventoryStackProxy>(This, UInventoryStackProxy::StaticClass());
 	check(IsValid(NewEntryProxy));
 
 	NewEntryProxy->ItemStorage = This;
 	NewEntryProxy->Key = Key;
 
+	// Add the proxy before notifying it, so that callbacks requesting it again will find it.
+	if (Slot)
+	{
+		*Slot = NewEntryProxy;
+	}
+	else
+	{
+		This->LocalStackProxies.FindOrAdd(Key.EntryKey).Emplace(Key.StackKey, NewEntryProxy);
+	}
+
 	if (IsValidKey(Key))
 	{
 		NewEntryProxy->NotifyCreation();
 	}
 
-	This->LocalStackProxies.Add(Key, NewEntryProxy);
-
 	return NewEntryProxy;
 }
 
+void UFaerieItemStorage::CompactLocalProxies()
+{
+	SCOPE_CYCLE_COUNTER(STAT_Storage_CompactProxies);
+
+	for (auto It = LocalEntryProxies.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = LocalStackProxies.CreateIterator(); It; ++It)
+	{
+		It->Value.RemoveAllSwap(
+			[](const TPair<FStackKey, TWeakObjectPtr<UInventoryStackProxy>>& Pair)
+			{
+				return !Pair.Value.IsValid();
+			}, EAllowShrinking::No);
+
+		if (It->Value.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Wait until the maps have doubled in size again before the next pass, so the cost is amortized over proxy creation.
+	ProxyCompactionThreshold = FMath::Max(64, (LocalEntryProxies.Num() + LocalStackProxies.Num()) * 2);
+}
+
+
+FEntryKey UFaerieItemStorage::FindStackableEntryImpl(const UFaerieItem* Item) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Storage_FindStackable);
+
+	// Mutable items never stack, and are never filed in the index.
+	if (!IsValid(Item) || Item->IsDataMutable())
+	{
+		return FEntryKey();
+	}
+
+	// Only entries in the same bucket can possibly pass CompareWith. Most buckets contain a single entry, so the deep
+	// comparison is only repeated on hash collisions.
+	for (auto It = StackingIndex.CreateConstKeyIterator(Item->GetContentHash()); It; ++It)
+	{
+		if (const FInventoryEntry* Entry = EntryMap.Find(It.Value());
+			Entry && Item->CompareWith(Entry->ItemObject))
+		{
+			return It.Value();
+		}
+	}
+
+	return FEntryKey();
+}
+
+void UFaerieItemStorage::AddToStackingIndex(const FKeyedInventoryEntry& Entry)
+{
+	if (!IsValid(Entry.Value.ItemObject) || Entry.Value.ItemObject->IsDataMutable())
+	{
+		return;
+	}
+
+	const uint32 Hash = Entry.Value.ItemObject->GetContentHash();
+	StackingIndex.AddUnique(Hash, Entry.Key);
+	StackingHashes.Add(Entry.Key, Hash);
+}
+
+void UFaerieItemStorage::RemoveFromStackingIndex(const FEntryKey Key)
+{
+	if (uint32 Hash;
+		StackingHashes.RemoveAndCopyValue(Key, Hash))
+	{
+		StackingIndex.RemoveSingle(Hash, Key);
+	}
+}
+
+void UFaerieItemStorage::RebuildStackingIndex()
+{
+	StackingIndex.Reset();
+	StackingHashes.Reset();
+
+	for (const FKeyedInventoryEntry& Entry : EntryMap)
+	{
+		AddToStackingIndex(Entry);
+	}
+}
+
+void UFaerieItemStorage::AddToItemIndex(const FKeyedInventoryEntry& Entry)
+{
+	// On clients, the item object may not have been mapped yet.
+	if (!IsValid(Entry.Value.ItemObject))
+	{
+		return;
+	}
+
+	const TObjectKey<UFaerieItem> Item(Entry.Value.ItemObject.Get());
+
+	if (const TObjectKey<UFaerieItem>* PreviousItem = IndexedItems.Find(Entry.Key))
+	{
+		if (*PreviousItem == Item)
+		{
+			return;
+		}
+
+		// The entry's item object was replaced, so its old mapping must go, or lookups by the old item still find it.
+		ItemIndex.RemoveSingle(*PreviousItem, Entry.Key);
+	}
+
+	ItemIndex.Add(Item, Entry.Key);
+	IndexedItems.Add(Entry.Key, Item);
+}
+
+void UFaerieItemStorage::RemoveFromItemIndex(const FEntryKey Key)
+{
+	if (TObjectKey<UFaerieItem> Item;
+		IndexedItems.RemoveAndCopyValue(Key, Item))
+	{
+		ItemIndex.RemoveSingle(Item, Key);
+	}
+}
+
+void UFaerieItemStorage::RebuildItemIndex()
+{
+	ItemIndex.Reset();
+	IndexedItems.Reset();
+
+	for (const FKeyedInventoryEntry& Entry : EntryMap)
+	{
+		AddToItemIndex(Entry);
+	}
+}
+
+FEntryKey UFaerieItemStorage::FindItemByPointer(const UFaerieItem* Item) const
+{
+	// Return the lowest key, so that results match a scan of the EntryMap in order.
+	FEntryKey Out;
+	for (auto It = ItemIndex.CreateConstKeyIterator(Item); It; ++It)
+	{
+		if (!Out.IsValid() || It.Value() < Out)
+		{
+			Out = It.Value();
+		}
+	}
+	return Out;
+}
+
+void UFaerieItemStorage::BroadcastKeyAdded(const FEntryKey Key)
+{
+	if (IsBatchingNotifications())
+	{
+		PendingAdded.Add(Key);
+		ScheduleNotificationFlush();
+		return;
+	}
+
+	OnKeyAddedCallback.Broadcast(this, Key);
+	OnKeyAdded.Broadcast(this, Key);
+
+	if (OnKeysChangedCallback.IsBound() || OnKeysChanged.IsBound())
+	{
+		FFaerieStorageChangeSet Changes;
+		Changes.Added.Add(Key);
+		BroadcastChangeSet(Changes);
+	}
+}
+
+void UFaerieItemStorage::BroadcastKeyUpdated(const FEntryKey Key)
+{
+	if (IsBatchingNotifications())
+	{
+		// Listeners will already be told about keys that are new this batch.
+		if (!PendingAdded.Contains(Key))
+		{
+			PendingUpdated.Add(Key);
+		}
+		ScheduleNotificationFlush();
+		return;
+	}
+
+	OnKeyUpdatedCallback.Broadcast(this, Key);
+	OnKeyUpdated.Broadcast(this, Key);
+
+	if (OnKeysChangedCallback.IsBound() || OnKeysChanged.IsBound())
+	{
+		FFaerieStorageChangeSet Changes;
+		Changes.Updated.Add(Key);
+		BroadcastChangeSet(Changes);
+	}
+}
+
+void UFaerieItemStorage::BroadcastKeyRemoved(const FEntryKey Key)
+{
+	if (IsBatchingNotifications())
+	{
+		// Keys that were added this batch were never seen by listeners, so they can be forgotten entirely.
+		if (PendingAdded.Remove(Key) == 0)
+		{
+			PendingUpdated.Remove(Key);
+			PendingRemoved.Add(Key);
+		}
+		ScheduleNotificationFlush();
+		return;
+	}
+
+	OnKeyRemovedCallback.Broadcast(this, Key);
+	OnKeyRemoved.Broadcast(this, Key);
+
+	if (OnKeysChangedCallback.IsBound() || OnKeysChanged.IsBound())
+	{
+		FFaerieStorageChangeSet Changes;
+		Changes.Removed.Add(Key);
+		BroadcastChangeSet(Changes);
+	}
+}
+
+void UFaerieItemStorage::BroadcastChangeSet(const FFaerieStorageChangeSet& Changes)
+{
+	OnKeysChangedCallback.Broadcast(this, Changes);
+	OnKeysChanged.Broadcast(this, Changes);
+}
+
+void UFaerieItemStorage::ScheduleNotificationFlush()
+{
+	// Explicit batches flush when they end.
+	if (NotificationBatchDepth > 0 || NotificationFlushTimer.IsValid())
+	{
+		return;
+	}
+
+	// Outside of play there is no tick to wait for, so notify immediately.
+	if (const UWorld* World = GetWorld();
+		World && World->HasBegunPlay())
+	{
+		NotificationFlushTimer = World->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &ThisClass::FlushNotifications));
+	}
+	else
+	{
+		FlushNotifications();
+	}
+}
+
+void UFaerieItemStorage::FlushMutatedEntries()
+{
+	MutationFlushTimer.Invalidate();
+
+	// Moved out first, as change notifications may mutate more items.
+	const TSet<FEntryKey> Keys = MoveTemp(MutatedEntries);
+	MutatedEntries.Reset();
+
+	for (const FEntryKey Key : Keys)
+	{
+		if (!IsValidKey(Key))
+		{
+			continue;
+		}
+
+		const FKeyedInventoryEntry& Element = EntryMap.GetElement(Key);
+
+		// The item's content hash may no longer match the bucket it was filed under.
+		RemoveFromStackingIndex(Element.Key);
+		AddToStackingIndex(Element);
+		PostContentChanged(Element);
+	}
+}
 
 void UFaerieItemStorage::GetEntryImpl(const FEntryKey Key, FInventoryEntry& Entry) const
 {
@@ -390,6 +749,22 @@ void UFaerieItemStorage::GetEntryImpl(const FEntryKey Key, FInventoryEntry& Entr
 }
 
 Faerie::Inventory::FEventLog UFaerieItemStorage::AddStackImpl(const FFaerieItemStack& InStack, const bool ForceNewStack)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Storage_AddStack);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, AddStack);
+
+	Faerie::Inventory::FEventLog Event = AddStackImpl_NoNotify(InStack, ForceNewStack);
+
+	if (Event.Success)
+	{
+		// Execute PostAddition on all extensions with the finished Event
+		Extensions->PostAddition(this, Event);
+	}
+
+	return Event;
+}
+
+Faerie::Inventory::FEventLog UFaerieItemStorage::AddStackImpl_NoNotify(const FFaerieItemStack& InStack, const bool ForceNewStack)
 {
 	if (!ensureAlwaysMsgf(
 			IsValid(InStack.Item) &&
@@ -410,11 +785,7 @@ Faerie::Inventory::FEventLog UFaerieItemStorage::AddStackImpl(const FFaerieItemS
 	// uniquely mutate from others.
 	if (!InStack.Item->IsDataMutable())
 	{
-		Event.EntryTouched = QueryFirst(
-			[InStack](const FFaerieItemProxy& Other)
-			{
-				return InStack.Item->CompareWith(Other.GetItemObject());
-			}).Key;
+		Event.EntryTouched = FindStackableEntryImpl(InStack.Item);
 	}
 
 	// Execute PreAddition on all extensions
@@ -452,15 +823,37 @@ Faerie::Inventory::FEventLog UFaerieItemStorage::AddStackImpl(const FFaerieItemS
 
 	Event.Success = true;
 
-	// Execute PostAddition on all extensions with the finished Event
-	Extensions->PostAddition(this, Event);
-
 	return Event;
 }
 
+void UFaerieItemStorage::AddBatchImpl(const TConstArrayView<FFaerieItemStack> Stacks, const bool ForceNewStack,
+									  TArray<Faerie::Inventory::FEventLog>& OutEvents)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Storage_AddBatch);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, AddBatch);
+
+	const int32 FirstEvent = OutEvents.Num();
+	OutEvents.Reserve(FirstEvent + Stacks.Num());
+
+	for (const FFaerieItemStack& Stack : Stacks)
+	{
+		if (Faerie::Inventory::FEventLog Event = AddStackImpl_NoNotify(Stack, ForceNewStack);
+			Event.Success)
+		{
+			OutEvents.Add(MoveTemp(Event));
+		}
+	}
+
+	// Execute PostAdditionBatch on all extensions once, with every finished Event
+	Extensions->PostAdditionBatch(this, TConstArrayView<Faerie::Inventory::FEventLog>(OutEvents).RightChop(FirstEvent));
+}
+
 Faerie::Inventory::FEventLog UFaerieItemStorage::RemoveFromEntryImpl(const FEntryKey Key, const int32 Amount,
                                                                 const FFaerieInventoryTag Reason)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Storage_RemoveFromEntry);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, RemoveFromEntry);
+
 	// RemoveEntryImpl should not be called with unvalidated parameters.
 	check(IsValidKey(Key));
 	check(Faerie::ItemData::IsValidStack(Amount));
@@ -500,7 +893,7 @@ Faerie::Inventory::FEventLog UFaerieItemStorage::RemoveFromEntryImpl(const FEntr
 
 	if (Remove)
 	{
-		UE_LOG(LogFaerieItemStorage, Log, TEXT("Removing entire entry at: '%s'"), *Key.ToString());
+		UE_LOG(LogFaerieItemStorage, Verbose, TEXT("Removing entire entry at: '%s'"), *Key.ToString());
 		EntryMap.Remove(Key);
 	}
 
@@ -512,6 +905,9 @@ Faerie::Inventory::FEventLog UFaerieItemStorage::RemoveFromEntryImpl(const FEntr
 Faerie::Inventory::FEventLog UFaerieItemStorage::RemoveFromStackImpl(const FInventoryKey Key, const int32 Amount,
 																	 const FFaerieInventoryTag Reason)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Storage_RemoveFromStack);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, RemoveFromStack);
+
 	// RemoveEntryImpl should not be called with unvalidated parameters.
 	check(Faerie::ItemData::IsValidStack(Amount));
 	check(IsValidKey(Key.EntryKey));
@@ -561,7 +957,7 @@ Faerie::Inventory::FEventLog UFaerieItemStorage::RemoveFromStackImpl(const FInve
 
 	if (Remove)
 	{
-		UE_LOG(LogFaerieItemStorage, Log, TEXT("Removing entire stack at: '%s'"), *Key.ToString());
+		UE_LOG(LogFaerieItemStorage, Verbose, TEXT("Removing entire stack at: '%s'"), *Key.ToString());
 		EntryMap.Remove(Key.EntryKey);
 	}
 
@@ -573,6 +969,45 @@ Faerie::Inventory::FEventLog UFaerieItemStorage::RemoveFromStackImpl(const FInve
 	return Event;
 }
 
+void UFaerieItemStorage::RemoveBatchImpl(const TConstArrayView<FEntryKey> SortedKeys, const FFaerieInventoryTag Reason,
+										 TArray<Faerie::Inventory::FEventLog>& OutEvents)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Storage_RemoveBatch);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, RemoveBatch);
+
+	// RemoveBatchImpl should not be called with unvalidated parameters.
+	check(Algo::IsSorted(SortedKeys));
+	check(Reason.MatchesTag(Faerie::Inventory::Tags::RemovalBase))
+
+	const int32 FirstEvent = OutEvents.Num();
+	OutEvents.Reserve(FirstEvent + SortedKeys.Num());
+
+	for (const FEntryKey Key : SortedKeys)
+	{
+		check(IsValidKey(Key));
+
+		const FInventoryEntry& Entry = EntryMap[Key];
+
+		Extensions->PreRemoval(this, Key, Faerie::ItemData::UnlimitedStack);
+
+		Faerie::Inventory::FEventLog& Event = OutEvents.AddDefaulted_GetRef();
+		Event.Type = Reason;
+		Event.EntryTouched = Key;
+		Event.Item = Entry.ItemObject;
+		Event.Amount = Entry.StackSum();
+		Event.StackKeys = Entry.CopyKeys();
+		Event.Success = true;
+
+		ReleaseOwnership(Entry.ItemObject);
+	}
+
+	// Remove every entry in one pass, instead of shifting the array once per entry.
+	const int32 Removed = EntryMap.RemoveBatch(SortedKeys);
+	UE_LOG(LogFaerieItemStorage, Verbose, TEXT("Removed %i entries in batch"), Removed);
+
+	Extensions->PostRemovalBatch(this, TConstArrayView<Faerie::Inventory::FEventLog>(OutEvents).RightChop(FirstEvent));
+}
+
 
 	/**------------------------------*/
 	/*	 STORAGE API - ALL USERS   */
@@ -651,15 +1086,12 @@ FEntryKey UFaerieItemStorage::FindItem(const UFaerieItem* Item, const EFaerieIte
 	switch (Method)
 	{
 	case EFaerieItemEqualsCheck::ComparePointers:
-		for (const FKeyedInventoryEntry& Entry : EntryMap)
+		return FindItemByPointer(Item);
+	case EFaerieItemEqualsCheck::UseCompareWith:
+		if (!Item->IsDataMutable())
 		{
-			if (Entry.Value.ItemObject == Item)
-			{
-				return Entry.Key;
-			}
+			return FindStackableEntryImpl(Item);
 		}
-		break;
-	case EFaerieItemEqualsCheck::UseCompareWith:
 		for (const FKeyedInventoryEntry& Entry : EntryMap)
 		{
 			if (Entry.Value.ItemObject->CompareWith(Item))
@@ -782,6 +1214,52 @@ void UFaerieItemStorage::QueryAll(const Faerie::FStorageQuery& Query, TArray<FKe
 	}
 }
 
+FKeyedInventoryEntry UFaerieItemStorage::QueryFirstView(const Faerie::FStorageViewFilterFunc& Filter) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Storage_QueryFirstView);
+
+	for (const FKeyedInventoryEntry& Item : EntryMap)
+	{
+		if (Filter(Item.Value.ToItemStackView()))
+		{
+			return Item;
+		}
+	}
+
+	return FKeyedInventoryEntry();
+}
+
+void UFaerieItemStorage::QueryAllView(const Faerie::FStorageViewQuery& Query, TArray<FKeyedInventoryEntry>& OutKeys) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Storage_QueryAllView);
+
+	// Ensure we are starting with a blank slate.
+	OutKeys.Empty();
+
+	if (Query.Filter.IsBound())
+	{
+		Algo::CopyIf(EntryMap, OutKeys,
+			[&Query](const FKeyedInventoryEntry& Item)
+			{
+				return Query.Filter.Execute(Item.Value.ToItemStackView()) != Query.InvertFilter;
+			});
+	}
+	else
+	{
+		OutKeys = EntryMap.Entries;
+	}
+
+	if (Query.Sort.IsBound())
+	{
+		Algo::Sort(OutKeys,
+			[&Query](const FKeyedInventoryEntry& A, const FKeyedInventoryEntry& B)
+			{
+				const bool Result = Query.Sort.Execute(A.Value.ToItemStackView(), B.Value.ToItemStackView());
+				return Query.InvertSort ? !Result : Result;
+			});
+	}
+}
+
 FEntryKey UFaerieItemStorage::QueryFirst(const FBlueprintStorageFilter& Filter) const
 {
 	if (!Filter.IsBound()) return FEntryKey();
@@ -795,6 +1273,34 @@ FEntryKey UFaerieItemStorage::QueryFirst(const FBlueprintStorageFilter& Filter)
 
 void UFaerieItemStorage::QueryAll(const FFaerieItemStorageBlueprintQuery& Query, TArray<FEntryKey>& OutKeys) const
 {
+	// Blueprint delegates are given proxies, so only take the proxy-free path if neither are in use.
+	if (!Query.Filter.IsBound() && !Query.Sort.IsBound() &&
+		(!IsValid(Query.SortRule) || Query.SortRule->SupportsStackViews()))
+	{
+		Faerie::FStorageViewQuery NativeQuery;
+		if (IsValid(Query.FilterRule))
+		{
+			// Compile the rule once, instead of walking the rule tree for each entry.
+			NativeQuery.Filter.BindLambda(
+				[Program = Faerie::ItemData::FFilterProgram::Compile(Query.FilterRule)](const FFaerieItemStackView View)
+				{
+					return Program.Exec(View);
+				});
+			NativeQuery.InvertFilter = Query.InvertFilter;
+		}
+		if (IsValid(Query.SortRule))
+		{
+			NativeQuery.Sort.BindUObject(Query.SortRule.Get(), &UFaerieItemDataComparator::ExecView);
+			NativeQuery.InvertSort = Query.Reverse;
+		}
+
+		TArray<FKeyedInventoryEntry> Entries;
+		QueryAllView(NativeQuery, Entries);
+		OutKeys.Reserve(Entries.Num());
+		Algo::Transform(Entries, OutKeys, &FKeyedInventoryEntry::Key);
+		return;
+	}
+
 	Faerie::FStorageQuery NativeQuery;
 	if (Query.Filter.IsBound())
 	{
@@ -805,6 +1311,15 @@ void UFaerieItemStorage::QueryAll(const FFaerieItemStorageBlueprintQuery& Query,
 			});
 		NativeQuery.InvertFilter = Query.InvertFilter;
 	}
+	else if (IsValid(Query.FilterRule))
+	{
+		NativeQuery.Filter.BindLambda(
+			[FilterRule = Query.FilterRule](const FFaerieItemProxy& Proxy)
+			{
+				return FilterRule->Exec(Proxy);
+			});
+		NativeQuery.InvertFilter = Query.InvertFilter;
+	}
 
 	if (Query.Sort.IsBound())
 	{
@@ -815,6 +1330,15 @@ void UFaerieItemStorage::QueryAll(const FFaerieItemStorageBlueprintQuery& Query,
 			});
 		NativeQuery.InvertSort = Query.Reverse;
 	}
+	else if (IsValid(Query.SortRule))
+	{
+		NativeQuery.Sort.BindLambda(
+			[SortRule = Query.SortRule](const FFaerieItemProxy& A, const FFaerieItemProxy& B)
+			{
+				return SortRule->Exec(A, B);
+			});
+		NativeQuery.InvertSort = Query.Reverse;
+	}
 
 	TArray<FKeyedInventoryEntry> Entries;
 	QueryAll(NativeQuery, Entries);
@@ -822,7 +1346,7 @@ void UFaerieItemStorage::QueryAll(const FFaerieItemStorageBlueprintQuery& Query,
 	Algo::Transform(Entries, OutKeys, &FKeyedInventoryEntry::Key);
 }
 
-bool UFaerieItemStorage::CanAddStack(const FFaerieItemStackView Stack, const EFaerieStorageAddStackBehavior AddStackBehavior) const
+bool UFaerieItemStorage::CanAddStackImpl(const FFaerieItemStackView Stack) const
 {
 	if (!Stack.Item.IsValid() ||
 		Stack.Copies < 1)
@@ -846,6 +1370,16 @@ bool UFaerieItemStorage::CanAddStack(const FFaerieItemStackView Stack, const EFa
 		}
 	}
 
+	return true;
+}
+
+bool UFaerieItemStorage::CanAddStack(const FFaerieItemStackView Stack, const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	if (!CanAddStackImpl(Stack))
+	{
+		return false;
+	}
+
 	switch (Extensions->AllowsAddition(this, Stack, AddStackBehavior))
 	{
 	case EEventExtensionResponse::NoExplicitResponse:
@@ -855,6 +1389,25 @@ bool UFaerieItemStorage::CanAddStack(const FFaerieItemStackView Stack, const EFa
 	}
 }
 
+bool UFaerieItemStorage::CanAddBatch(const TConstArrayView<FFaerieItemStackView> Stacks, const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	for (const FFaerieItemStackView Stack : Stacks)
+	{
+		if (!CanAddStackImpl(Stack))
+		{
+			return false;
+		}
+	}
+
+	switch (Extensions->AllowsAdditionBatch(this, Stacks, AddStackBehavior))
+	{
+	case EEventExtensionResponse::NoExplicitResponse:
+	case EEventExtensionResponse::Allowed:				return true;
+	case EEventExtensionResponse::Disallowed:			return false;
+	default: return false;
+	}
+}
+
 bool UFaerieItemStorage::CanEditEntry(const FEntryKey Key, const FFaerieInventoryTag EditTag) const
 {
 	// By default, some removal reasons are allowed, unless an extension explicitly disallows it.
@@ -932,6 +1485,30 @@ FLoggedInventoryEvent UFaerieItemStorage::AddItemStackWithLog(const FFaerieItemS
 	return {this, AddStackImpl(ItemStack, IfOnlyNewStacks(AddStackBehavior)) };
 }
 
+bool UFaerieItemStorage::AddBatch(const TArray<FFaerieItemStack>& Stacks, const EFaerieStorageAddStackBehavior AddStackBehavior)
+{
+	if (Stacks.IsEmpty())
+	{
+		return false;
+	}
+
+	TArray<FFaerieItemStackView> Views;
+	Views.Reserve(Stacks.Num());
+	for (const FFaerieItemStack& Stack : Stacks)
+	{
+		Views.Add(Stack);
+	}
+
+	if (!CanAddBatch(Views, AddStackBehavior))
+	{
+		return false;
+	}
+
+	TArray<Faerie::Inventory::FEventLog> Events;
+	AddBatchImpl(Stacks, IfOnlyNewStacks(AddStackBehavior), Events);
+	return true;
+}
+
 bool UFaerieItemStorage::RemoveEntry(const FEntryKey Key, const FFaerieInventoryTag RemovalTag, const int32 Amount)
 {
 	if (Amount == 0 || Amount < -1) return false;
@@ -955,6 +1532,26 @@ bool UFaerieItemStorage::RemoveStack(const FInventoryKey Key, const FFaerieInven
 	return true;
 }
 
+bool UFaerieItemStorage::RemoveBatch(const TArray<FEntryKey>& Keys, const FFaerieInventoryTag RemovalTag)
+{
+	if (Keys.IsEmpty()) return false;
+	if (!RemovalTag.IsValid()) return false;
+
+	TArray<FEntryKey> SortedKeys = Keys;
+	Algo::Sort(SortedKeys);
+	SortedKeys.SetNum(Algo::Unique(SortedKeys));
+
+	for (const FEntryKey Key : SortedKeys)
+	{
+		if (!IsValidKey(Key)) return false;
+		if (!CanRemoveEntry(Key, RemovalTag)) return false;
+	}
+
+	TArray<Faerie::Inventory::FEventLog> Events;
+	RemoveBatchImpl(SortedKeys, RemovalTag, Events);
+	return true;
+}
+
 bool UFaerieItemStorage::TakeEntry(const FEntryKey Key, FFaerieItemStack& OutStack,
                                    const FFaerieInventoryTag RemovalTag, const int32 Amount)
 {
@@ -1004,10 +1601,12 @@ void UFaerieItemStorage::Clear(FFaerieInventoryTag RemovalTag)
 		RemovalTag = Faerie::Inventory::Tags::RemovalDeletion;
 	}
 
-	for (const FKeyedInventoryEntry& Element : EntryMap)
-	{
-		RemoveFromEntryImpl(Element.Key, Faerie::ItemData::UnlimitedStack, RemovalTag);
-	}
+	// EntryMap is sorted, so its keys can be removed as a batch directly.
+	TArray<FEntryKey> Keys;
+	GetAllKeys(Keys);
+
+	TArray<Faerie::Inventory::FEventLog> Events;
+	RemoveBatchImpl(Keys, RemovalTag, Events);
 
 	checkf(EntryMap.IsEmpty(), TEXT("Clear failed to empty EntryMap"));
 
@@ -1024,6 +1623,9 @@ void UFaerieItemStorage::Clear(FFaerieInventoryTag RemovalTag)
 
 FEntryKey UFaerieItemStorage::MoveStack(UFaerieItemStorage* ToStorage, const FInventoryKey Key, const int32 Amount, const EFaerieStorageAddStackBehavior AddStackBehavior)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Storage_MoveStack);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, MoveStack);
+
 	if (!IsValid(ToStorage) ||
 		ToStorage == this ||
 		!IsValidKey(Key.EntryKey) ||
@@ -1055,6 +1657,9 @@ FEntryKey UFaerieItemStorage::MoveStack(UFaerieItemStorage* ToStorage, const FIn
 
 FEntryKey UFaerieItemStorage::MoveEntry(UFaerieItemStorage* ToStorage, const FEntryKey Key, const EFaerieStorageAddStackBehavior AddStackBehavior)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Storage_MoveEntry);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, MoveEntry);
+
 	if (!IsValid(ToStorage) ||
 		ToStorage == this ||
 		!IsValidKey(Key) ||
@@ -1089,6 +1694,9 @@ FEntryKey UFaerieItemStorage::MoveEntry(UFaerieItemStorage* ToStorage, const FEn
 
 bool UFaerieItemStorage::MergeStacks(const FEntryKey Entry, const FStackKey FromStack, const FStackKey ToStack, const int32 Amount)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Storage_MergeStacks);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, MergeStacks);
+
 	if (!IsValidKey(Entry) ||
 		!CanEditStack({Entry, FromStack}, Faerie::Inventory::Tags::Merge) ||
 		!CanEditStack({Entry, ToStack}, Faerie::Inventory::Tags::Merge))
@@ -1097,18 +1705,20 @@ bool UFaerieItemStorage::MergeStacks(const FEntryKey Entry, const FStackKey From
 	}
 
 	auto&& EntryView = GetEntryViewImpl(Entry);
+	const int32 AmountA = EntryView.Get().GetStack(FromStack);
 	const int32 AmountB = EntryView.Get().GetStack(ToStack);
 
-	// Ensure both stacks exist and B isn't already full
-	if (EntryView.Get().Contains(FromStack) ||
-		AmountB != INDEX_NONE ||
+	// Ensure both stacks exist, are different, and B isn't already full
+	if (FromStack == ToStack ||
+		!EntryView.Get().Contains(FromStack) ||
+		!EntryView.Get().Contains(ToStack) ||
 		AmountB == EntryView.Get().Limit)
 	{
 		return false;
 	}
 
 	Faerie::Inventory::FEventLog Event;
-	Event.Amount = AmountB; // Initially store the amount in stack B here.
+	Event.Amount = AmountA; // Initially store the amount in stack A here.
 	Event.Item = EntryView.Get().ItemObject;
 	Event.EntryTouched = Entry;
 	Event.StackKeys.Add(FromStack);
@@ -1133,6 +1743,9 @@ bool UFaerieItemStorage::MergeStacks(const FEntryKey Entry, const FStackKey From
 
 bool UFaerieItemStorage::SplitStack(const FEntryKey Entry, const FStackKey Stack, const int32 Amount)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Storage_SplitStack);
+	CSV_SCOPED_TIMING_STAT(FaerieItemStorage, SplitStack);
+
 	if (!IsValidKey(Entry) ||
 		!CanEditStack({Entry, Stack}, Faerie::Inventory::Tags::Split))
 	{
@@ -1170,20 +1783,117 @@ bool UFaerieItemStorage::SplitStack(const FEntryKey Entry, const FStackKey Stack
 	return true;
 }
 
-void UFaerieItemStorage::Dump(UFaerieItemStorage* ToStorage)
+void UFaerieItemStorage::BeginNotificationBatch()
+{
+	NotificationBatchDepth++;
+}
+
+void UFaerieItemStorage::EndNotificationBatch()
+{
+	if (!ensure(NotificationBatchDepth > 0)) return;
+
+	if (--NotificationBatchDepth == 0)
+	{
+		FlushNotifications();
+	}
+}
+
+void UFaerieItemStorage::FlushNotifications()
 {
-	// @todo this is not very optimized...
+	if (NotificationFlushTimer.IsValid())
+	{
+		if (const UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(NotificationFlushTimer);
+		}
+		NotificationFlushTimer.Invalidate();
+	}
+
+	if (PendingAdded.IsEmpty() && PendingUpdated.IsEmpty() && PendingRemoved.IsEmpty())
+	{
+		return;
+	}
+
+	// Taken out first, as listeners may cause more changes. Sorted, so listeners see keys in storage order.
+	FFaerieStorageChangeSet Changes;
+	Changes.Added = PendingAdded.Array();
+	Changes.Updated = PendingUpdated.Array();
+	Changes.Removed = PendingRemoved.Array();
+	PendingAdded.Reset();
+	PendingUpdated.Reset();
+	PendingRemoved.Reset();
+	Changes.Added.Sort();
+	Changes.Updated.Sort();
+	Changes.Removed.Sort();
+
+	for (const FEntryKey Key : Changes.Removed)
+	{
+		OnKeyRemovedCallback.Broadcast(this, Key);
+		OnKeyRemoved.Broadcast(this, Key);
+	}
+	for (const FEntryKey Key : Changes.Added)
+	{
+		OnKeyAddedCallback.Broadcast(this, Key);
+		OnKeyAdded.Broadcast(this, Key);
+	}
+	for (const FEntryKey Key : Changes.Updated)
+	{
+		OnKeyUpdatedCallback.Broadcast(this, Key);
+		OnKeyUpdated.Broadcast(this, Key);
+	}
 
+	BroadcastChangeSet(Changes);
+}
+
+void UFaerieItemStorage::Dump(UFaerieItemStorage* ToStorage)
+{
 	if (!IsValid(ToStorage) ||
 		ToStorage == this)
 	{
 		return;
 	}
 
+	// Gather every entry we are allowed to move. Keys are gathered in EntryMap order, so they are already sorted.
+	TArray<FEntryKey> Keys;
+	TArray<FFaerieItemStackView> Views;
+	Keys.Reserve(EntryMap.Num());
+	Views.Reserve(EntryMap.Num());
 	for (const FKeyedInventoryEntry& Element : EntryMap)
 	{
-		MoveEntry(ToStorage, Element.Key, EFaerieStorageAddStackBehavior::AddToAnyStack);
+		if (CanRemoveEntry(Element.Key, Faerie::Inventory::Tags::RemovalMoving))
+		{
+			Keys.Add(Element.Key);
+			Views.Add(Element.Value.ToItemStackView());
+		}
 	}
+
+	if (Keys.IsEmpty())
+	{
+		return;
+	}
+
+	if (!ToStorage->CanAddBatch(Views, EFaerieStorageAddStackBehavior::AddToAnyStack))
+	{
+		// The whole batch doesn't fit, so move entries one at a time, until they stop fitting.
+		for (const FEntryKey Key : Keys)
+		{
+			MoveEntry(ToStorage, Key, EFaerieStorageAddStackBehavior::AddToAnyStack);
+		}
+		return;
+	}
+
+	TArray<Faerie::Inventory::FEventLog> Removals;
+	RemoveBatchImpl(Keys, Faerie::Inventory::Tags::RemovalMoving, Removals);
+
+	TArray<FFaerieItemStack> Stacks;
+	Stacks.Reserve(Removals.Num());
+	for (const Faerie::Inventory::FEventLog& Removal : Removals)
+	{
+		Stacks.Add({const_cast<UFaerieItem*>(Removal.Item.Get()), Removal.Amount});
+	}
+
+	TArray<Faerie::Inventory::FEventLog> Additions;
+	ToStorage->AddBatchImpl(Stacks, false, Additions);
 }
 
 
@@ -205,7 +205,11 @@ int32 FInventoryEntry::MoveStack(const FStackKey From, const FStackKey To, const
 	const int32 StackIndexA = GetStackIndex(From);
 	FKeyedStack& FromStack = Stacks[StackIndexA];
 	FKeyedStack& ToStack = *GetStackPtr(To);
-	const int32 Moving = FMath::Min(FMath::Min(Amount, FromStack.Stack), Limit - ToStack.Stack);
+	int32 Moving = Amount == Faerie::ItemData::UnlimitedStack ? FromStack.Stack : FMath::Min(Amount, FromStack.Stack);
+	if (Limit != Faerie::ItemData::UnlimitedStack)
+	{
+		Moving = FMath::Min(Moving, Limit - ToStack.Stack);
+	}
 	FromStack.Stack -= Moving;
 	ToStack.Stack += Moving;
 	if (FromStack.Stack == 0)
@@ -341,16 +345,40 @@ void FInventoryContent::Insert(const FEntryKey Key, const FInventoryEntry& Entry
 
 void FInventoryContent::Remove(const FEntryKey Key)
 {
+	int32 RemovedID = INDEX_NONE;
+
 	if (BSOA::Remove(Key,
-		[this](const FKeyedInventoryEntry& Entry)
+		[this, &RemovedID](const FKeyedInventoryEntry& Entry)
 		{
 			// Notify owning server of this removal.
 			PreEntryReplicatedRemove(Entry);
+			RemovedID = Entry.ReplicationID;
 		}))
 	{
 		// Notify clients of this removal.
-		MarkArrayDirty();
+		Faerie::Hacks::MarkItemsRemoved(*this, Entries, MakeArrayView(&RemovedID, 1));
+	}
+}
+
+int32 FInventoryContent::RemoveBatch(const TConstArrayView<FEntryKey> SortedKeys)
+{
+	TArray<int32, TInlineAllocator<16>> RemovedIDs;
+
+	const int32 Removed = BSOA::RemoveSorted(SortedKeys,
+		[this, &RemovedIDs](const FKeyedInventoryEntry& Entry)
+		{
+			// Notify owning server of this removal.
+			PreEntryReplicatedRemove(Entry);
+			RemovedIDs.Add(Entry.ReplicationID);
+		});
+
+	if (Removed > 0)
+	{
+		// Notify clients of all removals at once.
+		Faerie::Hacks::MarkItemsRemoved(*this, Entries, RemovedIDs);
 	}
+
+	return Removed;
 }
 
 FInventoryContent::FScopedItemHandle::~FScopedItemHandle()
@@ -4,6 +4,21 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ItemContainerEvent)
 
+namespace Faerie::Inventory
+{
+	uint64 FEventLog::NextEventID()
+	{
+		static std::atomic<uint64> EventIDCounter = 0;
+		return ++EventIDCounter;
+	}
+
+	uint32 FEventLog::ProcessOrigin()
+	{
+		static const uint32 Origin = GetTypeHash(FGuid::NewGuid());
+		return Origin;
+	}
+}
+
 namespace Faerie::Inventory::Tags
 {
 	UE_DEFINE_GAMEPLAY_TAG_TYPED_COMMENT(FFaerieInventoryTag, Addition,
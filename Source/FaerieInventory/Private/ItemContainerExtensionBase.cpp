@@ -23,6 +23,48 @@ void UItemContainerExtensionBase::PostDuplicate(const EDuplicateMode::Type Dupli
 	SetIdentifier();
 }
 
+EEventExtensionResponse UItemContainerExtensionBase::AllowsAdditionBatch(const UFaerieItemContainerBase* Container,
+																	   const TConstArrayView<FFaerieItemStackView> Stacks,
+																	   const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	EEventExtensionResponse Response = EEventExtensionResponse::NoExplicitResponse;
+
+	for (const FFaerieItemStackView Stack : Stacks)
+	{
+		switch (AllowsAddition(Container, Stack, AddStackBehavior))
+		{
+		case EEventExtensionResponse::NoExplicitResponse:
+			break;
+		case EEventExtensionResponse::Allowed:
+			Response = EEventExtensionResponse::Allowed;
+			break;
+		case EEventExtensionResponse::Disallowed:
+			return EEventExtensionResponse::Disallowed;
+		default: ;
+		}
+	}
+
+	return Response;
+}
+
+void UItemContainerExtensionBase::PostAdditionBatch(const UFaerieItemContainerBase* Container,
+													const TConstArrayView<Faerie::Inventory::FEventLog> Events)
+{
+	for (const Faerie::Inventory::FEventLog& Event : Events)
+	{
+		PostAddition(Container, Event);
+	}
+}
+
+void UItemContainerExtensionBase::PostRemovalBatch(const UFaerieItemContainerBase* Container,
+												   const TConstArrayView<Faerie::Inventory::FEventLog> Events)
+{
+	for (const Faerie::Inventory::FEventLog& Event : Events)
+	{
+		PostRemoval(Container, Event);
+	}
+}
+
 void UItemContainerExtensionBase::SetIdentifier(const FGuid* GuidToUse)
 {
 	if (GuidToUse)
@@ -164,6 +206,45 @@ void UItemContainerExtensionGroup::PostAddition(const UFaerieItemContainerBase*
 		});
 }
 
+EEventExtensionResponse UItemContainerExtensionGroup::AllowsAdditionBatch(const UFaerieItemContainerBase* Container,
+																		const TConstArrayView<FFaerieItemStackView> Stacks,
+																		const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	EEventExtensionResponse Response = EEventExtensionResponse::NoExplicitResponse;
+
+	// Check each extension, to see if the batch is allowed or denied.
+	for (auto&& Extension : Extensions)
+	{
+		if (!ensure(IsValid(Extension))) continue;
+
+		switch (Extension->AllowsAdditionBatch(Container, Stacks, AddStackBehavior))
+		{
+		case EEventExtensionResponse::NoExplicitResponse:
+			break;
+		case EEventExtensionResponse::Allowed:
+			// Flag response as allowed, unless another extension bars with a Disallowed
+			Response = EEventExtensionResponse::Allowed;
+			break;
+		case EEventExtensionResponse::Disallowed:
+			// Return false immediately if any Extension bars the batch.
+			return EEventExtensionResponse::Disallowed;
+		default: ;
+		}
+	}
+
+	return Response;
+}
+
+void UItemContainerExtensionGroup::PostAdditionBatch(const UFaerieItemContainerBase* Container,
+													 const TConstArrayView<Faerie::Inventory::FEventLog> Events)
+{
+	ForEachExtension(
+		[Container, Events](UItemContainerExtensionBase* Extension)
+		{
+			Extension->PostAdditionBatch(Container, Events);
+		});
+}
+
 EEventExtensionResponse UItemContainerExtensionGroup::AllowsRemoval(const UFaerieItemContainerBase* Container,
 																	const FEntryKey Key, const FFaerieInventoryTag Reason) const
 {
@@ -211,6 +292,16 @@ void UItemContainerExtensionGroup::PostRemoval(const UFaerieItemContainerBase* C
 		});
 }
 
+void UItemContainerExtensionGroup::PostRemovalBatch(const UFaerieItemContainerBase* Container,
+													const TConstArrayView<Faerie::Inventory::FEventLog> Events)
+{
+	ForEachExtension(
+		[Container, Events](UItemContainerExtensionBase* Extension)
+		{
+			Extension->PostRemovalBatch(Container, Events);
+		});
+}
+
 EEventExtensionResponse UItemContainerExtensionGroup::AllowsEdit(const UFaerieItemContainerBase* Container,
 																 const FEntryKey Key,
 																 const FFaerieInventoryTag EditTag) const
@@ -7,14 +7,21 @@
 #include "FaerieItemStack.h"
 #include "InventoryDataEnums.h"
 #include "InventoryDataStructs.h"
+#include "Engine/TimerHandle.h"
+#include "UObject/ObjectKey.h"
 
 #include "FaerieItemStorage.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogFaerieItemStorage, Log, All);
 
+class UFaerieItemDataComparator;
+class UFaerieItemDataFilter;
+struct FFaerieStorageChangeSet;
+
 namespace Faerie
 {
 	using FEntryKeyEvent = TMulticastDelegate<void(UFaerieItemStorage*, FEntryKey)>;
+	using FStorageChangeSetEvent = TMulticastDelegate<void(UFaerieItemStorage*, const FFaerieStorageChangeSet&)>;
 	using FStorageFilterFunc = TFunctionRef<bool(const FFaerieItemProxy&)>;
 	using FStorageFilter = TDelegate<bool(const FFaerieItemProxy&)>;
 	using FStorageComparator = TDelegate<bool(const FFaerieItemProxy&, const FFaerieItemProxy&)>;
@@ -26,6 +33,19 @@ namespace Faerie
 		FStorageComparator Sort;
 		bool InvertSort = false;
 	};
+
+	// Proxy-free query types. These are given a view of each entry directly, and never cause proxies to be created.
+	using FStorageViewFilterFunc = TFunctionRef<bool(FFaerieItemStackView)>;
+	using FStorageViewFilter = TDelegate<bool(FFaerieItemStackView)>;
+	using FStorageViewComparator = TDelegate<bool(FFaerieItemStackView, FFaerieItemStackView)>;
+
+	struct FStorageViewQuery
+	{
+		FStorageViewFilter Filter;
+		bool InvertFilter = false;
+		FStorageViewComparator Sort;
+		bool InvertSort = false;
+	};
 }
 
 DECLARE_DYNAMIC_DELEGATE_RetVal_OneParam(bool, FBlueprintStorageFilter, const FFaerieItemProxy&, Proxy);
@@ -47,12 +67,45 @@ struct FFaerieItemStorageBlueprintQuery
 
 	UPROPERTY(BlueprintReadWrite, Category = "ItemStorageQuery")
 	bool Reverse = false;
+
+	// Filter rule to run when Filter is not bound. Rules run on entry views, so no proxies need to be created.
+	UPROPERTY(BlueprintReadWrite, Category = "ItemStorageQuery")
+	TObjectPtr<UFaerieItemDataFilter> FilterRule = nullptr;
+
+	// Sort rule to run when Sort is not bound. Rules that support stack views will not require proxies to be created.
+	UPROPERTY(BlueprintReadWrite, Category = "ItemStorageQuery")
+	TObjectPtr<UFaerieItemDataComparator> SortRule = nullptr;
+};
+
+/**
+ * The keys changed in a storage over a batch of notifications. Each key is in at most one list. Keys both added and
+ * removed during the batch are left out entirely, and keys that were added or removed are not also listed as updated.
+ */
+USTRUCT(BlueprintType)
+struct FFaerieStorageChangeSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "StorageChangeSet")
+	TArray<FEntryKey> Added;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StorageChangeSet")
+	TArray<FEntryKey> Updated;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StorageChangeSet")
+	TArray<FEntryKey> Removed;
+
+	bool IsEmpty() const
+	{
+		return Added.IsEmpty() && Updated.IsEmpty() && Removed.IsEmpty();
+	}
 };
 
 class UInventoryEntryProxy;
 class UInventoryStackProxy;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FEntryKeyEvent, UFaerieItemStorage*, Storage, FEntryKey, Key);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FStorageChangeSetEvent, UFaerieItemStorage*, Storage, const FFaerieStorageChangeSet&, Changes);
 
 /**
  *
@@ -105,16 +158,61 @@ private:
 	UInventoryEntryProxy* GetEntryProxyImpl(FEntryKey Key) const;
 	UInventoryStackProxy* GetStackProxyImpl(FInventoryKey Key) const;
 
+	// Remove map slots for proxies that have been garbage collected.
+	void CompactLocalProxies();
+
 	// @todo this copies the entry. Kinda wonky, should be used minimally, if at all.
     void GetEntryImpl(FEntryKey Key, FInventoryEntry& Entry) const;
 
+	// Find an existing entry that an immutable item can be stacked into.
+	FEntryKey FindStackableEntryImpl(const UFaerieItem* Item) const;
+
+	// Stacking index maintenance.
+	void AddToStackingIndex(const FKeyedInventoryEntry& Entry);
+	void RemoveFromStackingIndex(FEntryKey Key);
+	void RebuildStackingIndex();
+
+	// Item index maintenance.
+	void AddToItemIndex(const FKeyedInventoryEntry& Entry);
+	void RemoveFromItemIndex(FEntryKey Key);
+	void RebuildItemIndex();
+
+	// Find the first entry holding exactly this item object.
+	FEntryKey FindItemByPointer(const UFaerieItem* Item) const;
+
+	// Send the change notifications for items that have mutated since the last flush.
+	void FlushMutatedEntries();
+
+	// Key notifications. These are either broadcast immediately, or queued into the pending change set when batching.
+	void BroadcastKeyAdded(FEntryKey Key);
+	void BroadcastKeyUpdated(FEntryKey Key);
+	void BroadcastKeyRemoved(FEntryKey Key);
+
+	// Broadcast the change set to OnKeysChanged.
+	void BroadcastChangeSet(const FFaerieStorageChangeSet& Changes);
+
+	void ScheduleNotificationFlush();
+
+	// Checks that don't depend on extensions, for whether a stack can be added.
+	bool CanAddStackImpl(FFaerieItemStackView Stack) const;
+
 	// Internal implementation for adding items.
 	Faerie::Inventory::FEventLog AddStackImpl(const FFaerieItemStack& InStack, bool ForceNewStack);
 
+	// Adds a stack without notifying extensions of the addition.
+	Faerie::Inventory::FEventLog AddStackImpl_NoNotify(const FFaerieItemStack& InStack, bool ForceNewStack);
+
+	// Internal implementation for adding many stacks. Extensions are notified once, after all stacks are added.
+	void AddBatchImpl(TConstArrayView<FFaerieItemStack> Stacks, bool ForceNewStack, TArray<Faerie::Inventory::FEventLog>& OutEvents);
+
 	// Internal implementations for removing items, specifying an amount.
 	Faerie::Inventory::FEventLog RemoveFromEntryImpl(FEntryKey Key, int32 Amount, FFaerieInventoryTag Reason);
 	Faerie::Inventory::FEventLog RemoveFromStackImpl(FInventoryKey Key, int32 Amount, FFaerieInventoryTag Reason);
 
+	// Internal implementation for removing many entries entirely. Keys must be valid and sorted. Extensions are
+	// notified once, after all entries are removed.
+	void RemoveBatchImpl(TConstArrayView<FEntryKey> SortedKeys, FFaerieInventoryTag Reason, TArray<Faerie::Inventory::FEventLog>& OutEvents);
+
 	// FastArray API; used to replicate array changes clientside
 	void PostContentAdded(const FKeyedInventoryEntry& Entry);
 	void PostContentChanged(const FKeyedInventoryEntry& Entry);
@@ -128,6 +226,18 @@ public:
 	Faerie::FEntryKeyEvent::RegistrationType& GetOnKeyAdded() { return OnKeyAddedCallback; }
 	Faerie::FEntryKeyEvent::RegistrationType& GetOnKeyUpdated() { return OnKeyUpdatedCallback; }
 	Faerie::FEntryKeyEvent::RegistrationType& GetOnKeyRemoved() { return OnKeyRemovedCallback; }
+	Faerie::FStorageChangeSetEvent::RegistrationType& GetOnKeysChanged() { return OnKeysChangedCallback; }
+
+	// Is this storage currently deferring key notifications?
+	bool IsBatchingNotifications() const { return BatchNotificationsPerFrame || NotificationBatchDepth > 0; }
+
+	// Start deferring key notifications until the matching EndNotificationBatch. Prefer Faerie::FScopedStorageNotificationBatch.
+	void BeginNotificationBatch();
+	void EndNotificationBatch();
+
+	// Immediately broadcast any pending key notifications.
+	UFUNCTION(BlueprintCallable, Category = "Storage|Events")
+	void FlushNotifications();
 
 	FInventoryEntryView GetEntryView(FEntryKey Key) const;
 
@@ -200,6 +310,12 @@ public:
 	// Query function to filter and sort for a subsection of contained entries.
 	void QueryAll(const Faerie::FStorageQuery& Query, TArray<FKeyedInventoryEntry>& OutKeys) const;
 
+	// Proxy-free version of QueryFirst. Prefer this when the filter only needs the item and its copies.
+	FKeyedInventoryEntry QueryFirstView(const Faerie::FStorageViewFilterFunc& Filter) const;
+
+	// Proxy-free version of QueryAll. Prefer this when the filter and sort only need the item and its copies.
+	void QueryAllView(const Faerie::FStorageViewQuery& Query, TArray<FKeyedInventoryEntry>& OutKeys) const;
+
 	// Query function to filter for the first matching entry.
 	UFUNCTION(BlueprintCallable, Category = "Storage|Query")
 	FEntryKey QueryFirst(const FBlueprintStorageFilter& Filter) const;
@@ -211,6 +327,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Storage")
 	bool CanAddStack(FFaerieItemStackView Stack, EFaerieStorageAddStackBehavior AddStackBehavior) const;
 
+	// Can all of these stacks be added together?
+	bool CanAddBatch(TConstArrayView<FFaerieItemStackView> Stacks, EFaerieStorageAddStackBehavior AddStackBehavior) const;
+
 	UFUNCTION(BlueprintCallable, Category = "Storage")
 	bool CanEditEntry(FEntryKey Key, FFaerieInventoryTag EditTag) const;
 
@@ -242,6 +361,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Storage", BlueprintAuthorityOnly, DisplayName = "Add Item Stack (with Log)")
 	FLoggedInventoryEvent AddItemStackWithLog(const FFaerieItemStack& ItemStack, EFaerieStorageAddStackBehavior AddStackBehavior);
 
+	/**
+	 * Add many stacks at once. Either every stack is added, or none are.
+	 * Extensions are notified once for the whole batch, so this scales far better than adding stacks one at a time.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Storage", BlueprintAuthorityOnly)
+	bool AddBatch(const TArray<FFaerieItemStack>& Stacks, EFaerieStorageAddStackBehavior AddStackBehavior);
+
 	/**
 	 * Removes the entry with this key if it exists.
 	 * An amount of -1 will remove the entire stack.
@@ -258,6 +384,14 @@ public:
 	bool RemoveStack(FInventoryKey Key,
 		UPARAM(meta = (Categories = "Fae.Inventory.Removal")) FFaerieInventoryTag RemovalTag, int32 Amount = -1);
 
+	/**
+	 * Removes many entries entirely at once. Either every entry is removed, or none are.
+	 * Extensions are notified once for the whole batch, and the content array is compacted once.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Storage", BlueprintAuthorityOnly)
+	bool RemoveBatch(const TArray<FEntryKey>& Keys,
+		UPARAM(meta = (Categories = "Fae.Inventory.Removal")) FFaerieInventoryTag RemovalTag);
+
 	/**
 	 * Removes and returns the entry with this key if it exists.
 	 * An amount of -1 will remove the entire stack.
@@ -309,6 +443,7 @@ protected:
 	Faerie::FEntryKeyEvent OnKeyAddedCallback;
 	Faerie::FEntryKeyEvent OnKeyUpdatedCallback;
 	Faerie::FEntryKeyEvent OnKeyRemovedCallback;
+	Faerie::FStorageChangeSetEvent OnKeysChangedCallback;
 
 	// Broadcast whenever an entry is added, or a stack amount is increased.
 	UPROPERTY(BlueprintCallable, BlueprintAssignable, Transient, Category = "Events")
@@ -322,6 +457,18 @@ protected:
 	UPROPERTY(BlueprintCallable, BlueprintAssignable, Transient, Category = "Events")
 	FEntryKeyEvent OnKeyRemoved;
 
+	// Broadcast with every key that changed, once per batch of notifications, or for each key when not batching.
+	UPROPERTY(BlueprintCallable, BlueprintAssignable, Transient, Category = "Events")
+	FStorageChangeSetEvent OnKeysChanged;
+
+	/**
+	 * If enabled, OnKeyAdded, OnKeyUpdated, and OnKeyRemoved are deferred until the next tick and sent at most once per
+	 * key, followed by OnKeysChanged with the whole change set. Note that removals are then reported after the entry is
+	 * already gone. Proxies and extensions are still notified immediately.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Events")
+	bool BatchNotificationsPerFrame = false;
+
 
 	/**-------------*/
 	/*	 VARIABLES	*/
@@ -335,13 +482,80 @@ private:
 	// being left around. Using weak pointers here is intentional. We don't want this storage to keep these alive. They
 	// should be stored in a strong pointer by whatever requested them, and once nothing needs the proxies, they will die.
 	// Effectively mutable, as these are written to by the const proxy accessors.
-	// @todo how will these maps get cleaned up, to they don't accrue hundreds of stale ptrs?
+	// Slots for proxies that have died are pruned by CompactLocalProxies, once the maps grow past ProxyCompactionThreshold.
 
 	// Locally stored proxies per entry.
 	UPROPERTY(Transient)
 	TMap<FEntryKey, TWeakObjectPtr<UInventoryEntryProxy>> LocalEntryProxies;
 
-	// Locally stored proxies per individual stack.
-	UPROPERTY(Transient)
-	TMap<FInventoryKey, TWeakObjectPtr<UInventoryStackProxy>> LocalStackProxies;
-};
\ No newline at end of file
+	// Locally stored proxies per individual stack, grouped by entry, so that notifying an entry only visits its own
+	// stacks. Entries rarely have more than a few stacks, so each group is searched linearly.
+	using FStackProxyList = TArray<TPair<FStackKey, TWeakObjectPtr<UInventoryStackProxy>>, TInlineAllocator<2>>;
+	TMap<FEntryKey, FStackProxyList> LocalStackProxies;
+
+	// Combined size of the local proxy maps that will trigger the next compaction.
+	int32 ProxyCompactionThreshold = 64;
+
+	// Entries holding data-immutable items, bucketed by UFaerieItem::GetContentHash. Used to find existing stacks to add
+	// to without comparing against every entry. Content hashes are process-local, so this is rebuilt, never serialized.
+	TMultiMap<uint32, FEntryKey> StackingIndex;
+
+	// The content hash each indexed entry was filed under, so it can be removed even if its tokens have since changed.
+	TMap<FEntryKey, uint32> StackingHashes;
+
+	// Entries bucketed by the item object they hold, so pointer lookups don't compare against every entry. A multimap,
+	// as separate entries can share a data-immutable item.
+	TMultiMap<TObjectKey<UFaerieItem>, FEntryKey> ItemIndex;
+
+	// The item object each indexed entry was filed under, so it can be removed even if the entry's item has since been
+	// replaced, as happens when replication remaps it on clients.
+	TMap<FEntryKey, TObjectKey<UFaerieItem>> IndexedItems;
+
+	// Entries whose item has mutated since the last flush. Items are often edited several times in a frame, so change
+	// notifications for them are deferred until the next tick, and sent once per entry.
+	TSet<FEntryKey> MutatedEntries;
+
+	FTimerHandle MutationFlushTimer;
+
+	// Key notifications waiting to be broadcast, while batching. Kept as sets, as batches can touch every entry, and
+	// each change checks the others. They are sorted into a change set when flushed.
+	TSet<FEntryKey> PendingAdded;
+	TSet<FEntryKey> PendingUpdated;
+	TSet<FEntryKey> PendingRemoved;
+
+	// Number of open notification batches.
+	int32 NotificationBatchDepth = 0;
+
+	FTimerHandle NotificationFlushTimer;
+};
+
+namespace Faerie
+{
+	/**
+	 * Defers the key notifications of a storage while in scope. Scopes can be nested, and the change set is broadcast when
+	 * the outermost one ends.
+	 */
+	class FScopedStorageNotificationBatch : FNoncopyable
+	{
+	public:
+		explicit FScopedStorageNotificationBatch(UFaerieItemStorage* Storage)
+		  : Storage(Storage)
+		{
+			if (Storage)
+			{
+				Storage->BeginNotificationBatch();
+			}
+		}
+
+		~FScopedStorageNotificationBatch()
+		{
+			if (Storage.IsValid())
+			{
+				Storage->EndNotificationBatch();
+			}
+		}
+
+	private:
+		TWeakObjectPtr<UFaerieItemStorage> Storage;
+	};
+}
\ No newline at end of file
@@ -372,6 +372,12 @@ public:
 
 	void Remove(FEntryKey Key);
 
+	/**
+	 * Removes many entries in one pass, and replicates the removals together. SortedKeys must be sorted.
+	 * @return The number of entries removed.
+	 */
+	int32 RemoveBatch(TConstArrayView<FEntryKey> SortedKeys);
+
 	bool IsEmpty() const { return Entries.IsEmpty(); }
 
 	int32 Num() const { return Entries.Num(); }
@@ -27,10 +27,18 @@ namespace Faerie::Inventory
 	{
 	public:
 		FEventLog()
-		  : EventID(FGuid::NewGuid()),
+		  : EventID(NextEventID()),
+			Origin(ProcessOrigin()),
 			Timestamp(FDateTime::UtcNow()) {}
 
 	private:
+		// Event IDs are handed out in increasing order, and are unique for the lifetime of the process.
+		static uint64 NextEventID();
+
+		// A random value picked once per process. Event IDs restart in every process, so events from a server and a
+		// client, or from separate sessions, are told apart by their origin.
+		static uint32 ProcessOrigin();
+
 		static FEventLog CreateFailureEvent_Internal(const FFaerieInventoryTag Type, const FString& Message)
 		{
 			FEventLog NewErrorEvent;
@@ -46,12 +54,15 @@ namespace Faerie::Inventory
 			return CreateFailureEvent_Internal(Tags::Addition, Message);
 		}
 
-		const FGuid& GetEventID() const { return EventID; }
+		uint64 GetEventID() const { return EventID; }
+		uint32 GetOrigin() const { return Origin; }
 		const FDateTime& GetTimestamp() const { return Timestamp; }
 
 		friend bool operator==(const FEventLog& Lhs, const FEventLog& Rhs)
 		{
-			return Lhs.EventID == Rhs.EventID;
+			return Lhs.EventID == Rhs.EventID
+				&& Lhs.Origin == Rhs.Origin
+				&& Lhs.Timestamp == Rhs.Timestamp;
 		}
 
 		friend bool operator!=(const FEventLog& Lhs, const FEventLog& Rhs)
@@ -91,11 +102,13 @@ namespace Faerie::Inventory
 					  << Val.Item
 					  << Val.ErrorMessage
 					  << Val.EventID
+					  << Val.Origin
 					  << Val.Timestamp;
 		}
 
 	private:
-		FGuid EventID;
+		uint64 EventID;
+		uint32 Origin;
 		FDateTime Timestamp;
 	};
 }
@@ -61,6 +61,11 @@ protected:
 	/* Allows us to use the key from the last addition */
 	virtual void PostAddition(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) {}
 
+	/* Does this extension allow all of these stacks to be added to the container together? By default, each stack is checked alone. */
+	virtual EEventExtensionResponse AllowsAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<FFaerieItemStackView> Stacks, EFaerieStorageAddStackBehavior AddStackBehavior) const;
+	/* Allows us to react to many additions at once. By default, calls PostAddition for each event. */
+	virtual void PostAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<Faerie::Inventory::FEventLog> Events);
+
 	/* Does this extension allow removal from/of an entry in the container? */
 	virtual EEventExtensionResponse AllowsRemoval(const UFaerieItemContainerBase* Container, FEntryKey Key, FFaerieInventoryTag Reason) const { return EEventExtensionResponse::NoExplicitResponse; }
 
@@ -68,6 +73,8 @@ protected:
 	virtual void PreRemoval(const UFaerieItemContainerBase* Container, FEntryKey Key, int32 Removal) {}
 	/* Allows us to use the key from the last removal */
 	virtual void PostRemoval(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) {}
+	/* Allows us to react to many removals at once. By default, calls PostRemoval for each event. */
+	virtual void PostRemovalBatch(const UFaerieItemContainerBase* Container, TConstArrayView<Faerie::Inventory::FEventLog> Events);
 
 	/* Does this extension allow this entry to be edited? */
 	virtual EEventExtensionResponse AllowsEdit(const UFaerieItemContainerBase* Container, FEntryKey Key, FFaerieInventoryTag EditTag) const { return EEventExtensionResponse::NoExplicitResponse; }
@@ -115,9 +122,12 @@ public:
 	virtual EEventExtensionResponse AllowsAddition(const UFaerieItemContainerBase* Container, FFaerieItemStackView Stack, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
 	virtual void PreAddition(const UFaerieItemContainerBase* Container, FFaerieItemStackView Stack) override;
 	virtual void PostAddition(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
+	virtual EEventExtensionResponse AllowsAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<FFaerieItemStackView> Stacks, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
+	virtual void PostAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<Faerie::Inventory::FEventLog> Events) override;
 	virtual EEventExtensionResponse AllowsRemoval(const UFaerieItemContainerBase* Container, FEntryKey Key, FFaerieInventoryTag Reason) const override;
 	virtual void PreRemoval(const UFaerieItemContainerBase* Container, FEntryKey Key, int32 Removal) override;
 	virtual void PostRemoval(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
+	virtual void PostRemovalBatch(const UFaerieItemContainerBase* Container, TConstArrayView<Faerie::Inventory::FEventLog> Events) override;
 	virtual EEventExtensionResponse AllowsEdit(const UFaerieItemContainerBase* Container, FEntryKey Key, FFaerieInventoryTag EditTag) const override;
 	// @todo PreEntryChanged
 	virtual void PostEntryChanged(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
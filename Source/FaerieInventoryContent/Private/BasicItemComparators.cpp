@@ -8,8 +8,15 @@
 
 bool UFaerieLexicographicNameComparator::Exec(const FFaerieItemProxy A, const FFaerieItemProxy B) const
 {
-	const UFaerieInfoToken* InfoA = A->GetItemObject()->GetToken<UFaerieInfoToken>();
-	const UFaerieInfoToken* InfoB = B->GetItemObject()->GetToken<UFaerieInfoToken>();
+	return ExecView(A, B);
+}
+
+bool UFaerieLexicographicNameComparator::ExecView(const FFaerieItemStackView A, const FFaerieItemStackView B) const
+{
+	if (!A.Item.IsValid() || !B.Item.IsValid()) return false;
+
+	const UFaerieInfoToken* InfoA = A.Item->GetToken<UFaerieInfoToken>();
+	const UFaerieInfoToken* InfoB = B.Item->GetToken<UFaerieInfoToken>();
 
 	if (IsValid(InfoA) && IsValid(InfoB))
 	{
@@ -19,7 +26,37 @@ bool UFaerieLexicographicNameComparator::Exec(const FFaerieItemProxy A, const FF
 	return false;
 }
 
+FFaerieItemSortKey UFaerieLexicographicNameComparator::MakeSortKey(const FFaerieItemStackView View) const
+{
+	// Items without a name sort first.
+	FFaerieItemSortKey Key;
+	if (View.Item.IsValid())
+	{
+		if (const UFaerieInfoToken* Info = View.Item->GetToken<UFaerieInfoToken>())
+		{
+			Key.Text = Info->GetItemName().ToString();
+		}
+	}
+	return Key;
+}
+
 bool UFaerieDateModifiedComparator::Exec(const FFaerieItemProxy A, const FFaerieItemProxy B) const
 {
-	return A->GetItemObject()->GetLastModified() < B->GetItemObject()->GetLastModified();
+	return ExecView(A, B);
+}
+
+bool UFaerieDateModifiedComparator::ExecView(const FFaerieItemStackView A, const FFaerieItemStackView B) const
+{
+	if (!A.Item.IsValid() || !B.Item.IsValid()) return false;
+	return A.Item->GetLastModified() < B.Item->GetLastModified();
+}
+
+FFaerieItemSortKey UFaerieDateModifiedComparator::MakeSortKey(const FFaerieItemStackView View) const
+{
+	FFaerieItemSortKey Key;
+	if (View.Item.IsValid())
+	{
+		Key.Number = View.Item->GetLastModified().GetTicks();
+	}
+	return Key;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 ﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "BasicItemDataFilters.h"
+#include "FaerieItemDataFilterProgram.h"
 #include "Tokens/FaerieStackLimiterToken.h"
 #include "Tokens/FaerieTagToken.h"
 
@@ -8,6 +9,11 @@
 
 #define LOCTEXT_NAMESPACE "BasicItemDataFilters"
 
+void UFilterRule_Literal::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	Compiler.EmitConstant(true);
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_LogicalOr::GetMutabilityStatus() const
 {
@@ -54,6 +60,11 @@ bool UFilterRule_LogicalOr::Exec(const FFaerieItemStackView View) const
 	return false;
 }
 
+void UFilterRule_LogicalOr::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	Compiler.EmitAny(Rules);
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_LogicalAnd::GetMutabilityStatus() const
 {
@@ -101,6 +112,11 @@ bool UFilterRule_LogicalAnd::Exec(const FFaerieItemStackView View) const
 	return true;
 }
 
+void UFilterRule_LogicalAnd::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	Compiler.EmitAll(Rules);
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_Condition::GetMutabilityStatus() const
 {
@@ -120,6 +136,19 @@ bool UFilterRule_Condition::Exec(const FFaerieItemStackView View) const
 	return FalseBranch;
 }
 
+void UFilterRule_Condition::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	if (!ConditionRule)
+	{
+		Compiler.EmitConstant(false);
+		return;
+	}
+
+	Compiler.EmitSelect(ConditionRule,
+		[this](Faerie::ItemData::FFilterCompiler& Branch) { Branch.Emit(TrueBranch); },
+		[this](Faerie::ItemData::FFilterCompiler& Branch) { Branch.EmitConstant(FalseBranch); });
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_Ternary::GetMutabilityStatus() const
 {
@@ -140,6 +169,19 @@ bool UFilterRule_Ternary::Exec(const FFaerieItemStackView View) const
 	return FalseBranch->Exec(View);
 }
 
+void UFilterRule_Ternary::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	if (!ConditionRule)
+	{
+		Compiler.EmitConstant(false);
+		return;
+	}
+
+	Compiler.EmitSelect(ConditionRule,
+		[this](Faerie::ItemData::FFilterCompiler& Branch) { Branch.Emit(TrueBranch); },
+		[this](Faerie::ItemData::FFilterCompiler& Branch) { Branch.Emit(FalseBranch); });
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_LogicalNot::GetMutabilityStatus() const
 {
@@ -156,6 +198,11 @@ bool UFilterRule_LogicalNot::Exec(const FFaerieItemStackView View) const
 	return !InvertedRule->Exec(View);
 }
 
+void UFilterRule_LogicalNot::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	Compiler.EmitNot(InvertedRule);
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_Mutability::GetMutabilityStatus() const
 {
@@ -168,6 +215,11 @@ bool UFilterRule_Mutability::Exec(const FFaerieItemStackView View) const
 	return View.Item->IsDataMutable() == RequireMutable;
 }
 
+void UFilterRule_Mutability::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	Compiler.EmitMutabilityTest(RequireMutable);
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_MatchTemplate::GetMutabilityStatus() const
 {
@@ -198,6 +250,17 @@ bool UFilterRule_MatchTemplate::Exec(const FFaerieItemStackView View) const
 	return false;
 }
 
+void UFilterRule_MatchTemplate::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	// Inline the template's pattern, so it's compiled along with the rest of the tree.
+	if (IsValid(Template))
+	{
+		Compiler.Emit(Template->GetPattern());
+		return;
+	}
+	Compiler.EmitConstant(false);
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_HasTokens::GetMutabilityStatus() const
 {
@@ -262,6 +325,40 @@ bool UFilterRule_HasTokens::Exec(const FFaerieItemStackView View) const
 	return TokenClassesCopy.IsEmpty();
 }
 
+void UFilterRule_HasTokens::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	TArray<TSubclassOf<UFaerieItemToken>> Classes;
+	for (auto&& TokenClass : TokenClasses)
+	{
+		// Tokens can't be looked up by these, so leave them to Exec.
+		if (!IsValid(TokenClass) || TokenClass == UFaerieItemToken::StaticClass())
+		{
+			Compiler.EmitRuleCall(this);
+			return;
+		}
+		Classes.AddUnique(TokenClass);
+	}
+
+	if (Classes.IsEmpty())
+	{
+		Compiler.EmitConstant(true);
+		return;
+	}
+
+	Compiler.EmitPredicate(
+		[Classes = MoveTemp(Classes)](Faerie::ItemData::FFilterContext& Context)
+		{
+			for (auto&& Class : Classes)
+			{
+				if (!Context.FindToken(Class))
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_Copies::GetMutabilityStatus() const
 {
@@ -281,19 +378,33 @@ EItemDataMutabilityStatus UFilterRule_Copies::GetMutabilityStatus() const
 }
 #endif
 
-bool UFilterRule_Copies::Exec(const FFaerieItemStackView View) const
+static bool CompareCopies(const ECopiesCompareOperator Operator, const int32 Copies, const int32 AmountToCompare)
 {
 	switch (Operator) {
-	case ECopiesCompareOperator::Less:				return View.Copies < AmountToCompare;
-	case ECopiesCompareOperator::LessOrEqual:		return View.Copies <= AmountToCompare;
-	case ECopiesCompareOperator::Greater:			return View.Copies > AmountToCompare;
-	case ECopiesCompareOperator::GreaterOrEqual:	return View.Copies >= AmountToCompare;
-	case ECopiesCompareOperator::Equal:				return View.Copies == AmountToCompare;
-	case ECopiesCompareOperator::NotEqual:			return View.Copies != AmountToCompare;
+	case ECopiesCompareOperator::Less:				return Copies < AmountToCompare;
+	case ECopiesCompareOperator::LessOrEqual:		return Copies <= AmountToCompare;
+	case ECopiesCompareOperator::Greater:			return Copies > AmountToCompare;
+	case ECopiesCompareOperator::GreaterOrEqual:	return Copies >= AmountToCompare;
+	case ECopiesCompareOperator::Equal:				return Copies == AmountToCompare;
+	case ECopiesCompareOperator::NotEqual:			return Copies != AmountToCompare;
 	default: return false;
 	}
 }
 
+bool UFilterRule_Copies::Exec(const FFaerieItemStackView View) const
+{
+	return CompareCopies(Operator, View.Copies, AmountToCompare);
+}
+
+void UFilterRule_Copies::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	Compiler.EmitPredicate(
+		[Operator = Operator, AmountToCompare = AmountToCompare](const Faerie::ItemData::FFilterContext& Context)
+		{
+			return CompareCopies(Operator, Context.View.Copies, AmountToCompare);
+		});
+}
+
 #if WITH_EDITOR
 EItemDataMutabilityStatus UFilterRule_StackLimit::GetMutabilityStatus() const
 {
@@ -357,6 +468,26 @@ bool UFilterRule_GameplayTagAny::Exec(const FFaerieItemStackView View) const
 	return false;
 }
 
+void UFilterRule_GameplayTagAny::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	if (Tags.IsEmpty())
+	{
+		// Nothing can match any of no tags.
+		Compiler.EmitConstant(false);
+		return;
+	}
+
+	Compiler.EmitPredicate(
+		[Tags = Tags](Faerie::ItemData::FFilterContext& Context)
+		{
+			if (const UFaerieTagToken* TagToken = Context.FindToken<UFaerieTagToken>())
+			{
+				return TagToken->GetTags().HasAny(Tags);
+			}
+			return false;
+		});
+}
+
 bool UFilterRule_GameplayTagAll::Exec(const FFaerieItemStackView View) const
 {
 	if (const UFaerieTagToken* TagToken = View.Item->GetToken<UFaerieTagToken>())
@@ -366,4 +497,17 @@ bool UFilterRule_GameplayTagAll::Exec(const FFaerieItemStackView View) const
 	return false;
 }
 
+void UFilterRule_GameplayTagAll::Compile(Faerie::ItemData::FFilterCompiler& Compiler) const
+{
+	Compiler.EmitPredicate(
+		[Tags = Tags](Faerie::ItemData::FFilterContext& Context)
+		{
+			if (const UFaerieTagToken* TagToken = Context.FindToken<UFaerieTagToken>())
+			{
+				return TagToken->GetTags().HasAll(Tags);
+			}
+			return false;
+		});
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -99,7 +99,7 @@ uint32 UFISHI_Tokens::Hash(const FFaerieItemStackView StackView) const
 
 	for (auto&& TokenClass : TokenClasses)
 	{
-		const TArray<const UFaerieItemToken*> Tokens = StackView.Item->GetTokens(TokenClass);
+		const TConstArrayView<const UFaerieItemToken*> Tokens = StackView.Item->GetTokensView(TokenClass);
 
 		if (Tokens.IsEmpty())
 		{
@@ -63,17 +63,17 @@ void UInventoryCapacityExtension::DeinitializeExtension(const UFaerieItemContain
 {
 	if (!ensure(IsValid(Container))) return;
 
-	if (!ServerCapacityCache.Contains(Container)) return;
+	Faerie::Capacity::FContainerCapacityCache Cache;
+	if (!ServerCapacityCache.RemoveAndCopyValue(Container, Cache)) return;
 
-	for (auto&& Cache = ServerCapacityCache[Container];
-		auto&& Element : Cache)
+	// Remove the existing cache by adding its inverse
+	AddWeightAndVolume(-Cache.Sum);
+
+	for (const Faerie::Capacity::FKeyedEntryCapacity& Element : Cache.Entries)
 	{
-		// Remove the existing cache by adding its inverse
-		AddWeightAndVolume(-Element.Value);
+		ReleaseKnownItem(Element.Value.Item);
 	}
 
-	ServerCapacityCache.Remove(Container);
-
 	HandleStateChanged();
 }
 
@@ -103,29 +103,106 @@ void UInventoryCapacityExtension::PostRemoval(const UFaerieItemContainerBase* Co
 	HandleStateChanged();
 }
 
+EEventExtensionResponse UInventoryCapacityExtension::AllowsAdditionBatch(const UFaerieItemContainerBase* Container,
+																		const TConstArrayView<FFaerieItemStackView> Stacks,
+																		const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	int32 BatchWeight = 0;
+	int64 BatchVolume = 0;
+
+	for (const FFaerieItemStackView Stack : Stacks)
+	{
+		if (!Stack.Item.IsValid())
+		{
+			return EEventExtensionResponse::Disallowed;
+		}
+
+		const Faerie::Capacity::FUnitCapacity Unit = GetUnitCapacity(Stack.Item.Get());
+		if (!CanContainUnit(Unit, Stack.Copies))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PreAddition: Cannot add Stack (Item: '%s' Copies: %i)"),
+				*Stack.Item->GetName(), Stack.Copies);
+			return EEventExtensionResponse::Disallowed;
+		}
+
+		if (Unit.HasToken)
+		{
+			BatchWeight += Unit.Capacity.GetWeightOfStack(Stack.Copies);
+			BatchVolume += Unit.Capacity.GetVolumeOfStack(Stack.Copies);
+		}
+	}
+
+	// Each stack fits alone, but the batch must also fit as a whole.
+	if (Config.HasCheck(ECapacityChecks::Weight) &&
+		State.CurrentWeight + BatchWeight > Config.MaxWeight)
+	{
+		return EEventExtensionResponse::Disallowed;
+	}
+
+	if (Config.HasCheck(ECapacityChecks::Volume) &&
+		State.CurrentVolume + BatchVolume > Config.MaxVolume)
+	{
+		return EEventExtensionResponse::Disallowed;
+	}
+
+	return EEventExtensionResponse::Allowed;
+}
+
+void UInventoryCapacityExtension::PostAdditionBatch(const UFaerieItemContainerBase* Container,
+													const TConstArrayView<Faerie::Inventory::FEventLog> Events)
+{
+	for (const Faerie::Inventory::FEventLog& Event : Events)
+	{
+		UpdateCacheForEntry(Container, Event.EntryTouched);
+	}
+	HandleStateChanged();
+}
+
+void UInventoryCapacityExtension::PostRemovalBatch(const UFaerieItemContainerBase* Container,
+												   const TConstArrayView<Faerie::Inventory::FEventLog> Events)
+{
+	for (const Faerie::Inventory::FEventLog& Event : Events)
+	{
+		UpdateCacheForEntry(Container, Event.EntryTouched);
+	}
+	HandleStateChanged();
+}
+
 void UInventoryCapacityExtension::PostEntryChanged(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event)
 {
 	UpdateCacheForEntry(Container, Event.EntryTouched);
 	HandleStateChanged();
 }
 
-FWeightAndVolume UInventoryCapacityExtension::GetEntryWeightAndVolume(const UFaerieItemContainerBase* Container, const FEntryKey Key)
+Faerie::Capacity::FUnitCapacity UInventoryCapacityExtension::MakeUnitCapacity(const UFaerieItem* Item)
 {
-	FWeightAndVolume Out;
+	Faerie::Capacity::FUnitCapacity Out;
 
-	const FFaerieItemStackView View = Container->View(Key);
-	if (!View.Item.IsValid())
+	if (!IsValid(Item))
 	{
 		return Out;
 	}
 
-	auto&& Token = View.Item->GetToken<UFaerieCapacityToken>();
-	if (!IsValid(Token))
+	if (auto&& Token = Item->GetToken<UFaerieCapacityToken>())
+	{
+		Out.Capacity = Token->GetCapacity();
+		Out.HasToken = true;
+	}
+
+	return Out;
+}
+
+FWeightAndVolume UInventoryCapacityExtension::GetEntryWeightAndVolume(const UFaerieItemContainerBase* Container, const FEntryKey Key,
+																	  const FFaerieItemStackView View, const Faerie::Capacity::FUnitCapacity& Unit)
+{
+	FWeightAndVolume Out;
+
+	if (!Unit.HasToken)
 	{
 		return Out;
 	}
 
-	Out.GramWeight = Token->GetWeightOfStack(View.Copies);
+	Out.GramWeight = Unit.Capacity.GetWeightOfStack(View.Copies);
 
 	if (auto&& AsStorage = Cast<UFaerieItemStorage>(Container))
 	{
@@ -140,46 +217,102 @@ FWeightAndVolume UInventoryCapacityExtension::GetEntryWeightAndVolume(const UFae
 		for (const FInventoryEntry& Entry = EntryView.Get();
 			auto&& KeyedStack : Entry.Stacks)
 		{
-			Out.Volume += Token->GetVolumeOfStack(KeyedStack.Stack);
+			Out.Volume += Unit.Capacity.GetVolumeOfStack(KeyedStack.Stack);
 		}
 	}
 	else
 	{
 		// Other container types (like EquipmentSlot) fallback to the default logic
-		Out.Volume += Token->GetVolumeOfStack(View.Copies);
+		Out.Volume += Unit.Capacity.GetVolumeOfStack(View.Copies);
 	}
 
 	return Out;
 }
 
+Faerie::Capacity::FUnitCapacity UInventoryCapacityExtension::GetUnitCapacity(const UFaerieItem* Item) const
+{
+	if (auto&& Known = KnownItemCapacities.Find(Item))
+	{
+		return Known->Key;
+	}
+	return MakeUnitCapacity(Item);
+}
+
+void UInventoryCapacityExtension::AcquireKnownItem(const UFaerieItem* Item, const Faerie::Capacity::FUnitCapacity& Unit)
+{
+	// The tokens of mutable items can be edited, so their capacity cannot be shared between lookups.
+	if (!IsValid(Item) || Item->IsDataMutable())
+	{
+		return;
+	}
+
+	auto&& Known = KnownItemCapacities.FindOrAdd(Item, MakeTuple(Unit, 0));
+	Known.Value++;
+}
+
+void UInventoryCapacityExtension::ReleaseKnownItem(const TObjectKey<UFaerieItem> Item)
+{
+	if (auto&& Known = KnownItemCapacities.Find(Item))
+	{
+		if (--Known->Value <= 0)
+		{
+			KnownItemCapacities.Remove(Item);
+		}
+	}
+}
+
 void UInventoryCapacityExtension::UpdateCacheForEntry(const UFaerieItemContainerBase* Container, const FEntryKey Key)
 {
 	if (!ensure(IsValid(Container))) return;
 
 	auto&& ContainerCache = ServerCapacityCache.FindOrAdd(Container);
-	auto&& PrevCache = ContainerCache.Find(Key);
+	int32 Index = ContainerCache.IndexOf(Key);
 
 	if (!Container->IsValidKey(Key))
 	{
-		if (PrevCache)
+		if (Index != INDEX_NONE)
 		{
 			// Remove the existing cache by adding its inverse
-			AddWeightAndVolume(-*PrevCache);
-			ContainerCache.Remove(Key);
+			const Faerie::Capacity::FEntryCapacity& PrevCache = ContainerCache.Entries[Index].Value;
+			AddWeightAndVolume(-PrevCache.Total);
+			ContainerCache.Sum -= PrevCache.Total;
+			ReleaseKnownItem(PrevCache.Item);
+			ContainerCache.Entries.RemoveAt(Index);
 		}
 		return;
 	}
 
-	auto&& Total = GetEntryWeightAndVolume(Container, Key);
+	const FFaerieItemStackView View = Container->View(Key);
+	const UFaerieItem* Item = View.Item.Get();
 
-	FWeightAndVolume Diff = Total;
+	if (Index == INDEX_NONE)
+	{
+		// Keys are generated in increasing order, so this is nearly always an append.
+		Index = Algo::UpperBoundBy(ContainerCache.Entries, Key, &Faerie::Capacity::FKeyedEntryCapacity::Key);
+		ContainerCache.Entries.InsertDefaulted(Index);
+		ContainerCache.Entries[Index].Key = Key;
+	}
 
-	if (PrevCache)
+	Faerie::Capacity::FEntryCapacity& Cache = ContainerCache.Entries[Index].Value;
+
+	if (Cache.Item != TObjectKey<UFaerieItem>(Item))
+	{
+		ReleaseKnownItem(Cache.Item);
+		Cache.Item = Item;
+		Cache.Unit = GetUnitCapacity(Item);
+		AcquireKnownItem(Item, Cache.Unit);
+	}
+	else if (IsValid(Item) && Item->IsDataMutable())
 	{
-		Diff -= *PrevCache;
+		// Tokens may have been edited since this was last updated.
+		Cache.Unit = MakeUnitCapacity(Item);
 	}
 
-	ContainerCache.Add(Key, Total);
+	const FWeightAndVolume Total = GetEntryWeightAndVolume(Container, Key, View, Cache.Unit);
+	const FWeightAndVolume Diff = Total - Cache.Total;
+
+	Cache.Total = Total;
+	ContainerCache.Sum += Diff;
 	AddWeightAndVolume(Diff);
 }
 
@@ -200,10 +333,10 @@ void UInventoryCapacityExtension::CheckCapacityLimit()
 	}
 }
 
-bool UInventoryCapacityExtension::CanContainToken(const UFaerieCapacityToken* Token, const int32 Stack) const
+bool UInventoryCapacityExtension::CanContainUnit(const Faerie::Capacity::FUnitCapacity& Unit, const int32 Stack) const
 {
 	// If the token is invalid, return true if we don't require tokens.
-	if (!IsValid(Token))
+	if (!Unit.HasToken)
 	{
 		return !Config.HasCheck(ECapacityChecks::Token);
 	}
@@ -214,7 +347,7 @@ bool UInventoryCapacityExtension::CanContainToken(const UFaerieCapacityToken* To
 	{
 		// Convert Bounds to a FVector so we can multiply by a float, then convert back
 		const FIntVector TestBounds = FIntVector(FVector(Config.Bounds) * Config.BoundsFudgeFactor);
-		const FIntVector BoundsDiff = Token->GetCapacity().Bounds - TestBounds;
+		const FIntVector BoundsDiff = Unit.Capacity.Bounds - TestBounds;
 
 		// If the largest bound exceeds the limits, forbid containment.
 		if (BoundsDiff.GetMax() > 0)
@@ -226,7 +359,7 @@ bool UInventoryCapacityExtension::CanContainToken(const UFaerieCapacityToken* To
 	// Determine if the entry would put the container over max weight.
 	if (Config.HasCheck(ECapacityChecks::Weight))
 	{
-		const int32 TestWeight = State.CurrentWeight + Token->GetWeightOfStack(Stack);
+		const int32 TestWeight = State.CurrentWeight + Unit.Capacity.GetWeightOfStack(Stack);
 		const bool WouldExceedWeight = TestWeight > Config.MaxWeight;
 
 		if (WouldExceedWeight)
@@ -238,7 +371,7 @@ bool UInventoryCapacityExtension::CanContainToken(const UFaerieCapacityToken* To
 	// Determine if the entry would put the container over max volume.
 	if (Config.HasCheck(ECapacityChecks::Volume))
 	{
-		const int64 TestVolume = State.CurrentVolume + Token->GetVolumeOfStack(Stack);
+		const int64 TestVolume = State.CurrentVolume + Unit.Capacity.GetVolumeOfStack(Stack);
 		const bool WouldExceedVolume = TestVolume > Config.MaxVolume;
 
 		if (WouldExceedVolume)
@@ -273,7 +406,7 @@ bool UInventoryCapacityExtension::CanContain(const FFaerieItemStackView Stack) c
 		return false;
 	}
 
-	return CanContainToken(Stack.Item->GetToken<UFaerieCapacityToken>(), Stack.Copies);
+	return CanContainUnit(GetUnitCapacity(Stack.Item.Get()), Stack.Copies);
 }
 
 bool UInventoryCapacityExtension::CanContainProxy(const FFaerieItemProxy Proxy) const
@@ -297,7 +430,7 @@ bool UInventoryCapacityExtension::CanContainProxy(const FFaerieItemProxy Proxy)
 		return false;
 	}
 
-	return CanContainToken(ItemObject->GetToken<UFaerieCapacityToken>(), Stack);
+	return CanContainUnit(GetUnitCapacity(ItemObject), Stack);
 }
 
 FWeightAndVolume UInventoryCapacityExtension::GetCurrentCapacity() const
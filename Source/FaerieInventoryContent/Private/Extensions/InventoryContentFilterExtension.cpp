@@ -2,6 +2,7 @@
 
 #include "Extensions/InventoryContentFilterExtension.h"
 #include "FaerieItemDataFilter.h"
+#include "FaerieItemDataFilterProgram.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryContentFilterExtension)
 
@@ -19,5 +20,28 @@ EEventExtensionResponse UInventoryContentFilterExtension::AllowsAddition(const U
 		return EEventExtensionResponse::Disallowed;
 	}
 
+	return EEventExtensionResponse::NoExplicitResponse;
+}
+
+EEventExtensionResponse UInventoryContentFilterExtension::AllowsAdditionBatch(const UFaerieItemContainerBase*,
+                                                                              const TConstArrayView<FFaerieItemStackView> Stacks,
+                                                                              EFaerieStorageAddStackBehavior) const
+{
+	if (Stacks.IsEmpty())
+	{
+		return EEventExtensionResponse::NoExplicitResponse;
+	}
+
+	if (ensure(IsValid(Filter)))
+	{
+		// Compile the filter once for the whole batch, instead of walking the rule tree for each stack.
+		if (Faerie::ItemData::FFilterProgram::Compile(Filter).ExecAll(Stacks))
+		{
+			return EEventExtensionResponse::Allowed;
+		}
+
+		return EEventExtensionResponse::Disallowed;
+	}
+
 	return EEventExtensionResponse::NoExplicitResponse;
 }
\ No newline at end of file
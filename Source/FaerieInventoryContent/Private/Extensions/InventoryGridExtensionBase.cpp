@@ -3,6 +3,8 @@
 #include "Extensions/InventoryGridExtensionBase.h"
 #include "FaerieItemContainerBase.h"
 #include "FaerieItemStorage.h"
+#include "GameFramework/Actor.h"
+#include "Tokens/FaerieStackLimiterToken.h"
 #include "Net/UnrealNetwork.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryGridExtensionBase)
@@ -38,7 +40,7 @@ void UInventoryGridExtensionBase::InitializeExtension(const UFaerieItemContainer
 	// This is also skipping possible serialization of grid data.
 	// @todo handle serialization loading
 	// @todo handle items that are too large to fit / too many items (log error?)
-	OccupiedCells.SetNum(GridSize.X * GridSize.Y, false);
+	UnmarkAllCells();
 	if (const UFaerieItemStorage* ItemStorage = Cast<UFaerieItemStorage>(Container))
 	{
 		ItemStorage->ForEachKey(
@@ -65,6 +67,7 @@ void UInventoryGridExtensionBase::DeinitializeExtension(const UFaerieItemContain
 	// Remove all entries for this container on shutdown
 	// @todo its only okay to reset these because we don't suppose multi-container! revisit later
 	OccupiedCells.Reset();
+	CellOwners.Reset();
 	GridContent.Items.Reset();
 	InitializedContainer = nullptr;
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, InitializedContainer, this);
@@ -84,40 +87,131 @@ FIntPoint UInventoryGridExtensionBase::Unravel(const int32 Index) const
 
 bool UInventoryGridExtensionBase::IsCellOccupied(const FIntPoint& Point) const
 {
-	const int32 Index = Ravel(Point);
-	if (!OccupiedCells.IsValidIndex(Index))
+	// If cell doesn't exist, it cannot be occupied
+	return OccupiedCells.Get(Point);
+}
+
+void UInventoryGridExtensionBase::ResizeCells()
+{
+	const FIntPoint OldSize = OccupiedCells.GetSize();
+	if (OldSize == GridSize)
+	{
+		return;
+	}
+
+	TArray<FInventoryKey> OldOwners = MoveTemp(CellOwners);
+
+	// Resize to new dimensions, copying over existing data that's still in bounds
+	OccupiedCells.Resize(GridSize);
+	CellOwners.SetNum(GridSize.X * GridSize.Y);
+
+	if (!OldOwners.IsEmpty())
 	{
-		// If cell doesn't exist, it cannot be occupied
-		return false;
+		for (int32 y = 0; y < FMath::Min(OldSize.Y, GridSize.Y); y++)
+		{
+			for (int32 x = 0; x < FMath::Min(OldSize.X, GridSize.X); x++)
+			{
+				CellOwners[x + y * GridSize.X] = OldOwners[x + y * OldSize.X];
+			}
+		}
 	}
-	return OccupiedCells[Index];
 }
 
-void UInventoryGridExtensionBase::MarkCell(const FIntPoint& Point)
+void UInventoryGridExtensionBase::MarkCell(const FIntPoint& Point, const FInventoryKey& Owner)
 {
-	const int32 Index = Ravel(Point);
-	if (!OccupiedCells.IsValidIndex(Index))
+	// Clients don't initialize cells, so they are sized on first use.
+	ResizeCells();
+
+	if (!OccupiedCells.IsValidCell(Point))
 	{
-		// If cell doesn't exist, expand to fit.
-		OccupiedCells.SetNum(Index, false);
+		// If cell doesn't exist, it cannot be marked.
+		return;
 	}
-	OccupiedCells[Index] = true;
+	OccupiedCells.Set(Point, true);
+	CellOwners[Ravel(Point)] = Owner;
 }
 
 void UInventoryGridExtensionBase::UnmarkCell(const FIntPoint& Point)
 {
-	const int32 Index = Ravel(Point);
-	if (!OccupiedCells.IsValidIndex(Index))
+	if (!OccupiedCells.IsValidCell(Point))
 	{
 		// If cell doesn't exist, no need to unmark it.
 		return;
 	}
-	OccupiedCells[Index] = false;
+	OccupiedCells.Set(Point, false);
+	CellOwners[Ravel(Point)] = FInventoryKey();
 }
 
 void UInventoryGridExtensionBase::UnmarkAllCells()
 {
-	OccupiedCells.Init(false, GridSize.X * GridSize.Y);
+	OccupiedCells.Init(GridSize);
+	CellOwners.Reset();
+	CellOwners.SetNum(GridSize.X * GridSize.Y);
+}
+
+void UInventoryGridExtensionBase::UnmarkCellsOwnedBy(const FInventoryKey& Owner)
+{
+	for (int32 Index = 0; Index < CellOwners.Num(); ++Index)
+	{
+		if (CellOwners[Index] == Owner)
+		{
+			OccupiedCells.Set(Unravel(Index), false);
+			CellOwners[Index] = FInventoryKey();
+		}
+	}
+}
+
+FInventoryKey UInventoryGridExtensionBase::GetCellOwner(const FIntPoint& Point) const
+{
+	if (!OccupiedCells.IsValidCell(Point))
+	{
+		return FInventoryKey();
+	}
+	return CellOwners[Ravel(Point)];
+}
+
+int32 UInventoryGridExtensionBase::CountNewStacks(const FFaerieItemStackView Stack, const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	if (!Stack.Item.IsValid())
+	{
+		return 0;
+	}
+
+	const int32 Limit = UFaerieStackLimiterToken::GetItemStackLimit(Stack.Item.Get());
+	int32 Copies = Stack.Copies;
+
+	// Copies are added to the stacks of a matching entry first, and only overflow into new stacks. Mutable items never
+	// stack, so they always make new stacks.
+	if (AddStackBehavior == EFaerieStorageAddStackBehavior::AddToAnyStack &&
+		!Stack.Item->IsDataMutable())
+	{
+		if (const UFaerieItemStorage* Storage = Cast<UFaerieItemStorage>(InitializedContainer))
+		{
+			if (const FEntryKey Existing = Storage->FindItem(Stack.Item.Get(), EFaerieItemEqualsCheck::UseCompareWith);
+				Existing.IsValid())
+			{
+				if (Limit == Faerie::ItemData::UnlimitedStack)
+				{
+					return 0;
+				}
+
+				const int32 Room = Storage->GetInvKeysForEntry(Existing).Num() * Limit - Storage->GetStack(Existing);
+				Copies -= FMath::Max(0, Room);
+			}
+		}
+	}
+
+	if (Copies <= 0)
+	{
+		return 0;
+	}
+
+	if (Limit == Faerie::ItemData::UnlimitedStack)
+	{
+		return 1;
+	}
+
+	return FMath::DivideAndRoundUp(Copies, Limit);
 }
 
 void UInventoryGridExtensionBase::BroadcastEvent(const FInventoryKey& Key, const EFaerieGridEventType EventType)
@@ -126,8 +220,15 @@ void UInventoryGridExtensionBase::BroadcastEvent(const FInventoryKey& Key, const
 	SpatialStackChangedDelegate.Broadcast(Key, EventType);
 }
 
+bool UInventoryGridExtensionBase::IsClient() const
+{
+	const AActor* Actor = GetTypedOuter<AActor>();
+	return IsValid(Actor) && Actor->GetNetMode() == NM_Client;
+}
+
 void UInventoryGridExtensionBase::OnRep_GridSize()
 {
+	ResizeCells();
 	GridSizeChangedNative.Broadcast(GridSize);
 	GridSizeChangedDelegate.Broadcast(GridSize);
 }
@@ -156,23 +257,8 @@ void UInventoryGridExtensionBase::SetGridSize(const FIntPoint& NewGridSize)
 {
 	if (GridSize != NewGridSize)
 	{
-		const FIntPoint OldSize = GridSize;
-		TBitArray<> OldOccupied = OccupiedCells;
-
-		// Resize to new dimensions
 		GridSize = NewGridSize;
-		OccupiedCells.Init(false, GridSize.X * GridSize.Y);
-
-		// Copy over existing data that's still in bounds
-		for (int32 y = 0; y < FMath::Min(OldSize.Y, GridSize.Y); y++)
-		{
-			for (int32 x = 0; x < FMath::Min(OldSize.X, GridSize.X); x++)
-			{
-				const int32 OldIndex = x + y * OldSize.X;
-				const int32 NewIndex = x + y * GridSize.X;
-				OccupiedCells[NewIndex] = OldOccupied[OldIndex];
-			}
-		}
+		ResizeCells();
 
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, GridSize, this);
 
@@ -1,12 +1,40 @@
 ﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "Extensions/InventoryLoggerExtension.h"
+#include "FaerieItem.h"
 #include "FaerieItemContainerBase.h"
 
 #include "Net/UnrealNetwork.h"
+#include "Serialization/MemoryWriter.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryLoggerExtension)
 
+void FInventoryLoggerEntry::PostReplicatedAdd(const FInventoryLoggerEventArray& InArraySerializer)
+{
+	InArraySerializer.PostEntryReplicated(*this);
+}
+
+void FInventoryLoggerEntry::PostReplicatedChange(const FInventoryLoggerEventArray& InArraySerializer)
+{
+	InArraySerializer.PostEntryReplicated(*this);
+}
+
+void FInventoryLoggerEventArray::PostEntryReplicated(const FInventoryLoggerEntry& Entry) const
+{
+	if (ChangeListener.IsValid())
+	{
+		ChangeListener->HandleReplicatedEvent(Entry);
+	}
+}
+
+void UInventoryLoggerExtension::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Bind replication functions out into this class.
+	EventLog.ChangeListener = this;
+}
+
 void UInventoryLoggerExtension::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -34,36 +62,91 @@ void UInventoryLoggerExtension::PostEntryChanged(const UFaerieItemContainerBase*
 
 void UInventoryLoggerExtension::HandleNewEvent(const FLoggedInventoryEvent& Event)
 {
+	const int64 Sequence = NextSequence++;
+
+	// Events are written to slots in order, wrapping around to the oldest once the log is full.
+	const int32 Slot = static_cast<int32>(Sequence % FMath::Max(Capacity, 1));
+
+	FInventoryLoggerEntry* Entry;
+	if (EventLog.Items.IsValidIndex(Slot))
+	{
+		Entry = &EventLog.Items[Slot];
+		if (SpillEvictedEvents)
+		{
+			SpillEvent(*Entry);
+		}
+	}
+	else
+	{
+		Entry = &EventLog.Items.AddDefaulted_GetRef();
+	}
+
+	Entry->Sequence = Sequence;
+	Entry->Event = Event;
+
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, EventLog, this);
-	EventLog.Add(Event);
+	EventLog.MarkItemDirty(*Entry);
+
 	OnInventoryEventLoggedNative.Broadcast(Event);
 	OnInventoryEventLogged.Broadcast(Event);
 }
 
-TArray<FLoggedInventoryEvent> UInventoryLoggerExtension::GetRecentEvents(const int32 NumEvents) const
+void UInventoryLoggerExtension::HandleReplicatedEvent(const FInventoryLoggerEntry& Entry)
 {
-	if (NumEvents >= EventLog.Num())
-	{
-		return EventLog;
-	}
+	OnInventoryEventLogged.Broadcast(Entry.Event);
+}
 
-	TArray<FLoggedInventoryEvent> OutEvents;
-	for (int32 i = EventLog.Num() - NumEvents; i < EventLog.Num(); ++i)
+void UInventoryLoggerExtension::SpillEvent(const FInventoryLoggerEntry& Entry)
+{
+	const Faerie::Inventory::FEventLog& Event = Entry.Event.Event;
+
+	int64 Sequence = Entry.Sequence;
+	int64 Ticks = Event.GetTimestamp().GetTicks();
+	FName Type = Event.Type.GetTagName();
+	bool Success = Event.Success;
+	FEntryKey EntryTouched = Event.EntryTouched;
+	TArray<FStackKey> StackKeys = Event.StackKeys;
+	int32 Amount = Event.Amount;
+	FName ItemName = Event.Item.IsValid() ? Event.Item->GetFName() : NAME_None;
+
+	FMemoryWriter Writer(SpillStream);
+	Writer.Seek(SpillStream.Num());
+	Writer << Sequence << Ticks << Type << Success << EntryTouched << StackKeys << Amount << ItemName;
+}
+
+TArray<uint8> UInventoryLoggerExtension::ConsumeSpilledEvents()
+{
+	return MoveTemp(SpillStream);
+}
+
+TArray<const FInventoryLoggerEntry*> UInventoryLoggerExtension::GetEntriesInOrder() const
+{
+	TArray<const FInventoryLoggerEntry*> Entries;
+	Entries.Reserve(EventLog.Items.Num());
+	for (const FInventoryLoggerEntry& Entry : EventLog.Items)
 	{
-		OutEvents.Add(EventLog[i]);
+		Entries.Add(&Entry);
 	}
-	return OutEvents;
+
+	// Clients receive slots in whatever order they were replicated, so always sort by sequence.
+	Algo::SortBy(Entries, &FInventoryLoggerEntry::Sequence);
+	return Entries;
 }
 
-void UInventoryLoggerExtension::OnRep_EventLog()
+TArray<FLoggedInventoryEvent> UInventoryLoggerExtension::GetAllEvents() const
 {
-	// When the EventLog is replicated to clients, we need to check how many events behind we are.
-	const int32 BehindCount = EventLog.Num() - LocalEventLogCount;
-	LocalEventLogCount = EventLog.Num();
+	return GetRecentEvents(EventLog.Items.Num());
+}
 
-	for (auto&& RecentLogs = TConstArrayView<FLoggedInventoryEvent>(EventLog).Right(BehindCount);
-		auto&& RecentLog : RecentLogs)
+TArray<FLoggedInventoryEvent> UInventoryLoggerExtension::GetRecentEvents(const int32 NumEvents) const
+{
+	const TArray<const FInventoryLoggerEntry*> Entries = GetEntriesInOrder();
+
+	TArray<FLoggedInventoryEvent> OutEvents;
+	OutEvents.Reserve(FMath::Clamp(NumEvents, 0, Entries.Num()));
+	for (int32 i = FMath::Max(Entries.Num() - NumEvents, 0); i < Entries.Num(); ++i)
 	{
-		OnInventoryEventLogged.Broadcast(RecentLog);
+		OutEvents.Add(Entries[i]->Event);
 	}
-}
\ No newline at end of file
+	return OutEvents;
+}
@@ -21,6 +21,29 @@ EEventExtensionResponse UInventorySimpleGridExtension::AllowsAddition(const UFae
 	return EEventExtensionResponse::Allowed;
 }
 
+EEventExtensionResponse UInventorySimpleGridExtension::AllowsAdditionBatch(const UFaerieItemContainerBase* Container,
+																			const TConstArrayView<FFaerieItemStackView> Stacks,
+																			const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	// Every stack takes a single cell, so the batch fits if there is a free cell for each new stack it makes.
+	int32 NeededCells = 0;
+	for (const FFaerieItemStackView Stack : Stacks)
+	{
+		if (!Stack.Item.IsValid())
+		{
+			return EEventExtensionResponse::Disallowed;
+		}
+		NeededCells += CountNewStacks(Stack, AddStackBehavior);
+	}
+
+	if (NeededCells > GridSize.X * GridSize.Y - GridContent.Num())
+	{
+		return EEventExtensionResponse::Disallowed;
+	}
+
+	return EEventExtensionResponse::Allowed;
+}
+
 void UInventorySimpleGridExtension::PostAddition(const UFaerieItemContainerBase* Container,
 												  const Faerie::Inventory::FEventLog& Event)
 {
@@ -101,7 +124,6 @@ void UInventorySimpleGridExtension::PostEntryChanged(const UFaerieItemContainerB
 		RemoveItem(KeyToRemove, Container->View(KeyToRemove.EntryKey).Item.Get());
 		BroadcastEvent(KeyToRemove, EFaerieGridEventType::ItemRemoved);
 	}
-	GridContent.MarkArrayDirty();
 }
 
 
@@ -121,11 +143,24 @@ void UInventorySimpleGridExtension::PreStackRemove_Server(const FFaerieGridKeyed
 
 void UInventorySimpleGridExtension::PostStackAdd(const FFaerieGridKeyedStack& Stack)
 {
+	// The server marks cells itself when inserting. Clients have to mark cells for replicated stacks.
+	if (IsClient())
+	{
+		UnmarkCellsOwnedBy(Stack.Key);
+		MarkCell(Stack.Value.Origin, Stack.Key);
+	}
+
 	BroadcastEvent(Stack.Key, EFaerieGridEventType::ItemAdded);
 }
 
 void UInventorySimpleGridExtension::PostStackChange(const FFaerieGridKeyedStack& Stack)
 {
+	if (IsClient())
+	{
+		UnmarkCellsOwnedBy(Stack.Key);
+		MarkCell(Stack.Value.Origin, Stack.Key);
+	}
+
 	if (const UFaerieItemStorage* Storage = Cast<UFaerieItemStorage>(InitializedContainer); Storage->IsValidKey(Stack.Key))
 	{
 		BroadcastEvent(Stack.Key, EFaerieGridEventType::ItemChanged);
@@ -134,14 +169,7 @@ void UInventorySimpleGridExtension::PostStackChange(const FFaerieGridKeyedStack&
 
 FInventoryKey UInventorySimpleGridExtension::GetKeyAt(const FIntPoint& Position) const
 {
-	for (auto&& Element : GridContent)
-	{
-		if (Element.Value.Origin == Position)
-		{
-			return Element.Key;
-		}
-	}
-	return FInventoryKey();
+	return GetCellOwner(Position);
 }
 
 bool UInventorySimpleGridExtension::CanAddAtLocation(const FFaerieItemStackView Stack, const FIntPoint IntPoint) const
@@ -169,13 +197,13 @@ bool UInventorySimpleGridExtension::AddItemToGrid(const FInventoryKey& Key, cons
 	}
 
 	GridContent.Insert(Key, DesiredItemPlacement);
-	MarkCell(DesiredItemPlacement.Origin);
+	MarkCell(DesiredItemPlacement.Origin, Key);
 	return true;
 }
 
 bool UInventorySimpleGridExtension::MoveItem(const FInventoryKey& Key, const FIntPoint& TargetPoint)
 {
-	if (const FInventoryKey OverlappingKey = FindOverlappingItem(Key);
+	if (const FInventoryKey OverlappingKey = FindOverlappingItem(TargetPoint, Key);
 		OverlappingKey.IsValid())
 	{
 		// If the Entry keys are identical, it gives us some other things to test before Swapping.
@@ -197,12 +225,12 @@ bool UInventorySimpleGridExtension::MoveItem(const FInventoryKey& Key, const FIn
 
 		const FFaerieGridContent::FScopedStackHandle HandleA = GridContent.GetHandle(Key);
 		const FFaerieGridContent::FScopedStackHandle HandleB = GridContent.GetHandle(OverlappingKey);
-		SwapItems(HandleA.Get(), HandleB.Get());
+		SwapItems(Key, HandleA.Get(), OverlappingKey, HandleB.Get());
 		return true;
 	}
 
 	const FFaerieGridContent::FScopedStackHandle Handle = GridContent.GetHandle(Key);
-	MoveSingleItem(Handle.Get(), TargetPoint);
+	MoveSingleItem(Key, Handle.Get(), TargetPoint);
 	return true;
 }
 
@@ -215,7 +243,7 @@ bool UInventorySimpleGridExtension::RotateItem(const FInventoryKey& Key)
 
 void UInventorySimpleGridExtension::RemoveItem(const FInventoryKey& Key, const UFaerieItem* Item)
 {
-	GridContent.BSOA::Remove(Key,
+	GridContent.Remove(Key,
 		[Item, this](const FFaerieGridKeyedStack& Stack)
 		{
 			PreStackRemove_Server(Stack, Item);
@@ -229,7 +257,6 @@ void UInventorySimpleGridExtension::RemoveItemBatch(const TConstArrayView<FInven
 		RemoveItem(KeyToRemove, Item);
 		BroadcastEvent(KeyToRemove, EFaerieGridEventType::ItemRemoved);
 	}
-	GridContent.MarkArrayDirty();
 }
 
 bool UInventorySimpleGridExtension::CanAddItemToGrid() const
@@ -265,28 +292,33 @@ FFaerieGridPlacement UInventorySimpleGridExtension::FindFirstEmptyLocation() con
 	return FFaerieGridPlacement{FIntPoint::NoneValue};
 }
 
-FInventoryKey UInventorySimpleGridExtension::FindOverlappingItem(const FInventoryKey& ExcludeKey) const
+FInventoryKey UInventorySimpleGridExtension::FindOverlappingItem(const FIntPoint& Position, const FInventoryKey& ExcludeKey) const
 {
-	if (GridContent.Contains(ExcludeKey))
+	if (const FInventoryKey Owner = GetCellOwner(Position);
+		Owner != ExcludeKey)
 	{
-		return GridContent.GetElement(ExcludeKey).Key;
+		return Owner;
 	}
 	return FInventoryKey();
 }
 
-void UInventorySimpleGridExtension::SwapItems(FFaerieGridPlacement& PlacementA, FFaerieGridPlacement& PlacementB)
+void UInventorySimpleGridExtension::SwapItems(const FInventoryKey KeyA, FFaerieGridPlacement& PlacementA,
+											  const FInventoryKey KeyB, FFaerieGridPlacement& PlacementB)
 {
 	Swap(PlacementA.Origin, PlacementB.Origin);
-	// No need to change cell marking, because swaps don't change any.
+
+	// Both cells stay occupied, but their owners trade places.
+	MarkCell(PlacementA.Origin, KeyA);
+	MarkCell(PlacementB.Origin, KeyB);
 }
 
-void UInventorySimpleGridExtension::MoveSingleItem(FFaerieGridPlacement& Placement, const FIntPoint& NewPosition)
+void UInventorySimpleGridExtension::MoveSingleItem(const FInventoryKey Key, FFaerieGridPlacement& Placement, const FIntPoint& NewPosition)
 {
 	// Clear old position first
 	UnmarkCell(Placement.Origin);
 
 	// Then set new positions
-	MarkCell(NewPosition);
+	MarkCell(NewPosition, Key);
 
 	Placement.Origin = NewPosition;
 }
\ No newline at end of file
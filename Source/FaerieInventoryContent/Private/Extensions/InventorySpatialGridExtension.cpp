@@ -6,18 +6,59 @@
 #include "FaerieItemStorage.h"
 #include "ItemContainerEvent.h"
 #include "Tokens/FaerieShapeToken.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(InventorySpatialGridExtension)
 
 DECLARE_STATS_GROUP(TEXT("InventorySpatialGridExtension"), STATGROUP_FaerieSpatialGrid, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("Client OccupiedCells rebuild"), STAT_Client_CellRebuild, STATGROUP_FaerieSpatialGrid);
+DECLARE_CYCLE_STAT(TEXT("Find first empty location"), STAT_Grid_FindFirstEmpty, STATGROUP_FaerieSpatialGrid);
+DECLARE_CYCLE_STAT(TEXT("Move item"), STAT_Grid_MoveItem, STATGROUP_FaerieSpatialGrid);
+DECLARE_CYCLE_STAT(TEXT("Rotate item"), STAT_Grid_RotateItem, STATGROUP_FaerieSpatialGrid);
+DECLARE_CYCLE_STAT(TEXT("Auto arrange"), STAT_Grid_AutoArrange, STATGROUP_FaerieSpatialGrid);
+
+CSV_DEFINE_CATEGORY(FaerieSpatialGrid, true);
+
+namespace Faerie::Grid
+{
+	// Find the first cell, scanning rows from Start, where a rotation of Shape fits on Board, and occupy it.
+	static bool PlaceFirstFit(FGridBitboard& Board, const FCompiledGridShape& Shape, const FIntPoint Start, FFaerieGridPlacement& OutPlacement)
+	{
+		const FIntPoint Size = Board.GetSize();
+		const uint8 NumRotations = Shape.bSymmetrical ? 1 : static_cast<uint8>(ESpatialItemRotation::MAX);
+
+		for (FIntPoint TestPoint = Start; TestPoint.Y < Size.Y; TestPoint = FIntPoint(0, TestPoint.Y + 1))
+		{
+			for (; TestPoint.X < Size.X; ++TestPoint.X)
+			{
+				if (Board.Get(TestPoint))
+				{
+					continue;
+				}
+
+				for (uint8 Rotation = 0; Rotation < NumRotations; ++Rotation)
+				{
+					// Each rotation has its own first point, so align that one with the free cell.
+					if (const FIntPoint Origin = TestPoint - Shape.Masks[Rotation].FirstPoint;
+						Board.Fits(Shape.Masks[Rotation], Origin))
+					{
+						Board.Occupy(Shape.Masks[Rotation], Origin);
+						OutPlacement = FFaerieGridPlacement(Origin, static_cast<ESpatialItemRotation>(Rotation));
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+}
 
 EEventExtensionResponse UInventorySpatialGridExtension::AllowsAddition(const UFaerieItemContainerBase* Container,
 																	   const FFaerieItemStackView Stack,
 																	   EFaerieStorageAddStackBehavior) const
 {
 	// @todo add boolean in config to allow items without a shape
-	if (!CanAddItemToGrid(GetItemShape_Impl(Stack.Item.Get())))
+	if (!CanAddItemToGrid(Stack.Item.Get()))
 	{
 		return EEventExtensionResponse::Disallowed;
 	}
@@ -25,6 +66,51 @@ EEventExtensionResponse UInventorySpatialGridExtension::AllowsAddition(const UFa
 	return EEventExtensionResponse::Allowed;
 }
 
+EEventExtensionResponse UInventorySpatialGridExtension::AllowsAdditionBatch(const UFaerieItemContainerBase* Container,
+																			 const TConstArrayView<FFaerieItemStackView> Stacks,
+																			 const EFaerieStorageAddStackBehavior AddStackBehavior) const
+{
+	// Stacks that each fit alone may not fit together, so place them one after another on a scratch copy of the
+	// occupied cells, the same way PostAddition will.
+	Faerie::FGridBitboard Scratch = GetOccupiedCells();
+
+	for (const FFaerieItemStackView Stack : Stacks)
+	{
+		if (!Stack.Item.IsValid())
+		{
+			return EEventExtensionResponse::Disallowed;
+		}
+
+		const int32 NewStacks = CountNewStacks(Stack, AddStackBehavior);
+		if (NewStacks == 0)
+		{
+			continue;
+		}
+
+		const Faerie::FCompiledGridShape& Shape = GetCompiledShape_Impl(Stack.Item.Get());
+		if (!Shape.IsValid())
+		{
+			// Shapes that cannot be compiled into masks can only be checked against the current grid.
+			if (!CanAddItemToGrid(Stack.Item.Get()))
+			{
+				return EEventExtensionResponse::Disallowed;
+			}
+			continue;
+		}
+
+		for (int32 i = 0; i < NewStacks; ++i)
+		{
+			if (FFaerieGridPlacement Placement;
+				!Faerie::Grid::PlaceFirstFit(Scratch, Shape, FIntPoint::ZeroValue, Placement))
+			{
+				return EEventExtensionResponse::Disallowed;
+			}
+		}
+	}
+
+	return EEventExtensionResponse::Allowed;
+}
+
 void UInventorySpatialGridExtension::PostAddition(const UFaerieItemContainerBase* Container,
 												const Faerie::Inventory::FEventLog& Event)
 {
@@ -69,7 +155,7 @@ EEventExtensionResponse UInventorySpatialGridExtension::AllowsEdit(const UFaerie
 {
 	if (EditType == Faerie::Inventory::Tags::Split)
 	{
-		if (!CanAddItemToGrid(GetItemShape_Impl(Container->View(Key).Item.Get())))
+		if (!CanAddItemToGrid(Container->View(Key).Item.Get()))
 		{
 			return EEventExtensionResponse::Disallowed;
 		}
@@ -111,7 +197,8 @@ void UInventorySpatialGridExtension::PostEntryChanged(const UFaerieItemContainer
 
 void UInventorySpatialGridExtension::PreStackRemove_Client(const FFaerieGridKeyedStack& Stack)
 {
-	RebuildOccupiedCells();
+	// The item's shape is likely lost by now, but the cells it owned are still recorded.
+	UnmarkCellsOwnedBy(Stack.Key);
 
 	BroadcastEvent(Stack.Key, EFaerieGridEventType::ItemRemoved);
 }
@@ -127,11 +214,22 @@ void UInventorySpatialGridExtension::PreStackRemove_Server(const FFaerieGridKeye
 
 void UInventorySpatialGridExtension::PostStackAdd(const FFaerieGridKeyedStack& Stack)
 {
+	// The server marks cells itself when inserting. Clients have to mark cells for replicated stacks.
+	if (IsClient())
+	{
+		UpdateReplicatedStackCells(Stack);
+	}
+
 	BroadcastEvent(Stack.Key, EFaerieGridEventType::ItemAdded);
 }
 
 void UInventorySpatialGridExtension::PostStackChange(const FFaerieGridKeyedStack& Stack)
 {
+	if (IsClient())
+	{
+		UpdateReplicatedStackCells(Stack);
+	}
+
 	if (const UFaerieItemStorage* Storage = Cast<UFaerieItemStorage>(InitializedContainer);
 		Storage->IsValidKey(Stack.Key))
 	{
@@ -141,20 +239,7 @@ void UInventorySpatialGridExtension::PostStackChange(const FFaerieGridKeyedStack
 
 FInventoryKey UInventorySpatialGridExtension::GetKeyAt(const FIntPoint& Position) const
 {
-	for (auto&& Element : GridContent)
-	{
-		// Easy check first
-		if (Element.Value.Origin == Position) return Element.Key;
-
-		FFaerieGridShape Shape = GetItemShape(Element.Key.EntryKey);
-		ApplyPlacementInline(Shape, Element.Value);
-		if (Shape.Contains(Position))
-		{
-			return Element.Key;
-		}
-	}
-
-	return FInventoryKey();
+	return GetCellOwner(Position);
 }
 
 bool UInventorySpatialGridExtension::CanAddAtLocation(const FFaerieItemStackView Stack, const FIntPoint IntPoint) const
@@ -175,9 +260,7 @@ bool UInventorySpatialGridExtension::AddItemToGrid(const FInventoryKey& Key, con
 		return true;
 	}
 
-	FFaerieGridShape Shape = GetItemShape_Impl(Item);
-
-	const FFaerieGridPlacement DesiredItemPlacement = FindFirstEmptyLocation(Shape);
+	const FFaerieGridPlacement DesiredItemPlacement = FindFirstEmptyLocation(Item);
 
 	if (DesiredItemPlacement.Origin == FIntPoint::NoneValue)
 	{
@@ -186,14 +269,18 @@ bool UInventorySpatialGridExtension::AddItemToGrid(const FInventoryKey& Key, con
 
 	GridContent.Insert(Key, DesiredItemPlacement);
 
+	FFaerieGridShape Shape = GetItemShape_Impl(Item);
 	ApplyPlacementInline(Shape, DesiredItemPlacement);
-	AddItemPosition(Shape);
+	AddItemPosition(Key, Shape);
 
 	return true;
 }
 
 bool UInventorySpatialGridExtension::MoveItem(const FInventoryKey& Key, const FIntPoint& TargetPoint)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Grid_MoveItem);
+	CSV_SCOPED_TIMING_STAT(FaerieSpatialGrid, MoveItem);
+
 	const FFaerieGridShape ItemShape = GetItemShape(Key.EntryKey);
 
 	// Create placement at target point with current rotation
@@ -244,7 +331,7 @@ bool UInventorySpatialGridExtension::MoveItem(const FInventoryKey& Key, const FI
 		const FFaerieGridShape OldShape = ApplyPlacement(ItemShape, StackHandle.Get(), true);
 		RemoveItemPosition(OldShape);
 		StackHandle->Origin = TargetPoint;
-		AddItemPosition(NewShape);
+		AddItemPosition(Key, NewShape);
 	}
 
 	return true;
@@ -252,6 +339,9 @@ bool UInventorySpatialGridExtension::MoveItem(const FInventoryKey& Key, const FI
 
 bool UInventorySpatialGridExtension::RotateItem(const FInventoryKey& Key)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Grid_RotateItem);
+	CSV_SCOPED_TIMING_STAT(FaerieSpatialGrid, RotateItem);
+
 	const FFaerieGridShape ItemShape = GetItemShape(Key.EntryKey);
 
 	// No Point in Trying to Rotate
@@ -284,14 +374,119 @@ bool UInventorySpatialGridExtension::RotateItem(const FInventoryKey& Key)
 		Handle->Origin = NewBounds.Min;
 	}
 	// Set new occupied cells taking into account rotation
-	AddItemPosition(NewShape);
+	AddItemPosition(Key, NewShape);
+
+	return true;
+}
+
+bool UInventorySpatialGridExtension::AutoArrange(const float TimeBudgetMs)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Grid_AutoArrange);
+	CSV_SCOPED_TIMING_STAT(FaerieSpatialGrid, AutoArrange);
+
+	if (!IsValid(InitializedContainer) ||
+		GridSize.X <= 0 || GridSize.Y <= 0)
+	{
+		return false;
+	}
+
+	const double Deadline = TimeBudgetMs > 0.f ? FPlatformTime::Seconds() + TimeBudgetMs / 1000.0 : TNumericLimits<double>::Max();
+
+	struct FArrangedStack
+	{
+		FInventoryKey Key;
+		const UFaerieItem* Item;
+		const Faerie::FCompiledGridShape* Shape;
+		int32 Area;
+		int32 LongestSide;
+		FFaerieGridPlacement OldPlacement;
+		FFaerieGridPlacement NewPlacement;
+	};
+
+	TArray<FArrangedStack> Stacks;
+	for (const FFaerieGridKeyedStack& Stack : GridContent)
+	{
+		const UFaerieItem* Item = InitializedContainer->View(Stack.Key.EntryKey).Item.Get();
+		const Faerie::FCompiledGridShape& Shape = GetCompiledShape_Impl(Item);
+		if (!Shape.IsValid())
+		{
+			// Shapes that cannot be compiled into masks cannot be packed.
+			return false;
+		}
+
+		const Faerie::FGridShapeMask& Mask = Shape.GetMask(ESpatialItemRotation::None);
+		int32 Area = 0;
+		for (const uint64 Row : Mask.Rows)
+		{
+			Area += FMath::CountBits(Row);
+		}
+
+		Stacks.Add({Stack.Key, Item, &Shape, Area, FMath::Max(Mask.Size.X, Mask.Size.Y), Stack.Value, Stack.Value});
+	}
+
+	// Large shapes are the hardest to fit, so place them first while the grid is still open. Ties are broken by key, so
+	// the same contents always arrange the same way.
+	Algo::Sort(Stacks,
+		[](const FArrangedStack& A, const FArrangedStack& B)
+		{
+			if (A.Area != B.Area) return A.Area > B.Area;
+			if (A.LongestSide != B.LongestSide) return A.LongestSide > B.LongestSide;
+			return A.Key < B.Key;
+		});
+
+	// Pack onto a scratch board, so that nothing is touched until we know every stack fits.
+	Faerie::FGridBitboard Board;
+	Board.Init(GridSize);
+
+	// Every cell before this one is occupied, so scans can start here.
+	FIntPoint FirstFree = FIntPoint::ZeroValue;
+
+	for (FArrangedStack& Stack : Stacks)
+	{
+		if (FPlatformTime::Seconds() > Deadline)
+		{
+			return false;
+		}
+
+		if (!Faerie::Grid::PlaceFirstFit(Board, *Stack.Shape, FirstFree, Stack.NewPlacement))
+		{
+			return false;
+		}
+
+		while (FirstFree.Y < GridSize.Y && Board.Get(FirstFree))
+		{
+			if (++FirstFree.X == GridSize.X)
+			{
+				FirstFree = FIntPoint(0, FirstFree.Y + 1);
+			}
+		}
+	}
+
+	// Mark cells for the whole layout before changing placements, so listeners only ever see the final grid.
+	UnmarkAllCells();
+	for (const FArrangedStack& Stack : Stacks)
+	{
+		AddItemPosition(Stack.Key, ApplyPlacement(GetItemShape_Impl(Stack.Item), Stack.NewPlacement));
+	}
+
+	// Only stacks that actually moved are marked dirty. These all replicate together in the next update.
+	for (const FArrangedStack& Stack : Stacks)
+	{
+		if (Stack.NewPlacement == Stack.OldPlacement)
+		{
+			continue;
+		}
+
+		const FFaerieGridContent::FScopedStackHandle Handle = GridContent.GetHandle(Stack.Key);
+		Handle.Get() = Stack.NewPlacement;
+	}
 
 	return true;
 }
 
 void UInventorySpatialGridExtension::RemoveItem(const FInventoryKey& Key, const UFaerieItem* Item)
 {
-	GridContent.BSOA::Remove(Key,
+	GridContent.Remove(Key,
 		[Item, this](const FFaerieGridKeyedStack& Stack)
 		{
 			PreStackRemove_Server(Stack, Item);
@@ -305,7 +500,6 @@ void UInventorySpatialGridExtension::RemoveItemBatch(const TConstArrayView<FInve
 		RemoveItem(KeyToRemove, Item);
 		BroadcastEvent(KeyToRemove, EFaerieGridEventType::ItemRemoved);
 	}
-	GridContent.MarkArrayDirty();
 }
 
 void UInventorySpatialGridExtension::RebuildOccupiedCells()
@@ -324,11 +518,29 @@ void UInventorySpatialGridExtension::RebuildOccupiedCells()
 		if (auto&& Item = InitializedContainer->View(SpatialEntry.Key.EntryKey).Item.Get())
 		{
 			const FFaerieGridShape Translated = ApplyPlacement(GetItemShape_Impl(Item), SpatialEntry.Value);
-			AddItemPosition(Translated);
+			AddItemPosition(SpatialEntry.Key, Translated);
 		}
 	}
 }
 
+void UInventorySpatialGridExtension::UpdateReplicatedStackCells(const FFaerieGridKeyedStack& Stack)
+{
+	// The previous placement isn't known on the client, so clear whatever this stack owned before.
+	UnmarkCellsOwnedBy(Stack.Key);
+
+	if (!IsValid(InitializedContainer) ||
+		!InitializedContainer->IsValidKey(Stack.Key.EntryKey))
+	{
+		return;
+	}
+
+	if (auto&& Item = InitializedContainer->View(Stack.Key.EntryKey).Item.Get())
+	{
+		const FFaerieGridShape Translated = ApplyPlacement(GetItemShape_Impl(Item), Stack.Value);
+		AddItemPosition(Stack.Key, Translated);
+	}
+}
+
 FFaerieGridShape UInventorySpatialGridExtension::GetItemShape_Impl(const UFaerieItem* Item) const
 {
 	if (IsValid(Item))
@@ -342,12 +554,32 @@ FFaerieGridShape UInventorySpatialGridExtension::GetItemShape_Impl(const UFaerie
 	return FFaerieGridShape();
 }
 
+const Faerie::FCompiledGridShape& UInventorySpatialGridExtension::GetCompiledShape_Impl(const UFaerieItem* Item) const
+{
+	if (IsValid(Item))
+	{
+		if (const UFaerieShapeToken* ShapeToken = Item->GetToken<UFaerieShapeToken>())
+		{
+			return ShapeToken->GetCompiledShape();
+		}
+		return Faerie::FCompiledGridShape::SingleCell();
+	}
+	static const Faerie::FCompiledGridShape Empty;
+	return Empty;
+}
+
 bool UInventorySpatialGridExtension::CanAddItemToGrid(const FFaerieGridShapeConstView& Shape) const
 {
 	const FFaerieGridPlacement TestPlacement = FindFirstEmptyLocation(Shape);
 	return TestPlacement.Origin != FIntPoint::NoneValue;
 }
 
+bool UInventorySpatialGridExtension::CanAddItemToGrid(const UFaerieItem* Item) const
+{
+	const FFaerieGridPlacement TestPlacement = FindFirstEmptyLocation(Item);
+	return TestPlacement.Origin != FIntPoint::NoneValue;
+}
+
 FFaerieGridShape UInventorySpatialGridExtension::GetItemShape(const FEntryKey Key) const
 {
 	if (IsValid(InitializedContainer))
@@ -436,6 +668,77 @@ UInventorySpatialGridExtension::FExclusionSet UInventorySpatialGridExtension::Ma
 
 FFaerieGridPlacement UInventorySpatialGridExtension::FindFirstEmptyLocation(const FFaerieGridShapeConstView& Shape) const
 {
+	// Compiling costs a few allocations up front, but none per tested cell.
+	if (const Faerie::FCompiledGridShape Compiled(Shape);
+		Compiled.IsValid())
+	{
+		return FindFirstEmptyLocation(Compiled);
+	}
+	return FindFirstEmptyLocation_Points(Shape);
+}
+
+FFaerieGridPlacement UInventorySpatialGridExtension::FindFirstEmptyLocation(const UFaerieItem* Item) const
+{
+	if (const Faerie::FCompiledGridShape& Compiled = GetCompiledShape_Impl(Item);
+		Compiled.IsValid())
+	{
+		return FindFirstEmptyLocation(Compiled);
+	}
+	return FindFirstEmptyLocation_Points(GetItemShape_Impl(Item));
+}
+
+FFaerieGridPlacement UInventorySpatialGridExtension::FindFirstEmptyLocation(const Faerie::FCompiledGridShape& Shape) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Grid_FindFirstEmpty);
+	CSV_SCOPED_TIMING_STAT(FaerieSpatialGrid, FindFirstEmptyLocation);
+
+	// Early exit if grid is empty or invalid
+	if (GridSize.X <= 0 || GridSize.Y <= 0)
+	{
+		return FFaerieGridPlacement{FIntPoint::NoneValue};
+	}
+
+	// Symmetrical shapes only need to check the default rotation
+	const uint8 NumRotations = Shape.bSymmetrical ? 1 : static_cast<uint8>(ESpatialItemRotation::MAX);
+
+	const Faerie::FGridBitboard& Cells = GetOccupiedCells();
+
+	FFaerieGridPlacement TestPlacement;
+
+	// For each cell in the grid
+	FIntPoint TestPoint = FIntPoint::ZeroValue;
+	for (TestPoint.Y = 0; TestPoint.Y < GridSize.Y; TestPoint.Y++)
+	{
+		for (TestPoint.X = 0; TestPoint.X < GridSize.X; TestPoint.X++)
+		{
+			// Skip if current cell is occupied
+			if (Cells.Get(TestPoint))
+			{
+				continue;
+			}
+
+			for (uint8 Rotation = 0; Rotation < NumRotations; ++Rotation)
+			{
+				// Calculate the origin offset by the first point of this rotation
+				TestPlacement.Origin = TestPoint - Shape.Masks[Rotation].FirstPoint;
+
+				if (Cells.Fits(Shape.Masks[Rotation], TestPlacement.Origin))
+				{
+					TestPlacement.Rotation = static_cast<ESpatialItemRotation>(Rotation);
+					return TestPlacement;
+				}
+			}
+		}
+	}
+	// No valid placement found
+	return FFaerieGridPlacement{FIntPoint::NoneValue};
+}
+
+FFaerieGridPlacement UInventorySpatialGridExtension::FindFirstEmptyLocation_Points(const FFaerieGridShapeConstView& Shape) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Grid_FindFirstEmpty);
+	CSV_SCOPED_TIMING_STAT(FaerieSpatialGrid, FindFirstEmptyLocation);
+
 	// Early exit if grid is empty or invalid
 	if (GridSize.X <= 0 || GridSize.Y <= 0)
 	{
@@ -456,13 +759,17 @@ FFaerieGridPlacement UInventorySpatialGridExtension::FindFirstEmptyLocation(cons
 		}
 	}
 
-	// Find top left most point
-	FIntPoint FirstPoint = FIntPoint(TNumericLimits<int32>::Max());
-	for (const FIntPoint& Point : Shape.Points)
+	// Find top left most point of each rotation
+	TArray<FIntPoint, TInlineAllocator<4>> FirstPoints;
+	for (const ESpatialItemRotation Rotation : RotationRange)
 	{
-		if (Point.Y < FirstPoint.Y || (Point.Y == FirstPoint.Y && Point.X < FirstPoint.X))
+		FIntPoint& FirstPoint = FirstPoints.Add_GetRef(FIntPoint(TNumericLimits<int32>::Max()));
+		for (const FIntPoint& Point : ApplyPlacement(Shape, FFaerieGridPlacement(FIntPoint::ZeroValue, Rotation)).Points)
 		{
-			FirstPoint = Point;
+			if (Point.Y < FirstPoint.Y || (Point.Y == FirstPoint.Y && Point.X < FirstPoint.X))
+			{
+				FirstPoint = Point;
+			}
 		}
 	}
 
@@ -480,13 +787,12 @@ FFaerieGridPlacement UInventorySpatialGridExtension::FindFirstEmptyLocation(cons
 				continue;
 			}
 
-			// Calculate the origin offset by the first point
-			TestPlacement.Origin = TestPoint - FirstPoint;
-
-			for (const ESpatialItemRotation Rotation : RotationRange)
+			for (int32 i = 0; i < RotationRange.Num(); ++i)
 			{
-				TestPlacement.Rotation = Rotation;
-				const FFaerieGridShape Translated = ApplyPlacement(Shape, TestPlacement); // @todo this is *way* too many array allocations. optimize this!
+				// Calculate the origin offset by the first point of this rotation
+				TestPlacement.Origin = TestPoint - FirstPoints[i];
+				TestPlacement.Rotation = RotationRange[i];
+				const FFaerieGridShape Translated = ApplyPlacement(Shape, TestPlacement);
 				if (FitsInGrid(Translated, {}))
 				{
 					return TestPlacement;
@@ -506,7 +812,6 @@ bool UInventorySpatialGridExtension::FitsInGrid(const FFaerieGridShapeConstView&
 	// Early exit if shape is obviously too large
 	if (Bounds.Max.X > GridSize.X || Bounds.Max.Y > GridSize.Y)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Item Too Big"));
 		return false;
 	}
 
@@ -517,14 +822,12 @@ bool UInventorySpatialGridExtension::FitsInGrid(const FFaerieGridShapeConstView&
 		if (Point.X < 0 || Point.X >= GridSize.X ||
 			Point.Y < 0 || Point.Y >= GridSize.Y)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Item Falls Outside Grid"));
 			return false;
 		}
 
 		// If this index is not in the excluded list, check if it's occupied
 		if (!ExclusionSet.Contains(Point) && IsCellOccupied(Point))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Cell Is Occupied"));
 			return false;
 		}
 	}
@@ -551,18 +854,13 @@ bool UInventorySpatialGridExtension::FitsInGridAnyRotation(const FFaerieGridShap
 FInventoryKey UInventorySpatialGridExtension::FindOverlappingItem(const FFaerieGridShapeConstView& TranslatedShape,
 																  const FInventoryKey& ExcludeKey) const
 {
-	if (const FFaerieGridKeyedStack* Stack = GridContent.FindByPredicate(
-		[this, &TranslatedShape, ExcludeKey](const FFaerieGridKeyedStack& Other)
-		{
-			if (ExcludeKey == Other.Key) { return false; }
-
-			// Create a rotated and translated version of the other item's shape
-			FFaerieGridShape OtherItemShape = GetItemShape(Other.Key.EntryKey);
-			ApplyPlacementInline(OtherItemShape, Other.Value);
-			return TranslatedShape.Overlaps(OtherItemShape);
-		}))
+	for (const FIntPoint& Point : TranslatedShape.Points)
 	{
-		return Stack->Key;
+		if (const FInventoryKey Owner = GetCellOwner(Point);
+			Owner.IsValid() && Owner != ExcludeKey)
+		{
+			return Owner;
+		}
 	}
 	return FInventoryKey();
 }
@@ -603,8 +901,8 @@ bool UInventorySpatialGridExtension::TrySwapItems(const FInventoryKey KeyA, FFae
 	RemoveItemPosition(ItemShapeAOld);
 	RemoveItemPosition(ItemShapeBOld);
 	// Add To Swapped Positions
-	AddItemPosition(ItemShapeANew);
-	AddItemPosition(ItemShapeBNew);
+	AddItemPosition(KeyA, ItemShapeANew);
+	AddItemPosition(KeyB, ItemShapeBNew);
 	Swap(PlacementA.Origin, PlacementB.Origin);
 
 	return true;
@@ -628,16 +926,16 @@ bool UInventorySpatialGridExtension::MoveSingleItem(const FInventoryKey Key, FFa
 
 	RemoveItemPosition(ItemShape);
 	Placement.Origin = NewPosition;
-	AddItemPosition(NewShape);
+	AddItemPosition(Key, NewShape);
 
 	return true;
 }
 
-void UInventorySpatialGridExtension::AddItemPosition(const FFaerieGridShapeConstView TranslatedShape)
+void UInventorySpatialGridExtension::AddItemPosition(const FInventoryKey& Key, const FFaerieGridShapeConstView TranslatedShape)
 {
 	for (auto& Point : TranslatedShape.Points)
 	{
-		MarkCell(Point);
+		MarkCell(Point, Key);
 	}
 }
 
@@ -65,9 +65,5 @@ void FFaerieGridContent::Insert(FInventoryKey Key, const FFaerieGridPlacement& V
 
 void FFaerieGridContent::Remove(const FInventoryKey Key)
 {
-	if (BSOA::Remove(Key))
-	{
-		// Notify clients of this removal.
-		MarkArrayDirty();
-	}
+	Remove(Key, [](const FFaerieGridKeyedStack&) {});
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "GridBitboard.h"
+#include "SpatialTypes.h"
+
+namespace Faerie
+{
+	FGridShapeMask FGridShapeMask::Make(const FFaerieGridShapeConstView& Shape)
+	{
+		FGridShapeMask Mask;
+
+		if (Shape.Points.IsEmpty())
+		{
+			return Mask;
+		}
+
+		FIntPoint Max(TNumericLimits<int32>::Min());
+		Mask.Min = FIntPoint(TNumericLimits<int32>::Max());
+		for (const FIntPoint& Point : Shape.Points)
+		{
+			Mask.Min = Mask.Min.ComponentMin(Point);
+			Max = Max.ComponentMax(Point);
+		}
+		Mask.Size = Max - Mask.Min + 1;
+
+		if (Mask.Size.X > 64)
+		{
+			// Too wide to pack into a single word per row.
+			return FGridShapeMask();
+		}
+
+		Mask.Rows.SetNumZeroed(Mask.Size.Y);
+		for (const FIntPoint& Point : Shape.Points)
+		{
+			const FIntPoint Local = Point - Mask.Min;
+			Mask.Rows[Local.Y] |= uint64(1) << Local.X;
+		}
+
+		// The first row always has a cell, as Min.Y is taken from the points.
+		Mask.FirstPoint = Mask.Min + FIntPoint(static_cast<int32>(FMath::CountTrailingZeros64(Mask.Rows[0])), 0);
+
+		return Mask;
+	}
+
+	FCompiledGridShape::FCompiledGridShape(const FFaerieGridShapeConstView& Shape)
+	{
+		if (Shape.Points.IsEmpty())
+		{
+			return;
+		}
+
+		bSymmetrical = Shape.IsSymmetrical();
+
+		// Rotate exactly as UInventorySpatialGridExtension::ApplyPlacement does, so masks land on the same cells.
+		const FFaerieGridShape Source = Shape.Copy();
+		for (const ESpatialItemRotation Rotation : TEnumRange<ESpatialItemRotation>())
+		{
+			FFaerieGridShape Rotated = Source;
+			Rotated.RotateInline(Rotation);
+			Masks[static_cast<uint8>(Rotation)] = FGridShapeMask::Make(Rotated);
+		}
+	}
+
+	bool FCompiledGridShape::IsValid() const
+	{
+		for (const FGridShapeMask& Mask : Masks)
+		{
+			if (!Mask.IsValid())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const FCompiledGridShape& FCompiledGridShape::SingleCell()
+	{
+		static const FCompiledGridShape Single(FFaerieGridShape::MakeSquare(1));
+		return Single;
+	}
+
+	void FGridBitboard::Init(const FIntPoint NewSize)
+	{
+		Size = NewSize.ComponentMax(FIntPoint::ZeroValue);
+		WordsPerRow = (Size.X + 63) / 64;
+		Words.Reset();
+		Words.SetNumZeroed(WordsPerRow * Size.Y);
+	}
+
+	void FGridBitboard::Resize(const FIntPoint NewSize)
+	{
+		const FGridBitboard Old = *this;
+		Init(NewSize);
+
+		// Copy over existing data that's still in bounds
+		const FIntPoint Overlap = Old.Size.ComponentMin(Size);
+		FIntPoint Point;
+		for (Point.Y = 0; Point.Y < Overlap.Y; ++Point.Y)
+		{
+			for (Point.X = 0; Point.X < Overlap.X; ++Point.X)
+			{
+				Set(Point, Old.Get(Point));
+			}
+		}
+	}
+
+	void FGridBitboard::Reset()
+	{
+		Size = FIntPoint::ZeroValue;
+		WordsPerRow = 0;
+		Words.Reset();
+	}
+
+	void FGridBitboard::ClearAll()
+	{
+		FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+	}
+
+	bool FGridBitboard::Fits(const FGridShapeMask& Mask, const FIntPoint& Origin) const
+	{
+		if (!Mask.IsValid())
+		{
+			return false;
+		}
+
+		const FIntPoint TopLeft = Origin + Mask.Min;
+
+		// Reject anything that falls outside the grid
+		if (TopLeft.X < 0 || TopLeft.Y < 0 ||
+			TopLeft.X + Mask.Size.X > Size.X ||
+			TopLeft.Y + Mask.Size.Y > Size.Y)
+		{
+			return false;
+		}
+
+		const int32 Word = TopLeft.X >> 6;
+		const int32 Shift = TopLeft.X & 63;
+		const bool bStraddles = Shift != 0 && Word + 1 < WordsPerRow;
+
+		const uint64* Row = Words.GetData() + TopLeft.Y * WordsPerRow + Word;
+		for (const uint64 MaskRow : Mask.Rows)
+		{
+			if (Row[0] & (MaskRow << Shift))
+			{
+				return false;
+			}
+
+			// Bits shifted past the end of the first word continue into the next.
+			if (bStraddles && (Row[1] & (MaskRow >> (64 - Shift))))
+			{
+				return false;
+			}
+
+			Row += WordsPerRow;
+		}
+
+		return true;
+	}
+
+	void FGridBitboard::Occupy(const FGridShapeMask& Mask, const FIntPoint& Origin)
+	{
+		checkSlow(Fits(Mask, Origin));
+
+		const FIntPoint TopLeft = Origin + Mask.Min;
+		const int32 Word = TopLeft.X >> 6;
+		const int32 Shift = TopLeft.X & 63;
+		const bool bStraddles = Shift != 0 && Word + 1 < WordsPerRow;
+
+		uint64* Row = Words.GetData() + TopLeft.Y * WordsPerRow + Word;
+		for (const uint64 MaskRow : Mask.Rows)
+		{
+			Row[0] |= MaskRow << Shift;
+			if (bStraddles)
+			{
+				Row[1] |= MaskRow >> (64 - Shift);
+			}
+			Row += WordsPerRow;
+		}
+	}
+}
@@ -0,0 +1,235 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "InventorySortedView.h"
+#include "FaerieItemStorage.h"
+#include "Algo/BinarySearch.h"
+
+DECLARE_STATS_GROUP(TEXT("InventorySortedView"), STATGROUP_InventorySortedView, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Reset"), STAT_SortedView_Reset, STATGROUP_InventorySortedView);
+DECLARE_CYCLE_STAT(TEXT("Apply Changes"), STAT_SortedView_ApplyChanges, STATGROUP_InventorySortedView);
+
+namespace Faerie
+{
+	bool FInventorySortedView::SupportsSortRule(const UFaerieItemDataComparator* SortRule)
+	{
+		return !IsValid(SortRule) || SortRule->SupportsSortKeys();
+	}
+
+	void FInventorySortedView::Reset(const UFaerieItemStorage* InStorage, const FFilter& InFilter,
+									 const UFaerieItemDataComparator* InSortRule, const bool InReverse)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SortedView_Reset);
+
+		Clear();
+
+		if (!IsValid(InStorage))
+		{
+			return;
+		}
+
+		ensureMsgf(SupportsSortRule(InSortRule), TEXT("Sort rule cannot make sort keys. View will be in key order!"));
+
+		Storage = InStorage;
+		Filter = InFilter;
+		SortRule = InSortRule;
+		Reverse = InReverse;
+
+		// Gather every row first, and sort once.
+		InStorage->ForEachKey(
+			[this, InStorage](const FEntryKey Key)
+			{
+				const FFaerieItemStackView View = InStorage->View(Key);
+				if (Filter.IsBound() ? !Filter.Execute(View) : !View.Item.IsValid())
+				{
+					return;
+				}
+
+				const FFaerieItemSortKey& SortKey = EntrySortKeys.Add(Key, MakeSortKey(View));
+				for (const FKeyedStack& Stack : InStorage->GetEntryView(Key).Get().Stacks)
+				{
+					Rows.Add({SortKey, {Key, Stack.Key}});
+				}
+			});
+
+		Rows.Sort(
+			[this](const FRow& A, const FRow& B)
+			{
+				return RowLess(A.SortKey, A.Key, B.SortKey, B.Key);
+			});
+	}
+
+	void FInventorySortedView::Clear()
+	{
+		Storage.Reset();
+		Filter.Unbind();
+		SortRule.Reset();
+		Reverse = false;
+		Rows.Reset();
+		EntrySortKeys.Reset();
+	}
+
+	void FInventorySortedView::AddEntry(const FEntryKey Key)
+	{
+		const UFaerieItemStorage* StoragePtr = Storage.Get();
+		if (!IsValid(StoragePtr) || !StoragePtr->IsValidKey(Key))
+		{
+			return;
+		}
+
+		if (EntrySortKeys.Contains(Key))
+		{
+			UpdateEntry(Key);
+			return;
+		}
+
+		const FFaerieItemStackView View = StoragePtr->View(Key);
+		if (Filter.IsBound() ? !Filter.Execute(View) : !View.Item.IsValid())
+		{
+			return;
+		}
+
+		const FFaerieItemSortKey& SortKey = EntrySortKeys.Add(Key, MakeSortKey(View));
+		InsertRows(Key, StoragePtr->GetEntryView(Key).Get(), SortKey);
+	}
+
+	void FInventorySortedView::UpdateEntry(const FEntryKey Key)
+	{
+		// The entry's sort key or stacks may have changed, so its rows are simply moved to wherever they now belong.
+		RemoveEntry(Key);
+		AddEntry(Key);
+	}
+
+	void FInventorySortedView::RemoveEntry(const FEntryKey Key, TArray<FInventoryKey>* OutRemovedKeys)
+	{
+		if (FFaerieItemSortKey SortKey;
+			EntrySortKeys.RemoveAndCopyValue(Key, SortKey))
+		{
+			RemoveRows(Key, SortKey, OutRemovedKeys);
+		}
+	}
+
+	void FInventorySortedView::ApplyChanges(const FFaerieStorageChangeSet& Changes)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SortedView_ApplyChanges);
+
+		for (const FEntryKey Key : Changes.Removed)
+		{
+			RemoveEntry(Key);
+		}
+		for (const FEntryKey Key : Changes.Added)
+		{
+			AddEntry(Key);
+		}
+		for (const FEntryKey Key : Changes.Updated)
+		{
+			UpdateEntry(Key);
+		}
+	}
+
+	int32 FInventorySortedView::IndexOf(const FInventoryKey Key) const
+	{
+		const FFaerieItemSortKey* SortKey = EntrySortKeys.Find(Key.EntryKey);
+		if (!SortKey)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Index = LowerBound(*SortKey, Key);
+		if (Rows.IsValidIndex(Index) && Rows[Index].Key == Key)
+		{
+			return Index;
+		}
+		return INDEX_NONE;
+	}
+
+	void FInventorySortedView::GetWindow(const int32 First, const int32 Count, TArray<FInventoryKey>& OutKeys) const
+	{
+		const int32 Start = FMath::Clamp(First, 0, Rows.Num());
+		const int32 End = FMath::Clamp(First + Count, Start, Rows.Num());
+
+		OutKeys.Reset(End - Start);
+		for (int32 i = Start; i < End; ++i)
+		{
+			OutKeys.Add(Rows[i].Key);
+		}
+	}
+
+	void FInventorySortedView::GetAllKeys(TArray<FInventoryKey>& OutKeys) const
+	{
+		GetWindow(0, Rows.Num(), OutKeys);
+	}
+
+	bool FInventorySortedView::RowLess(const FFaerieItemSortKey& SortKeyA, const FInventoryKey A,
+									   const FFaerieItemSortKey& SortKeyB, const FInventoryKey B) const
+	{
+		if (SortKeyA < SortKeyB) return !Reverse;
+		if (SortKeyB < SortKeyA) return Reverse;
+
+		if (A.EntryKey != B.EntryKey)
+		{
+			return A.EntryKey < B.EntryKey;
+		}
+		return A.StackKey < B.StackKey;
+	}
+
+	int32 FInventorySortedView::LowerBound(const FFaerieItemSortKey& SortKey, const FInventoryKey Key) const
+	{
+		return Algo::LowerBound(Rows, Key,
+			[this, &SortKey](const FRow& Row, const FInventoryKey Value)
+			{
+				return RowLess(Row.SortKey, Row.Key, SortKey, Value);
+			});
+	}
+
+	FFaerieItemSortKey FInventorySortedView::MakeSortKey(const FFaerieItemStackView View) const
+	{
+		if (const UFaerieItemDataComparator* Rule = SortRule.Get();
+			IsValid(Rule) && Rule->SupportsSortKeys())
+		{
+			return Rule->MakeSortKey(View);
+		}
+
+		// Without a sort rule, every entry has the same key, and rows fall back to key order.
+		return FFaerieItemSortKey();
+	}
+
+	void FInventorySortedView::InsertRows(const FEntryKey Key, const FInventoryEntry& Entry, const FFaerieItemSortKey& SortKey)
+	{
+		if (Entry.Stacks.IsEmpty())
+		{
+			return;
+		}
+
+		// An invalid stack key orders before any valid one, so this finds where the entry's first stack belongs.
+		const int32 Index = LowerBound(SortKey, {Key, FStackKey()});
+
+		// Stacks are kept in key order, so they can be inserted as one contiguous run.
+		Rows.InsertDefaulted(Index, Entry.Stacks.Num());
+		for (int32 i = 0; i < Entry.Stacks.Num(); ++i)
+		{
+			FRow& Row = Rows[Index + i];
+			Row.SortKey = SortKey;
+			Row.Key = {Key, Entry.Stacks[i].Key};
+		}
+	}
+
+	void FInventorySortedView::RemoveRows(const FEntryKey Key, const FFaerieItemSortKey& SortKey, TArray<FInventoryKey>* OutRemovedKeys)
+	{
+		const int32 Index = LowerBound(SortKey, {Key, FStackKey()});
+
+		int32 Count = 0;
+		while (Rows.IsValidIndex(Index + Count) && Rows[Index + Count].Key.EntryKey == Key)
+		{
+			if (OutRemovedKeys)
+			{
+				OutRemovedKeys->Add(Rows[Index + Count].Key);
+			}
+			Count++;
+		}
+
+		if (Count > 0)
+		{
+			Rows.RemoveAt(Index, Count, EAllowShrinking::No);
+		}
+	}
+}
@@ -17,13 +17,12 @@ void UFaerieCapacityToken::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 
 int32 UFaerieCapacityToken::GetWeightOfStack(const int32 Stack) const
 {
-	return Capacity.Weight * Stack;
+	return Capacity.GetWeightOfStack(Stack);
 }
 
 int32 UFaerieCapacityToken::GetVolumeOfStack(const int32 Stack) const
 {
-	const int64 Volume = Capacity.GetVolume();
-	return static_cast<int32>(Volume + (Volume * (Stack - 1) * Capacity.Efficiency)); // @todo maybe return int64 here?
+	return Capacity.GetVolumeOfStack(Stack);
 }
 
 FWeightAndVolume UFaerieCapacityToken::GetWeightAndVolumeOfStack(const int32 Stack) const
@@ -12,4 +12,26 @@ void UFaerieShapeToken::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
     FDoRepLifetimeParams Params;
     Params.bIsPushBased = true;
     DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, Shape, Params);
+}
+
+#if WITH_EDITOR
+void UFaerieShapeToken::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    CompiledShape.Reset();
+}
+#endif
+
+const Faerie::FCompiledGridShape& UFaerieShapeToken::GetCompiledShape() const
+{
+    if (!CompiledShape.IsSet())
+    {
+        CompiledShape.Emplace(Shape);
+    }
+    return CompiledShape.GetValue();
+}
+
+void UFaerieShapeToken::OnRep_Shape()
+{
+    CompiledShape.Reset();
 }
\ No newline at end of file
@@ -21,6 +21,8 @@ bool UInventoryContentsBase::Initialize()
 {
 	Query.Filter.BindUObject(this, &ThisClass::ExecFilter);
 	Query.Sort.BindUObject(this, &ThisClass::ExecSort);
+	ViewQuery.Filter.BindUObject(this, &ThisClass::ExecFilterView);
+	ViewQuery.Sort.BindUObject(this, &ThisClass::ExecSortView);
 
 	return Super::Initialize();
 }
@@ -42,16 +44,51 @@ void UInventoryContentsBase::NativeTick(const FGeometry& MyGeometry, const float
 
 	if (NeedsResort)
 	{
-		TArray<FKeyedInventoryEntry> Entries;
-		if (ItemStorage.IsValid())
+		UsingSortedView = ItemStorage.IsValid() && CanUseSortedView();
+
+		if (UsingSortedView)
 		{
-			ItemStorage->QueryAll(Query, Entries);
+			SortedView.Reset(ItemStorage.Get(), ViewQuery.Filter, ActiveSortRule, Query.InvertSort);
+			SortedViewChanged = true;
+		}
+		else
+		{
+			SortedView.Clear();
+
+			TArray<FKeyedInventoryEntry> Entries;
+			if (ItemStorage.IsValid())
+			{
+				if (CanQueryByView())
+				{
+					ViewQuery.InvertSort = Query.InvertSort;
+					ItemStorage->QueryAllView(ViewQuery, Entries);
+				}
+				else
+				{
+					ItemStorage->QueryAll(Query, Entries);
+				}
+			}
+			Faerie::Inventory::BreakKeyedEntriesIntoInventoryKeys(Entries, SortedAndFilteredKeys);
+			NeedsReconstructEntries = true;
 		}
-		Faerie::Inventory::BreakKeyedEntriesIntoInventoryKeys(Entries, SortedAndFilteredKeys);
-		NeedsReconstructEntries = true;
 		NeedsResort = false;
 	}
 
+	// Changes to the sorted view are copied out at most once per frame.
+	if (SortedViewChanged)
+	{
+		if (bVirtualizeSortedKeys)
+		{
+			SortedAndFilteredKeys.Reset();
+		}
+		else
+		{
+			SortedView.GetAllKeys(SortedAndFilteredKeys);
+		}
+		NeedsReconstructEntries = true;
+		SortedViewChanged = false;
+	}
+
 	if (NeedsReconstructEntries)
 	{
 		DisplaySortedEntries();
@@ -62,7 +99,11 @@ void UInventoryContentsBase::NativeTick(const FGeometry& MyGeometry, const float
 void UInventoryContentsBase::Reset()
 {
 	SortedAndFilteredKeys.Empty();
+	SortedView.Clear();
+	UsingSortedView = false;
+	SortedViewChanged = false;
 	ActiveFilterRule = nullptr;
+	ActiveFilterProgram = Faerie::ItemData::FFilterProgram();
 	ActiveSortRule = nullptr;
 	Query.InvertFilter = false;
 	Query.InvertSort = false;
@@ -101,7 +142,7 @@ bool UInventoryContentsBase::ExecFilter(const FFaerieItemProxy& Entry)
 {
 	if (IsValid(ActiveFilterRule))
 	{
-		return ActiveFilterRule->Exec(Entry);
+		return ActiveFilterProgram.Exec(Entry);
 	}
 	return Entry.IsValid();
 }
@@ -114,8 +155,53 @@ bool UInventoryContentsBase::ExecSort(const FFaerieItemProxy& A, const FFaerieIt
 	return ActiveSortRule->Exec(A, B);
 }
 
+// ReSharper disable once CppMemberFunctionMayBeConst
+// Cannot be const to bind
+bool UInventoryContentsBase::ExecFilterView(const FFaerieItemStackView Entry)
+{
+	if (IsValid(ActiveFilterRule))
+	{
+		return ActiveFilterProgram.Exec(Entry);
+	}
+	return Entry.Item.IsValid();
+}
+
+// ReSharper disable once CppMemberFunctionMayBeConst
+// Cannot be const to bind
+bool UInventoryContentsBase::ExecSortView(const FFaerieItemStackView A, const FFaerieItemStackView B)
+{
+	if (!IsValid(ActiveSortRule)) return false;
+	return ActiveSortRule->ExecView(A, B);
+}
+
+bool UInventoryContentsBase::CanQueryByView() const
+{
+	return !FilterNeedsProxy &&
+		(!IsValid(ActiveSortRule) || ActiveSortRule->SupportsStackViews());
+}
+
+bool UInventoryContentsBase::CanUseSortedView() const
+{
+	// Widgets that manage their own order add keys by hand, which the view can't represent.
+	return bAlwaysAddNewToSortOrder &&
+		!FilterNeedsProxy &&
+		Faerie::FInventorySortedView::SupportsSortRule(ActiveSortRule);
+}
+
 void UInventoryContentsBase::NativeEntryAdded(UFaerieItemStorage* Storage, const FEntryKey Key)
 {
+	if (UsingSortedView)
+	{
+		SortedView.AddEntry(Key);
+		SortedViewChanged = true;
+
+		for (auto&& InvKey : ItemStorage->GetInvKeysForEntry(Key))
+		{
+			OnKeyAdded(InvKey);
+		}
+		return;
+	}
+
 	if (bAlwaysAddNewToSortOrder)
 	{
 		TArray<FInventoryKey> InvKeys = ItemStorage->GetInvKeysForEntry(Key);
@@ -134,6 +220,29 @@ void UInventoryContentsBase::NativeEntryAdded(UFaerieItemStorage* Storage, const
 
 void UInventoryContentsBase::NativeEntryUpdated(UFaerieItemStorage* Storage, const FEntryKey Key)
 {
+	if (UsingSortedView)
+	{
+		// Stacks that no longer exist are dropped from the view, and reported as removed.
+		TArray<FInventoryKey> OldKeys;
+		SortedView.RemoveEntry(Key, &OldKeys);
+		SortedView.AddEntry(Key);
+		SortedViewChanged = true;
+
+		TArray<FInventoryKey> InvKeys = ItemStorage->GetInvKeysForEntry(Key);
+		for (auto&& OldKey : OldKeys)
+		{
+			if (!InvKeys.Contains(OldKey))
+			{
+				OnKeyRemoved(OldKey);
+			}
+		}
+		for (auto&& InvKey : InvKeys)
+		{
+			OnKeyUpdated(InvKey);
+		}
+		return;
+	}
+
 	if (bAlwaysAddNewToSortOrder)
 	{
 		TArray<FInventoryKey> InvKeys = ItemStorage->GetInvKeysForEntry(Key);
@@ -154,6 +263,18 @@ void UInventoryContentsBase::NativeEntryRemoved(UFaerieItemStorage* Storage, con
 {
 	TArray<FInventoryKey> DeadKeys;
 
+	if (UsingSortedView)
+	{
+		SortedView.RemoveEntry(Key, &DeadKeys);
+		SortedViewChanged = true;
+
+		for (auto&& DeadKey : DeadKeys)
+		{
+			OnKeyRemoved(DeadKey);
+		}
+		return;
+	}
+
 	SortedAndFilteredKeys.RemoveAll([Key, &DeadKeys](const FInventoryKey InvKey)
 		{
 			if (InvKey.EntryKey == Key)
@@ -227,6 +348,32 @@ void UInventoryContentsBase::AddToSortOrder(const FInventoryKey Key, const bool
 		}
 	};
 
+	struct FInsertKeyViewPredicate
+	{
+		FInsertKeyViewPredicate(const UFaerieItemDataComparator* SortRule, const bool InvertSort, const UFaerieItemStorage* Storage)
+		  : SortRule(SortRule),
+			InvertSort(InvertSort),
+			Storage(Storage) {}
+
+		const UFaerieItemDataComparator* SortRule;
+		const bool InvertSort;
+		const UFaerieItemStorage* Storage;
+
+		bool operator()(const FInventoryKey A, const FInventoryKey B) const
+		{
+			const bool Result = SortRule->ExecView(Storage->View(A.EntryKey), Storage->View(B.EntryKey));
+			return InvertSort ? !Result : Result;
+		}
+	};
+
+	if (UsingSortedView)
+	{
+		// The view always holds every stack of an entry that passes the filter.
+		SortedView.AddEntry(Key.EntryKey);
+		SortedViewChanged = true;
+		return;
+	}
+
 	if (SortedAndFilteredKeys.IsEmpty())
 	{
 		SortedAndFilteredKeys.Add(Key);
@@ -252,7 +399,9 @@ void UInventoryContentsBase::AddToSortOrder(const FInventoryKey Key, const bool
 		}
 
 		// Binary search to find position to insert the new key.
-		const int32 Index = Algo::LowerBound(SortedAndFilteredKeys, Key, FInsertKeyPredicate(Query, ItemStorage.Get()));
+		const int32 Index = ActiveSortRule->SupportsStackViews()
+			? Algo::LowerBound(SortedAndFilteredKeys, Key, FInsertKeyViewPredicate(ActiveSortRule, Query.InvertSort, ItemStorage.Get()))
+			: Algo::LowerBound(SortedAndFilteredKeys, Key, FInsertKeyPredicate(Query, ItemStorage.Get()));
 
 		// Return if the key we were sorted to or above is ourself.
 		if (SortedAndFilteredKeys.IsValidIndex(Index) && SortedAndFilteredKeys[Index] == Key ||
@@ -279,12 +428,15 @@ void UInventoryContentsBase::AddToSortOrder(const FInventoryKey Key, const bool
 void UInventoryContentsBase::SetFilterByDelegate(const FBlueprintStorageFilter& Filter, const bool bResort)
 {
 	Query.Filter.Unbind();
+	ViewQuery.Filter.Unbind();
+	FilterNeedsProxy = false;
 	if (Filter.IsBound())
 	{
 		Query.Filter.BindLambda([Filter](const FFaerieItemProxy& Proxy)
 			{
 				return Filter.Execute(Proxy);
 			});
+		FilterNeedsProxy = true;
 	}
 
 	if (bResort)
@@ -297,7 +449,10 @@ void UInventoryContentsBase::ResetFilter(const bool bResort)
 {
 	UE_LOG(LogInventoryContents, Log, TEXT("Resetting to the default filter rule"));
 	Query.Filter.BindUObject(this, &ThisClass::ExecFilter);
+	ViewQuery.Filter.BindUObject(this, &ThisClass::ExecFilterView);
+	FilterNeedsProxy = false;
 	ActiveFilterRule = DefaultFilterRule;
+	ActiveFilterProgram = Faerie::ItemData::FFilterProgram::Compile(ActiveFilterRule);
 	if (bResort)
 	{
 		NeedsResort = true;
@@ -328,6 +483,29 @@ void UInventoryContentsBase::SetSortReverse(const bool Reverse, const bool bReso
 	}
 }
 
+int32 UInventoryContentsBase::GetNumSortedKeys() const
+{
+	return UsingSortedView ? SortedView.Num() : SortedAndFilteredKeys.Num();
+}
+
+TArray<FInventoryKey> UInventoryContentsBase::GetSortedKeysInRange(const int32 First, const int32 Count) const
+{
+	TArray<FInventoryKey> Out;
+
+	if (UsingSortedView)
+	{
+		SortedView.GetWindow(First, Count, Out);
+	}
+	else
+	{
+		const int32 Start = FMath::Clamp(First, 0, SortedAndFilteredKeys.Num());
+		const int32 End = FMath::Clamp(First + Count, Start, SortedAndFilteredKeys.Num());
+		Out.Append(SortedAndFilteredKeys.GetData() + Start, End - Start);
+	}
+
+	return Out;
+}
+
 void UInventoryContentsBase::ResetSort(const bool bResort)
 {
 	UE_LOG(LogInventoryContents, Log, TEXT("Resetting to the default sort rule"));
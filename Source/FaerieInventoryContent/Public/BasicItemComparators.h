@@ -15,6 +15,10 @@ class FAERIEINVENTORYCONTENT_API UFaerieLexicographicNameComparator : public UFa
 
 public:
 	virtual bool Exec(FFaerieItemProxy A, FFaerieItemProxy B) const override;
+	virtual bool SupportsStackViews() const override { return true; }
+	virtual bool ExecView(FFaerieItemStackView A, FFaerieItemStackView B) const override;
+	virtual bool SupportsSortKeys() const override { return true; }
+	virtual FFaerieItemSortKey MakeSortKey(FFaerieItemStackView View) const override;
 };
 
 /**
@@ -27,4 +31,8 @@ class FAERIEINVENTORYCONTENT_API UFaerieDateModifiedComparator : public UFaerieI
 
 public:
 	virtual bool Exec(FFaerieItemProxy A, FFaerieItemProxy B) const override;
+	virtual bool SupportsStackViews() const override { return true; }
+	virtual bool ExecView(FFaerieItemStackView A, FFaerieItemStackView B) const override;
+	virtual bool SupportsSortKeys() const override { return true; }
+	virtual FFaerieItemSortKey MakeSortKey(FFaerieItemStackView View) const override;
 };
\ No newline at end of file
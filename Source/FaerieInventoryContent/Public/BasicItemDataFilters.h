@@ -18,6 +18,7 @@ class UFilterRule_Literal : public UFaerieItemDataFilter
 
 public:
 	virtual bool Exec(FFaerieItemStackView View) const override { return true; }
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 };
 
 /**
@@ -35,6 +36,7 @@ public:
 
 	virtual bool ExecWithLog(FFaerieItemStackView View, Faerie::ItemData::FFilterLogger& Logger) const override;
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Instanced, Category = "Inventory Filter")
@@ -56,6 +58,7 @@ public:
 
 	virtual bool ExecWithLog(FFaerieItemStackView View, Faerie::ItemData::FFilterLogger& Logger) const override;
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Instanced, Category = "Inventory Filter")
@@ -76,6 +79,7 @@ public:
 #endif
 
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Instanced, Category = "Condition")
@@ -103,6 +107,7 @@ public:
 #endif
 
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Instanced, Category = "Ternary")
@@ -129,6 +134,7 @@ public:
 #endif
 
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Instanced, Category = "LogicalNot")
@@ -149,6 +155,7 @@ public:
 #endif
 
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	// Enable to require a mutable entry. Leave disabled to only allow immutable entries.
@@ -171,6 +178,7 @@ public:
 
 	virtual bool ExecWithLog(const FFaerieItemStackView View, Faerie::ItemData::FFilterLogger& Logger) const override;
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Stack Compare", meta = (AllowAbstract))
@@ -195,6 +203,7 @@ public:
 
 	virtual bool ExecWithLog(const FFaerieItemStackView View, Faerie::ItemData::FFilterLogger& Logger) const override;
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Find Token", meta = (AllowAbstract = "true"))
@@ -226,6 +235,7 @@ public:
 #endif
 
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "CompareCopies")
@@ -287,6 +297,7 @@ public:
 #endif
 
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Faerie|TagToken")
@@ -307,6 +318,7 @@ public:
 #endif
 
 	virtual bool Exec(FFaerieItemStackView View) const override;
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const override;
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Faerie|TagToken")
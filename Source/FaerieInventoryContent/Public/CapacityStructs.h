@@ -104,6 +104,19 @@ struct FAERIEINVENTORYCONTENT_API FItemCapacity
     {
     	return static_cast<double>(Weight) / GetEfficientVolume();
     }
+
+	// Get the weight of a stack of this entry.
+	int32 GetWeightOfStack(const int32 Stack) const
+    {
+    	return Weight * Stack;
+    }
+
+	// Get the volume of a stack of this entry, with each copy past the first scaled by Efficiency.
+	int32 GetVolumeOfStack(const int32 Stack) const
+    {
+    	const int64 Volume = GetVolume();
+    	return static_cast<int32>(Volume + (Volume * (Stack - 1) * Efficiency)); // @todo maybe return int64 here?
+    }
 };
 
 
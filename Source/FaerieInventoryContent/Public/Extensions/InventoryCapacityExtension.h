@@ -3,7 +3,9 @@
 #pragma once
 
 #include "ItemContainerExtensionBase.h"
+#include "BinarySearchOptimizedArray.h"
 #include "CapacityStructs.h"
+#include "UObject/ObjectKey.h"
 #include "InventoryCapacityExtension.generated.h"
 
 UENUM(BlueprintType, Meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
@@ -79,6 +81,48 @@ struct FCapacityExtensionState
     bool OverMaxVolume = false;
 };
 
+namespace Faerie::Capacity
+{
+    // The capacity of a single copy of an item, cached so that its capacity token only needs to be found once.
+    struct FUnitCapacity
+    {
+        FItemCapacity Capacity;
+        bool HasToken = false;
+    };
+
+    struct FEntryCapacity
+    {
+        // The item this entry holds. Only used to release its known unit capacity once the entry is gone.
+        TObjectKey<UFaerieItem> Item;
+
+        FUnitCapacity Unit;
+
+        // The amount this entry has contributed to the state.
+        FWeightAndVolume Total;
+    };
+
+    struct FKeyedEntryCapacity
+    {
+        FEntryKey Key;
+        FEntryCapacity Value;
+    };
+
+    /**
+     * Dense cache of entry capacities for one container. Kept in key order, the same as the container's own entries, so
+     * new entries are appended, and lookups are a binary search.
+     */
+    struct FContainerCapacityCache : TBinarySearchOptimizedArray<FContainerCapacityCache, FKeyedEntryCapacity>
+    {
+        TArray<FKeyedEntryCapacity> Entries;
+
+        // The sum of all entry Totals, so the container can be removed from the state without walking its entries.
+        FWeightAndVolume Sum;
+
+        // Enables TBinarySearchOptimizedArray
+        TArray<FKeyedEntryCapacity>& GetArray() { return Entries; }
+    };
+}
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FInventoryCapacityEvent);
 
 /**
@@ -105,17 +149,29 @@ protected:
     virtual EEventExtensionResponse AllowsAddition(const UFaerieItemContainerBase* Container, FFaerieItemStackView Stack, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
     virtual void PostAddition(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
     virtual void PostRemoval(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
+    virtual EEventExtensionResponse AllowsAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<FFaerieItemStackView> Stacks, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
+    virtual void PostAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<Faerie::Inventory::FEventLog> Events) override;
+    virtual void PostRemovalBatch(const UFaerieItemContainerBase* Container, TConstArrayView<Faerie::Inventory::FEventLog> Events) override;
     virtual void PostEntryChanged(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
     //~ UItemContainerExtensionBase
 
 private:
-    static FWeightAndVolume GetEntryWeightAndVolume(const UFaerieItemContainerBase* Container, const FEntryKey Key);
+    static Faerie::Capacity::FUnitCapacity MakeUnitCapacity(const UFaerieItem* Item);
+
+    static FWeightAndVolume GetEntryWeightAndVolume(const UFaerieItemContainerBase* Container, const FEntryKey Key,
+                                                    FFaerieItemStackView View, const Faerie::Capacity::FUnitCapacity& Unit);
+
+    // Get the unit capacity of an item, from the cache of known items if possible.
+    Faerie::Capacity::FUnitCapacity GetUnitCapacity(const UFaerieItem* Item) const;
+
+    void AcquireKnownItem(const UFaerieItem* Item, const Faerie::Capacity::FUnitCapacity& Unit);
+    void ReleaseKnownItem(TObjectKey<UFaerieItem> Item);
 
     void UpdateCacheForEntry(const UFaerieItemContainerBase* Container, FEntryKey Key);
 
     void CheckCapacityLimit();
 
-    bool CanContainToken(const class UFaerieCapacityToken* Token, const int32 Stack) const;
+    bool CanContainUnit(const Faerie::Capacity::FUnitCapacity& Unit, const int32 Stack) const;
 
     void AddWeightAndVolume(FWeightAndVolume Value);
 
@@ -185,7 +241,11 @@ protected:
 
     // Cache of all entries to maintain serverside integrity.
     // @todo actually use this to validate State
-    TMap<TWeakObjectPtr<const UFaerieItemContainerBase>, TMap<FEntryKey, FWeightAndVolume>> ServerCapacityCache;
+    TMap<TWeakObjectPtr<const UFaerieItemContainerBase>, Faerie::Capacity::FContainerCapacityCache> ServerCapacityCache;
+
+    // Unit capacities of the data-immutable items held by any container, with the number of cached entries holding
+    // each. Lets AllowsAddition skip the token lookup for items that are already known.
+    TMap<TObjectKey<UFaerieItem>, TPair<Faerie::Capacity::FUnitCapacity, int32>> KnownItemCapacities;
 
 private:
     FSimpleMulticastDelegate OnStateChangedNative;
@@ -19,6 +19,7 @@ class FAERIEINVENTORYCONTENT_API UInventoryContentFilterExtension : public UItem
 public:
 	//~ UItemContainerExtensionBase
 	virtual EEventExtensionResponse AllowsAddition(const UFaerieItemContainerBase* Container, FFaerieItemStackView Stack, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
+	virtual EEventExtensionResponse AllowsAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<FFaerieItemStackView> Stacks, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
 	//~ UItemContainerExtensionBase
 
 protected:
@@ -4,6 +4,7 @@
 
 #include "FaerieGridEnums.h"
 #include "FaerieGridStructs.h"
+#include "GridBitboard.h"
 #include "ItemContainerExtensionBase.h"
 #include "Tokens/FaerieShapeToken.h"
 #include "InventoryGridExtensionBase.generated.h"
@@ -57,12 +58,31 @@ protected:
 	// Convert a grid index to a point
 	FIntPoint Unravel(int32 Index) const;
 
-	void MarkCell(const FIntPoint& Point);
+	// Resize cell data to match GridSize, keeping cells that are still in bounds.
+	void ResizeCells();
+
+	// Mark a cell as occupied by a stack.
+	void MarkCell(const FIntPoint& Point, const FInventoryKey& Owner);
 	void UnmarkCell(const FIntPoint& Point);
 	void UnmarkAllCells();
 
+	// Clear every cell occupied by a stack. Used when its previous placement is unknown.
+	void UnmarkCellsOwnedBy(const FInventoryKey& Owner);
+
+	// Get the stack occupying a cell, or an invalid key if the cell is empty or outside the grid.
+	FInventoryKey GetCellOwner(const FIntPoint& Point) const;
+
+	// Count the new stacks, each needing its own placement, that adding Stack to the container would create. Copies
+	// that fit in the existing stacks of a matching entry are not counted.
+	int32 CountNewStacks(FFaerieItemStackView Stack, EFaerieStorageAddStackBehavior AddStackBehavior) const;
+
+	const Faerie::FGridBitboard& GetOccupiedCells() const { return OccupiedCells; }
+
 	void BroadcastEvent(const FInventoryKey& Key, EFaerieGridEventType EventType);
 
+	// Are we a client receiving replicated grid content. Clients must maintain their own cell occupancy.
+	bool IsClient() const;
+
 	UFUNCTION(/* Replication */)
 	virtual void OnRep_GridSize();
 
@@ -108,5 +128,8 @@ private:
 	FFaerieGridStackChangedNative SpatialStackChangedNative;
 	FFaerieGridSizeChangedNative GridSizeChangedNative;
 
-	TBitArray<> OccupiedCells;
+	Faerie::FGridBitboard OccupiedCells;
+
+	// The stack occupying each cell, indexed by Ravel. Kept in sync with OccupiedCells.
+	TArray<FInventoryKey> CellOwners;
 };
\ No newline at end of file
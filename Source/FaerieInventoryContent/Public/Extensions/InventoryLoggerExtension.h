@@ -4,20 +4,81 @@
 
 #include "ItemContainerExtensionBase.h"
 #include "ItemContainerEvent.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "InventoryLoggerExtension.generated.h"
 
 using FInventoryEventLoggedNative = TMulticastDelegate<void(const FLoggedInventoryEvent&)>;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInventoryEventLogged, const FLoggedInventoryEvent&, LoggedEvent);
 
+class UInventoryLoggerExtension;
+struct FInventoryLoggerEventArray;
+
+USTRUCT()
+struct FInventoryLoggerEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	// The order this event was logged in. Slots in the log are reused once it's full, so this is the only reliable order.
+	UPROPERTY()
+	int64 Sequence = INDEX_NONE;
+
+	UPROPERTY()
+	FLoggedInventoryEvent Event;
+
+	void PostReplicatedAdd(const FInventoryLoggerEventArray& InArraySerializer);
+	void PostReplicatedChange(const FInventoryLoggerEventArray& InArraySerializer);
+};
+
+/**
+ * A fixed-capacity ring of logged events. New events overwrite the oldest slot once full, so only the slot written is
+ * sent to clients.
+ */
+USTRUCT()
+struct FInventoryLoggerEventArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	friend UInventoryLoggerExtension;
+
+private:
+	UPROPERTY()
+	TArray<FInventoryLoggerEntry> Items;
+
+	/** Owning extension to send Fast Array callbacks to */
+	UPROPERTY()
+	TWeakObjectPtr<UInventoryLoggerExtension> ChangeListener;
+
+public:
+	void PostEntryReplicated(const FInventoryLoggerEntry& Entry) const;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FastArrayDeltaSerialize<FInventoryLoggerEntry, FInventoryLoggerEventArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryLoggerEventArray> : public TStructOpsTypeTraitsBase2<FInventoryLoggerEventArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
 /**
  * Logs events from additions, changes, and removals, and can parse them for data at request.
+ * Only the most recent events are kept. Older events can optionally be spilled to a binary stream on the server.
  */
 UCLASS()
 class FAERIEINVENTORYCONTENT_API UInventoryLoggerExtension : public UItemContainerExtensionBase
 {
 	GENERATED_BODY()
 
+	friend FInventoryLoggerEventArray;
+
 public:
+	virtual void PostInitProperties() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 protected:
@@ -27,30 +88,57 @@ protected:
 
 	void HandleNewEvent(const FLoggedInventoryEvent& Event);
 
+	// Called on clients when an event is received.
+	void HandleReplicatedEvent(const FInventoryLoggerEntry& Entry);
+
+private:
+	// Writes an event that is about to be overwritten to the spill stream.
+	void SpillEvent(const FInventoryLoggerEntry& Entry);
+
+	// Get the logged events, oldest first.
+	TArray<const FInventoryLoggerEntry*> GetEntriesInOrder() const;
+
 public:
 	FInventoryEventLoggedNative::RegistrationType& GetOnInventoryEventLogged() { return OnInventoryEventLoggedNative; }
 
 	UFUNCTION(BlueprintCallable, Category = "LoggerExtension")
-	int32 GetNumEvents() const { return EventLog.Num(); }
+	int32 GetNumEvents() const { return EventLog.Items.Num(); }
 
+	// Get all events still held by the log, oldest first.
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "LoggerExtension")
-	const TArray<FLoggedInventoryEvent>& GetAllEvents() const { return EventLog; }
+	TArray<FLoggedInventoryEvent> GetAllEvents() const;
 
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "LoggerExtension")
 	TArray<FLoggedInventoryEvent> GetRecentEvents(int32 NumEvents) const;
 
-protected:
-	UFUNCTION(/* Replication */)
-	virtual void OnRep_EventLog();
+	/**
+	 * Takes the events that have been evicted from the log so far, leaving the spill stream empty. Server only.
+	 * Each record is: Sequence (int64), Timestamp ticks (int64), Type (FName), Success (bool), EntryTouched,
+	 * StackKeys, Amount (int32), and the name of the item (FName).
+	 */
+	TArray<uint8> ConsumeSpilledEvents();
 
+protected:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FInventoryEventLogged OnInventoryEventLogged;
 
-	UPROPERTY(ReplicatedUsing = "OnRep_EventLog")
-	TArray<FLoggedInventoryEvent> EventLog;
+	// The number of events to keep. Once full, each new event replaces the oldest.
+	UPROPERTY(EditAnywhere, Category = "LoggerExtension", meta = (ClampMin = 1))
+	int32 Capacity = 256;
+
+	// Should events that are evicted from the log be written to the spill stream, to keep a full history on the server?
+	UPROPERTY(EditAnywhere, Category = "LoggerExtension")
+	bool SpillEvictedEvents = false;
+
+	UPROPERTY(Replicated)
+	FInventoryLoggerEventArray EventLog;
 
 private:
 	FInventoryEventLoggedNative OnInventoryEventLoggedNative;
 
-	int32 LocalEventLogCount = 0;
-};
\ No newline at end of file
+	// Sequence number of the next event to be logged.
+	int64 NextSequence = 0;
+
+	// Compact binary records of evicted events.
+	TArray<uint8> SpillStream;
+};
@@ -17,6 +17,7 @@ class FAERIEINVENTORYCONTENT_API UInventorySimpleGridExtension : public UInvento
 protected:
 	//~ UItemContainerExtensionBase
 	virtual EEventExtensionResponse AllowsAddition(const UFaerieItemContainerBase* Container, FFaerieItemStackView Stack, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
+	virtual EEventExtensionResponse AllowsAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<FFaerieItemStackView> Stacks, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
 	virtual void PostAddition(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
 	virtual void PostRemoval(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
 	virtual EEventExtensionResponse AllowsEdit(const UFaerieItemContainerBase* Container, FEntryKey Key, FFaerieInventoryTag EditType) const override;
@@ -46,8 +47,8 @@ public:
 	FFaerieGridPlacement FindFirstEmptyLocation() const;
 
 protected:
-	FInventoryKey FindOverlappingItem(const FInventoryKey& ExcludeKey) const;
+	FInventoryKey FindOverlappingItem(const FIntPoint& Position, const FInventoryKey& ExcludeKey) const;
 
-	void SwapItems(FFaerieGridPlacement& PlacementA, FFaerieGridPlacement& PlacementB);
-	void MoveSingleItem(FFaerieGridPlacement& Placement, const FIntPoint& NewPosition);
+	void SwapItems(FInventoryKey KeyA, FFaerieGridPlacement& PlacementA, FInventoryKey KeyB, FFaerieGridPlacement& PlacementB);
+	void MoveSingleItem(FInventoryKey Key, FFaerieGridPlacement& Placement, const FIntPoint& NewPosition);
 };
\ No newline at end of file
@@ -18,6 +18,7 @@ class FAERIEINVENTORYCONTENT_API UInventorySpatialGridExtension : public UInvent
 protected:
 	//~ UItemContainerExtensionBase
 	virtual EEventExtensionResponse AllowsAddition(const UFaerieItemContainerBase* Container, FFaerieItemStackView Stack, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
+	virtual EEventExtensionResponse AllowsAdditionBatch(const UFaerieItemContainerBase* Container, TConstArrayView<FFaerieItemStackView> Stacks, EFaerieStorageAddStackBehavior AddStackBehavior) const override;
 	virtual void PostAddition(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
 	virtual void PostRemoval(const UFaerieItemContainerBase* Container, const Faerie::Inventory::FEventLog& Event) override;
 	virtual EEventExtensionResponse AllowsEdit(const UFaerieItemContainerBase* Container, FEntryKey Key, FFaerieInventoryTag EditType) const override;
@@ -42,14 +43,21 @@ private:
 	void RemoveItem(const FInventoryKey& Key, const UFaerieItem* Item);
 	void RemoveItemBatch(const TConstArrayView<FInventoryKey>& Keys, const UFaerieItem* Item);
 
-	// The client has to manually rebuild its cell after a removal, as the item's shape is likely lost.
+	// Rebuild all cells from GridContent, for when cells cannot be updated incrementally.
 	void RebuildOccupiedCells();
 
+	// Re-mark the cells of a single replicated stack on the client.
+	void UpdateReplicatedStackCells(const FFaerieGridKeyedStack& Stack);
+
 	// Gets a shape from a shape token on the item, or returns a single cell at 0,0 for items with no token.
 	FFaerieGridShape GetItemShape_Impl(const UFaerieItem* Item) const;
 
+	// Gets the cached compiled shape for an item. Items with no token use a single cell. Invalid items return an empty shape.
+	const Faerie::FCompiledGridShape& GetCompiledShape_Impl(const UFaerieItem* Item) const;
+
 public:
 	bool CanAddItemToGrid(const FFaerieGridShapeConstView& Shape) const;
+	bool CanAddItemToGrid(const UFaerieItem* Item) const;
 
 	// Gets the normalized shape for an item.
 	UFUNCTION(BlueprintCallable, Category = "Faerie|SpatialGrid")
@@ -65,6 +73,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|SpatialGrid")
 	bool CanAddAtLocation(const FFaerieGridShape& Shape, FIntPoint Position) const;
 
+	/**
+	 * Repacks every stack on the grid to close up fragmented space, placing the largest shapes first. All placements
+	 * change in the same frame, so clients receive them as one update.
+	 * @param TimeBudgetMs Maximum time to spend packing. Zero or less means no limit.
+	 * @return False if the stacks could not all be packed in time, in which case nothing is changed.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Faerie|SpatialGrid")
+	bool AutoArrange(float TimeBudgetMs = 2.f);
+
 protected:
 	using FExclusionSet = TSet<FIntPoint>;
 
@@ -75,6 +92,13 @@ protected:
 	FExclusionSet MakeExclusionSet(const TConstArrayView<FInventoryKey> ExcludedKeys) const;
 
 	FFaerieGridPlacement FindFirstEmptyLocation(const FFaerieGridShapeConstView& Shape) const;
+	FFaerieGridPlacement FindFirstEmptyLocation(const UFaerieItem* Item) const;
+
+	// Allocation-free scan using precompiled row masks. Shape must be valid.
+	FFaerieGridPlacement FindFirstEmptyLocation(const Faerie::FCompiledGridShape& Shape) const;
+
+	// Fallback scan for shapes that cannot be compiled into masks.
+	FFaerieGridPlacement FindFirstEmptyLocation_Points(const FFaerieGridShapeConstView& Shape) const;
 
 	bool FitsInGrid(const FFaerieGridShapeConstView& TranslatedShape, const FExclusionSet& ExclusionSet) const;
 
@@ -86,6 +110,6 @@ protected:
 
 	bool MoveSingleItem(const FInventoryKey Key, FFaerieGridPlacement& Placement, const FIntPoint& NewPosition);
 
-	void AddItemPosition(const FFaerieGridShapeConstView TranslatedShape);
+	void AddItemPosition(const FInventoryKey& Key, const FFaerieGridShapeConstView TranslatedShape);
 	void RemoveItemPosition(const FFaerieGridShapeConstView& TranslatedShape);
 };
\ No newline at end of file
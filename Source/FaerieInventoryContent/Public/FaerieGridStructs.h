@@ -85,6 +85,8 @@ private:
 	TWeakObjectPtr<UInventoryGridExtensionBase> ChangeListener;
 
 public:
+	int32 Num() const { return Items.Num(); }
+
 	template <typename Predicate>
 	const FFaerieGridKeyedStack* FindByPredicate(Predicate Pred) const
 	{
@@ -128,6 +130,26 @@ public:
 
 	void Remove(FInventoryKey Key);
 
+	// Remove the stack for this key, calling Pred on it first. Only the removed ReplicationID is sent to clients.
+	template <typename Predicate>
+	bool Remove(const FInventoryKey Key, Predicate Pred)
+	{
+		int32 RemovedID = INDEX_NONE;
+
+		if (BSOA::Remove(Key,
+			[&Pred, &RemovedID](const FFaerieGridKeyedStack& Stack)
+			{
+				Pred(Stack);
+				RemovedID = Stack.ReplicationID;
+			}))
+		{
+			// Notify clients of this removal.
+			Faerie::Hacks::MarkItemsRemoved(*this, Items, MakeArrayView(&RemovedID, 1));
+			return true;
+		}
+		return false;
+	}
+
 	// Only const iteration is allowed.
 	using TRangedForConstIterator = TArray<FFaerieGridKeyedStack>::RangedForConstIteratorType;
 	FORCEINLINE TRangedForConstIterator begin() const { return TRangedForConstIterator(Items.begin()); }
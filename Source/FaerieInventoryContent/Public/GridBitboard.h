@@ -0,0 +1,112 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "FaerieGridEnums.h"
+
+struct FFaerieGridShape;
+struct FFaerieGridShapeConstView;
+
+namespace Faerie
+{
+	/*
+	 * A shape in one rotation, packed into one 64-bit mask per row. Bit X of a row is the cell at Min.X + X.
+	 * Shapes wider than 64 cells cannot be packed, and produce an invalid mask.
+	 */
+	struct FAERIEINVENTORYCONTENT_API FGridShapeMask
+	{
+		// Offset of the mask's top-left corner from the placement origin.
+		FIntPoint Min = FIntPoint::ZeroValue;
+
+		// Width and height of the mask in cells.
+		FIntPoint Size = FIntPoint::ZeroValue;
+
+		// Top-left most cell of the mask, as an offset from the placement origin. Used to align the mask with a free
+		// cell when scanning for a placement.
+		FIntPoint FirstPoint = FIntPoint::ZeroValue;
+
+		TArray<uint64, TInlineAllocator<8>> Rows;
+
+		bool IsValid() const { return !Rows.IsEmpty(); }
+
+		static FGridShapeMask Make(const FFaerieGridShapeConstView& Shape);
+	};
+
+	/*
+	 * A shape precompiled into a mask for each rotation, as they would be placed by UInventorySpatialGridExtension.
+	 * Compiling allocates, but testing a compiled shape against a FGridBitboard does not.
+	 */
+	struct FAERIEINVENTORYCONTENT_API FCompiledGridShape
+	{
+		FCompiledGridShape() = default;
+		explicit FCompiledGridShape(const FFaerieGridShapeConstView& Shape);
+
+		// Symmetrical shapes only need to test the unrotated mask.
+		bool bSymmetrical = true;
+
+		FGridShapeMask Masks[static_cast<uint8>(ESpatialItemRotation::MAX)];
+
+		bool IsValid() const;
+
+		const FGridShapeMask& GetMask(const ESpatialItemRotation Rotation) const
+		{
+			check(Rotation < ESpatialItemRotation::MAX);
+			return Masks[static_cast<uint8>(Rotation)];
+		}
+
+		// Get a compiled 1x1 shape, used for items without a shape token.
+		static const FCompiledGridShape& SingleCell();
+	};
+
+	/*
+	 * Cell occupancy for a 2D grid, stored as rows of 64-bit words.
+	 */
+	class FAERIEINVENTORYCONTENT_API FGridBitboard
+	{
+	public:
+		void Init(FIntPoint NewSize);
+		void Resize(FIntPoint NewSize);
+		void Reset();
+		void ClearAll();
+
+		FIntPoint GetSize() const { return Size; }
+
+		bool IsValidCell(const FIntPoint& Point) const
+		{
+			return Point.X >= 0 && Point.Y >= 0 && Point.X < Size.X && Point.Y < Size.Y;
+		}
+
+		bool Get(const FIntPoint& Point) const
+		{
+			if (!IsValidCell(Point)) return false;
+			return (Words[WordIndex(Point)] & BitMask(Point.X)) != 0;
+		}
+
+		void Set(const FIntPoint& Point, const bool Value)
+		{
+			if (!IsValidCell(Point)) return;
+			if (Value)
+			{
+				Words[WordIndex(Point)] |= BitMask(Point.X);
+			}
+			else
+			{
+				Words[WordIndex(Point)] &= ~BitMask(Point.X);
+			}
+		}
+
+		// Does this mask, placed at Origin, lie entirely within the grid without touching any occupied cell.
+		bool Fits(const FGridShapeMask& Mask, const FIntPoint& Origin) const;
+
+		// Mark every cell of this mask, placed at Origin, as occupied. The mask must fit, see Fits.
+		void Occupy(const FGridShapeMask& Mask, const FIntPoint& Origin);
+
+	private:
+		int32 WordIndex(const FIntPoint& Point) const { return Point.Y * WordsPerRow + (Point.X >> 6); }
+		static uint64 BitMask(const int32 X) { return uint64(1) << (X & 63); }
+
+		FIntPoint Size = FIntPoint::ZeroValue;
+		int32 WordsPerRow = 0;
+		TArray<uint64> Words;
+	};
+}
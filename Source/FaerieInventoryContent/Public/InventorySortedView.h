@@ -0,0 +1,81 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "FaerieItemDataComparator.h"
+#include "InventoryDataStructs.h"
+
+class UFaerieItemStorage;
+struct FFaerieStorageChangeSet;
+
+namespace Faerie
+{
+	/**
+	 * A sorted and filtered list of the stacks in a storage, updated from key notifications instead of re-queried.
+	 * The sort rule projects each entry into a sort key once, when it is added or updated. Positions are then found by
+	 * binary search over the cached keys, without calling the comparator or creating proxies.
+	 * The stacks of one entry share its sort key, and are kept together in stack order.
+	 */
+	class FAERIEINVENTORYCONTENT_API FInventorySortedView
+	{
+	public:
+		using FFilter = TDelegate<bool(FFaerieItemStackView)>;
+
+		// Can this comparator be used to sort a view? Views without a sort rule are kept in key order.
+		static bool SupportsSortRule(const UFaerieItemDataComparator* SortRule);
+
+		// Rebuild the view from every entry in the storage.
+		void Reset(const UFaerieItemStorage* InStorage, const FFilter& InFilter, const UFaerieItemDataComparator* InSortRule, bool InReverse);
+
+		// Empty the view, and release the storage.
+		void Clear();
+
+		void AddEntry(FEntryKey Key);
+		void UpdateEntry(FEntryKey Key);
+
+		// Remove an entry from the view. Can optionally return the keys of the stacks that were in the view.
+		void RemoveEntry(FEntryKey Key, TArray<FInventoryKey>* OutRemovedKeys = nullptr);
+
+		// Apply a batch of storage changes.
+		void ApplyChanges(const FFaerieStorageChangeSet& Changes);
+
+		int32 Num() const { return Rows.Num(); }
+
+		FInventoryKey GetKeyAt(const int32 Index) const { return Rows[Index].Key; }
+
+		// Get the position of a key in the view, or INDEX_NONE, if it's not in the view.
+		int32 IndexOf(FInventoryKey Key) const;
+
+		// Get the keys in a range of the view, clamped to its bounds. Lets lists only read the rows they display.
+		void GetWindow(int32 First, int32 Count, TArray<FInventoryKey>& OutKeys) const;
+
+		void GetAllKeys(TArray<FInventoryKey>& OutKeys) const;
+
+	private:
+		struct FRow
+		{
+			FFaerieItemSortKey SortKey;
+			FInventoryKey Key;
+		};
+
+		// Strict ordering of rows. Ties on sort key are broken by inventory key, so every row has a single position.
+		bool RowLess(const FFaerieItemSortKey& SortKeyA, FInventoryKey A, const FFaerieItemSortKey& SortKeyB, FInventoryKey B) const;
+
+		int32 LowerBound(const FFaerieItemSortKey& SortKey, FInventoryKey Key) const;
+
+		FFaerieItemSortKey MakeSortKey(FFaerieItemStackView View) const;
+
+		void InsertRows(FEntryKey Key, const FInventoryEntry& Entry, const FFaerieItemSortKey& SortKey);
+		void RemoveRows(FEntryKey Key, const FFaerieItemSortKey& SortKey, TArray<FInventoryKey>* OutRemovedKeys);
+
+		TWeakObjectPtr<const UFaerieItemStorage> Storage;
+		FFilter Filter;
+		TWeakObjectPtr<const UFaerieItemDataComparator> SortRule;
+		bool Reverse = false;
+
+		TArray<FRow> Rows;
+
+		// The sort key of each entry in the view, used to find its rows again when it changes.
+		TMap<FEntryKey, FFaerieItemSortKey> EntrySortKeys;
+	};
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "FaerieItemToken.h"
+#include "GridBitboard.h"
 #include "SpatialTypes.h"
 #include "FaerieShapeToken.generated.h"
 
@@ -17,9 +18,22 @@ class FAERIEINVENTORYCONTENT_API UFaerieShapeToken : public UFaerieItemToken
 public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	const FFaerieGridShape& GetShape() const { return Shape; }
 
+	// Get the shape precompiled into per-rotation row masks. Compiled on first use, then cached.
+	const Faerie::FCompiledGridShape& GetCompiledShape() const;
+
 protected:
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Replicated, meta = (ShowOnlyInnerProperties))
+	UFUNCTION(/* Replication */)
+	void OnRep_Shape();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = "OnRep_Shape", meta = (ShowOnlyInnerProperties))
 	FFaerieGridShape Shape;
+
+private:
+	mutable TOptional<Faerie::FCompiledGridShape> CompiledShape;
 };
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include "Blueprint/UserWidget.h"
 #include "FaerieItemStorage.h"
+#include "FaerieItemDataFilterProgram.h"
+#include "InventorySortedView.h"
 #include "InventoryContentsBase.generated.h"
 
 class UFaerieInventoryClient;
@@ -35,6 +37,15 @@ private:
 	bool ExecFilter(const FFaerieItemProxy& Entry);
 	bool ExecSort(const FFaerieItemProxy& A, const FFaerieItemProxy& B);
 
+	bool ExecFilterView(FFaerieItemStackView Entry);
+	bool ExecSortView(FFaerieItemStackView A, FFaerieItemStackView B);
+
+	// Can the current filter and sort be run without creating proxies for each entry?
+	bool CanQueryByView() const;
+
+	// Can the display order be kept by the live sorted view, instead of re-querying the storage?
+	bool CanUseSortedView() const;
+
 protected:
 	virtual void NativeEntryAdded(UFaerieItemStorage* Storage, FEntryKey Key);
 	virtual void NativeEntryUpdated(UFaerieItemStorage* Storage, FEntryKey Key);
@@ -76,6 +87,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory Contents|Display")
 	void ResetSort(bool bResort = true);
 
+	// Get the number of keys in the display order.
+	UFUNCTION(BlueprintPure, Category = "Inventory Contents|Display")
+	int32 GetNumSortedKeys() const;
+
+	// Get a range of keys from the display order. Lists over large storages can use this to only read visible rows.
+	UFUNCTION(BlueprintCallable, Category = "Inventory Contents|Display")
+	TArray<FInventoryKey> GetSortedKeysInRange(int32 First, int32 Count) const;
+
 protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Inventory Contents|Display")
 	void OnInitWithInventory();
@@ -112,6 +131,11 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Config")
 	bool bAlwaysAddNewToSortOrder = true;
 
+	// Don't copy the display order into SortedAndFilteredKeys each time it changes. Enable for very large storages, and
+	// read rows with GetSortedKeysInRange instead. Only applies while the sort and filter rules support the live view.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Config")
+	bool bVirtualizeSortedKeys = false;
+
 
 	/// ***		RUNTIME		*** ///
 
@@ -138,6 +162,24 @@ protected:
 private:
 	Faerie::FStorageQuery Query;
 
+	// Proxy-free mirror of Query. Used whenever the filter and sort rules don't need proxies.
+	Faerie::FStorageViewQuery ViewQuery;
+
+	// Set when a Blueprint filter delegate is in use, as those are always given proxies.
+	bool FilterNeedsProxy = false;
+
+	// ActiveFilterRule, compiled whenever it is set.
+	Faerie::ItemData::FFilterProgram ActiveFilterProgram;
+
+	// Keeps the display order up to date from storage notifications, when the filter and sort rules allow it.
+	Faerie::FInventorySortedView SortedView;
+
+	// Is SortedView being used for the current display order?
+	bool UsingSortedView = false;
+
+	// Set when SortedView has changed since SortedAndFilteredKeys was last copied from it.
+	bool SortedViewChanged = false;
+
 	bool NeedsResort = false;
 	bool NeedsReconstructEntries = false;
 };
\ No newline at end of file
@@ -38,104 +38,310 @@ namespace Faerie::Hash
 		return OutHash;
 	}
 
-	uint32 HashFProperty(const void* Ptr, const FProperty* Property)
+	namespace Private
 	{
-		if (Property->IsA<FBoolProperty>())
-		{
-			return GetTypeHash(*Property->ContainerPtrToValuePtr<bool>(Ptr)); // GetTypeHash is deterministic for scalars
-		}
-		if (Property->IsA<FByteProperty>() || Property->IsA<FEnumProperty>())
-		{
-			return GetTypeHash(*Property->ContainerPtrToValuePtr<uint8>(Ptr)); // GetTypeHash is deterministic for scalars
-		}
-		if (Property->IsA<FIntProperty>())
-		{
-			return GetTypeHash(*Property->ContainerPtrToValuePtr<int32>(Ptr)); // GetTypeHash is deterministic for scalars
-		}
-		if (Property->IsA<FInt64Property>())
-		{
-			return GetTypeHash(*Property->ContainerPtrToValuePtr<int64>(Ptr)); // GetTypeHash is deterministic for scalars
-		}
-		if (Property->IsA<FFloatProperty>())
-		{
-			return GetTypeHash(*Property->ContainerPtrToValuePtr<float>(Ptr)); // GetTypeHash is deterministic for scalars
-		}
-		if (Property->IsA<FDoubleProperty>())
-		{
-			return GetTypeHash(*Property->ContainerPtrToValuePtr<double>(Ptr)); // GetTypeHash is deterministic for scalars
-		}
-		if (Property->IsA<FNameProperty>())
+		// Returned for unset optionals.
+		static constexpr uint32 UnsetOptionalHash = 21294577;
+
+		enum class EHashOp : uint8
 		{
-			return TextKeyUtil::HashString(Property->ContainerPtrToValuePtr<FName>(Ptr)->ToString());
-		}
-		if (Property->IsA<FStrProperty>())
+			Unsupported,
+			Bool,
+			Int8,
+			Int16,
+			Int32,
+			Int64,
+			UInt8,
+			UInt16,
+			UInt32,
+			UInt64,
+			Float,
+			Double,
+			Name,
+			Str,
+			Text,
+			Struct,
+			Optional,
+			Array,
+			Set,
+			Map
+		};
+
+		struct FHashPlan;
+
+		/*
+		 * A single step in a hash plan. Hashes one value found at Offset from the container.
+		 */
+		struct FHashOp
 		{
-			return TextKeyUtil::HashString(*Property->ContainerPtrToValuePtr<FString>(Ptr));
-		}
-		if (Property->IsA<FTextProperty>())
+			EHashOp Kind = EHashOp::Unsupported;
+			int32 Offset = 0;
+
+			// Only needed by ops that can't be resolved from the offset alone.
+			const FProperty* Property = nullptr;
+
+			// Struct ops. Null if the struct contains itself, in which case the plan is found when hashing.
+			TSharedPtr<const FHashPlan> StructPlan;
+			const UScriptStruct* Struct = nullptr;
+
+			// Element op for arrays, sets, and optionals. Key and value ops for maps. Offsets are always 0.
+			TArray<FHashOp> Inner;
+		};
+
+		/*
+		 * A flat list of ops that hashes every property of a struct or class, built once per type.
+		 */
+		struct FHashPlan
 		{
-			return TextKeyUtil::HashString(Property->ContainerPtrToValuePtr<FText>(Ptr)->BuildSourceString());
-		}
-		if (const FStructProperty* AsStruct = CastField<FStructProperty>(Property))
+			TArray<FHashOp> Ops;
+		};
+
+		TSharedRef<const FHashPlan> FindOrBuildPlan(const UStruct* Struct, bool IncludeSuper);
+
+		// Structs currently being built on this thread, used to catch structs that contain themselves through a container.
+		static thread_local TArray<const UStruct*, TInlineAllocator<8>> PlansInProgress;
+
+		static FHashOp MakeOp(const FProperty* Property, const int32 Offset)
 		{
-			return HashStructByProps(AsStruct->ContainerPtrToValuePtr<void>(Ptr), AsStruct->Struct, true);
+			FHashOp Op;
+			Op.Offset = Offset;
+			Op.Property = Property;
+
+			if (Property->IsA<FBoolProperty>())
+			{
+				Op.Kind = EHashOp::Bool;
+			}
+			else if (const FEnumProperty* AsEnum = CastField<FEnumProperty>(Property))
+			{
+				// Enums hash as their underlying integer.
+				Op.Kind = MakeOp(AsEnum->GetUnderlyingProperty(), Offset).Kind;
+			}
+			else if (Property->IsA<FByteProperty>())		Op.Kind = EHashOp::UInt8;
+			else if (Property->IsA<FInt8Property>())		Op.Kind = EHashOp::Int8;
+			else if (Property->IsA<FInt16Property>())		Op.Kind = EHashOp::Int16;
+			else if (Property->IsA<FIntProperty>())			Op.Kind = EHashOp::Int32;
+			else if (Property->IsA<FInt64Property>())		Op.Kind = EHashOp::Int64;
+			else if (Property->IsA<FUInt16Property>())		Op.Kind = EHashOp::UInt16;
+			else if (Property->IsA<FUInt32Property>())		Op.Kind = EHashOp::UInt32;
+			else if (Property->IsA<FUInt64Property>())		Op.Kind = EHashOp::UInt64;
+			else if (Property->IsA<FFloatProperty>())		Op.Kind = EHashOp::Float;
+			else if (Property->IsA<FDoubleProperty>())		Op.Kind = EHashOp::Double;
+			else if (Property->IsA<FNameProperty>())		Op.Kind = EHashOp::Name;
+			else if (Property->IsA<FStrProperty>())			Op.Kind = EHashOp::Str;
+			else if (Property->IsA<FTextProperty>())		Op.Kind = EHashOp::Text;
+			else if (const FStructProperty* AsStruct = CastField<FStructProperty>(Property))
+			{
+				Op.Kind = EHashOp::Struct;
+				Op.Struct = AsStruct->Struct;
+				if (!PlansInProgress.Contains(AsStruct->Struct))
+				{
+					Op.StructPlan = FindOrBuildPlan(AsStruct->Struct, true);
+				}
+			}
+			else if (const FOptionalProperty* AsOptional = CastField<FOptionalProperty>(Property))
+			{
+				Op.Kind = EHashOp::Optional;
+				Op.Inner.Add(MakeOp(AsOptional->GetValueProperty(), 0));
+			}
+			else if (const FArrayProperty* AsArray = CastField<FArrayProperty>(Property))
+			{
+				Op.Kind = EHashOp::Array;
+				Op.Inner.Add(MakeOp(AsArray->Inner, 0));
+			}
+			else if (const FSetProperty* AsSet = CastField<FSetProperty>(Property))
+			{
+				Op.Kind = EHashOp::Set;
+				Op.Inner.Add(MakeOp(AsSet->ElementProp, 0));
+			}
+			else if (const FMapProperty* AsMap = CastField<FMapProperty>(Property))
+			{
+				Op.Kind = EHashOp::Map;
+				Op.Inner.Add(MakeOp(AsMap->KeyProp, 0));
+				Op.Inner.Add(MakeOp(AsMap->ValueProp, 0));
+			}
+			else
+			{
+				ensureMsgf(false, TEXT("Hashing properties of type '%s' is not supported. '%s' will be ignored."),
+					*Property->GetClass()->GetName(), *Property->GetName());
+			}
+
+			return Op;
 		}
-		if (const FArrayProperty* AsArray = CastField<FArrayProperty>(Property))
+
+		static TSharedRef<const FHashPlan> BuildPlan(const UStruct* Struct, const bool IncludeSuper)
 		{
-			unimplemented();
-			return 0;
+			TSharedRef<FHashPlan> Plan = MakeShared<FHashPlan>();
+
+			for (TFieldIterator<FProperty> PropIt(Struct, IncludeSuper ? EFieldIterationFlags::IncludeSuper : EFieldIterationFlags::None); PropIt; ++PropIt)
+			{
+				// Only the first element of a static array is hashed. Hashes are stored in assets and save data, so this
+				// can't change without invalidating them.
+				const FProperty* Property = *PropIt;
+				Plan->Ops.Add(MakeOp(Property, Property->GetOffset_ForInternal()));
+			}
+
+			return Plan;
 		}
-		if (const FSetProperty* AsSet = CastField<FSetProperty>(Property))
+
+		static FRWLock PlanLock;
+		static TMap<TObjectKey<UStruct>, TSharedRef<const FHashPlan>> PlanCache[2];
+
+		TSharedRef<const FHashPlan> FindOrBuildPlan(const UStruct* Struct, const bool IncludeSuper)
 		{
-			unimplemented();
-			return 0;
+			auto& Cache = PlanCache[IncludeSuper];
+
+			{
+				FReadScopeLock ReadLock(PlanLock);
+				if (const TSharedRef<const FHashPlan>* Found = Cache.Find(Struct))
+				{
+					return *Found;
+				}
+			}
+
+			PlansInProgress.Push(Struct);
+			TSharedRef<const FHashPlan> Plan = BuildPlan(Struct, IncludeSuper);
+			PlansInProgress.Pop(EAllowShrinking::No);
+
+#if WITH_EDITOR
+			// Blueprint and user defined types can change layout in the editor, so only native types are cached.
+			for (const UStruct* Outer = Struct; Outer; Outer = Outer->GetSuperStruct())
+			{
+				if (!Outer->IsNative())
+				{
+					return Plan;
+				}
+			}
+#endif
+
+			FWriteScopeLock WriteLock(PlanLock);
+			return Cache.FindOrAdd(Struct, Plan);
 		}
-		if (const FMapProperty* AsMap = CastField<FMapProperty>(Property))
+
+		static uint32 ExecutePlan(const FHashPlan& Plan, const void* Container);
+
+		static uint32 HashName(const FName& Name)
 		{
-			unimplemented();
-			return 0;
+			// Hashed as a string, so hashes are stable between sessions, but built on the stack to avoid allocating.
+			TStringBuilder<FName::StringBufferSize> Builder;
+			Name.AppendString(Builder);
+			return TextKeyUtil::HashString(Builder.GetData(), Builder.Len());
 		}
-		if (const FOptionalProperty* AsOptional = CastField<FOptionalProperty>(Property))
+
+		static uint32 ExecuteOp(const FHashOp& Op, const void* Value)
 		{
-			if (!AsOptional->IsSet(AsOptional->ContainerPtrToValuePtr<void>(Ptr)))
+			switch (Op.Kind)
 			{
-				return 21294577;
+			// GetTypeHash is deterministic for scalars
+			// Bools are read as a whole byte, which for bitfields is the byte holding the bit. Kept for stored hashes.
+			case EHashOp::Bool:		return GetTypeHash(*static_cast<const bool*>(Value));
+			case EHashOp::Int8:		return GetTypeHash(*static_cast<const int8*>(Value));
+			case EHashOp::Int16:	return GetTypeHash(*static_cast<const int16*>(Value));
+			case EHashOp::Int32:	return GetTypeHash(*static_cast<const int32*>(Value));
+			case EHashOp::Int64:	return GetTypeHash(*static_cast<const int64*>(Value));
+			case EHashOp::UInt8:	return GetTypeHash(*static_cast<const uint8*>(Value));
+			case EHashOp::UInt16:	return GetTypeHash(*static_cast<const uint16*>(Value));
+			case EHashOp::UInt32:	return GetTypeHash(*static_cast<const uint32*>(Value));
+			case EHashOp::UInt64:	return GetTypeHash(*static_cast<const uint64*>(Value));
+			case EHashOp::Float:	return GetTypeHash(*static_cast<const float*>(Value));
+			case EHashOp::Double:	return GetTypeHash(*static_cast<const double*>(Value));
+			case EHashOp::Name:		return HashName(*static_cast<const FName*>(Value));
+			case EHashOp::Str:		return TextKeyUtil::HashString(*static_cast<const FString*>(Value));
+			// Text still has to build its source string, as it may be formatted from other text.
+			case EHashOp::Text:		return TextKeyUtil::HashString(static_cast<const FText*>(Value)->BuildSourceString());
+			case EHashOp::Struct:
+				if (Op.StructPlan.IsValid())
+				{
+					return ExecutePlan(*Op.StructPlan, Value);
+				}
+				return ExecutePlan(*FindOrBuildPlan(Op.Struct, true), Value);
+			case EHashOp::Optional:
+				{
+					const FOptionalProperty* AsOptional = static_cast<const FOptionalProperty*>(Op.Property);
+					if (!AsOptional->IsSet(Value))
+					{
+						return UnsetOptionalHash;
+					}
+					return ExecuteOp(Op.Inner[0], AsOptional->GetValuePointerForReadIfSet(Value));
+				}
+			case EHashOp::Array:
+				{
+					// Arrays are ordered, so elements are chained.
+					FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Op.Property), Value);
+					uint32 Hash = GetTypeHash(Helper.Num());
+					for (int32 i = 0; i < Helper.Num(); ++i)
+					{
+						Hash = Combine(ExecuteOp(Op.Inner[0], Helper.GetRawPtr(i)), Hash);
+					}
+					return Hash;
+				}
+			case EHashOp::Set:
+				{
+					// Set order depends on insertion order, so elements are summed instead.
+					FScriptSetHelper Helper(static_cast<const FSetProperty*>(Op.Property), Value);
+					uint32 Sum = 0;
+					for (int32 i = 0, Count = Helper.Num(); Count; ++i)
+					{
+						if (Helper.IsValidIndex(i))
+						{
+							Sum += ExecuteOp(Op.Inner[0], Helper.GetElementPtr(i));
+							--Count;
+						}
+					}
+					return Combine(Sum, GetTypeHash(Helper.Num()));
+				}
+			case EHashOp::Map:
+				{
+					// Map order depends on insertion order, so pairs are summed instead.
+					FScriptMapHelper Helper(static_cast<const FMapProperty*>(Op.Property), Value);
+					uint32 Sum = 0;
+					for (int32 i = 0, Count = Helper.Num(); Count; ++i)
+					{
+						if (Helper.IsValidIndex(i))
+						{
+							Sum += Combine(ExecuteOp(Op.Inner[0], Helper.GetKeyPtr(i)), ExecuteOp(Op.Inner[1], Helper.GetValuePtr(i)));
+							--Count;
+						}
+					}
+					return Combine(Sum, GetTypeHash(Helper.Num()));
+				}
+			case EHashOp::Unsupported:
+			default:
+				return 0;
 			}
-
-			return HashFProperty(Ptr, AsOptional->GetValueProperty());
 		}
 
-		unimplemented(); // What can hit this?
-		return 0;
-	}
-
-	template <typename T>
-	uint32 HashProps(const T* Container, const UStruct* Struct, const bool IncludeSuper)
-	{
-		uint32 Hash = 0;
-
-		for (TFieldIterator<FProperty> PropIt(Struct, IncludeSuper ? EFieldIterationFlags::IncludeSuper : EFieldIterationFlags::None); PropIt; ++PropIt)
+		static uint32 ExecutePlan(const FHashPlan& Plan, const void* Container)
 		{
-			if (const FProperty* Property = *PropIt)
+			uint32 Hash = 0;
+
+			for (const FHashOp& Op : Plan.Ops)
 			{
-				Hash = Combine(HashFProperty(Container, Property), Hash);
+				Hash = Combine(ExecuteOp(Op, static_cast<const uint8*>(Container) + Op.Offset), Hash);
 			}
+
+			return Hash;
 		}
+	}
 
-		return Hash;
+	uint32 HashFProperty(const void* Ptr, const FProperty* Property)
+	{
+		check(Ptr);
+		check(Property);
+		const Private::FHashOp Op = Private::MakeOp(Property, 0);
+		return Private::ExecuteOp(Op, Property->ContainerPtrToValuePtr<void>(Ptr));
 	}
 
 	uint32 HashStructByProps(const void* Ptr, const UScriptStruct* Struct, const bool IncludeSuper)
 	{
 		check(Ptr);
 		check(Struct);
-		return HashProps(Ptr, Struct, IncludeSuper);
+		return Private::ExecutePlan(*Private::FindOrBuildPlan(Struct, IncludeSuper), Ptr);
 	}
 
 	uint32 HashObjectByProps(const UObject* Obj, const bool IncludeSuper)
 	{
 		check(Obj);
-		return HashProps(Obj, Obj->GetClass(), IncludeSuper);
+		return Private::ExecutePlan(*Private::FindOrBuildPlan(Obj->GetClass(), IncludeSuper), Obj);
 	}
 
 	FFaerieHash HashItemSet(const TSet<const UFaerieItem*>& Items,
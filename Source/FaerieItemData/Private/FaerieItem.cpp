@@ -2,6 +2,7 @@
 
 #include "FaerieItem.h"
 #include "FaerieItemToken.h"
+#include "Algo/BinarySearch.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "UObject/ObjectSaveContext.h"
@@ -33,8 +34,41 @@ void UFaerieItem::PostLoad()
 {
 	Super::PostLoad();
 	CacheTokenMutability();
+	RebuildTokenLookup();
 }
 
+void UFaerieItem::PostDuplicate(const EDuplicateMode::Type DuplicateMode)
+{
+	Super::PostDuplicate(DuplicateMode);
+	RebuildTokenLookup();
+}
+
+void UFaerieItem::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// Archives that load items outside a package, such as save data read with Flakes, don't call PostLoad. The lookup
+	// only needs each token's class, which is known even if the token itself is still loading.
+	if (Ar.IsLoading())
+	{
+		RebuildTokenLookup();
+	}
+}
+
+#if WITH_EDITOR
+void UFaerieItem::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	RebuildTokenLookup();
+}
+
+void UFaerieItem::PostEditUndo()
+{
+	Super::PostEditUndo();
+	RebuildTokenLookup();
+}
+#endif
+
 void UFaerieItem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -62,14 +96,11 @@ void UFaerieItem::ForEachToken(const TFunctionRef<bool(const UFaerieItemToken*)>
 
 void UFaerieItem::ForEachTokenOfClass(const TFunctionRef<bool(const UFaerieItemToken*)>& Iter, const TSubclassOf<UFaerieItemToken> Class) const
 {
-	for (auto&& Token : Tokens)
+	for (const UFaerieItemToken* Token : GetTokensView(Class))
 	{
-		if (IsValid(Token) && Token->IsA(Class))
+		if (!Iter(Token))
 		{
-			if (!Iter(Token))
-			{
-				return;
-			}
+			return;
 		}
 	}
 }
@@ -104,18 +135,20 @@ const UFaerieItemToken* UFaerieItem::GetToken(const TSubclassOf<UFaerieItemToken
 		return nullptr;
 	}
 
-	for (auto&& Token : Tokens)
+	if (const FTokenClassRange* Range = FindTokenClassRange(Class))
 	{
-		if (IsValid(Token) && Token.IsA(Class))
-		{
-			return Token;
-		}
+		return TokensByClass[Range->Start];
 	}
 
 	return nullptr;
 }
 
 TArray<const UFaerieItemToken*> UFaerieItem::GetTokens(const TSubclassOf<UFaerieItemToken> Class) const
+{
+	return TArray<const UFaerieItemToken*>(GetTokensView(Class));
+}
+
+TConstArrayView<const UFaerieItemToken*> UFaerieItem::GetTokensView(const TSubclassOf<UFaerieItemToken> Class) const
 {
 	if (!ensure(IsValid(Class)))
 	{
@@ -127,15 +160,12 @@ TArray<const UFaerieItemToken*> UFaerieItem::GetTokens(const TSubclassOf<UFaerie
 		return {};
 	}
 
-	TArray<const UFaerieItemToken*> OutTokens;
-
-	Algo::CopyIf(Tokens, OutTokens,
-		[Class](const UFaerieItemToken* Token)
-		{
-			return IsValid(Token) && Token->IsA(Class);
-		});
+	if (const FTokenClassRange* Range = FindTokenClassRange(Class))
+	{
+		return TConstArrayView<const UFaerieItemToken*>(TokensByClass.GetData() + Range->Start, Range->Num);
+	}
 
-	return OutTokens;
+	return {};
 }
 
 UFaerieItemToken* UFaerieItem::GetMutableToken(const TSubclassOf<UFaerieItemToken> Class)
@@ -147,12 +177,9 @@ UFaerieItemToken* UFaerieItem::GetMutableToken(const TSubclassOf<UFaerieItemToke
 		return {};
 	}
 
-	for (auto&& Token : Tokens)
+	if (const FTokenClassRange* Range = FindTokenClassRange(Class))
 	{
-		if (IsValid(Token) && Token.IsA(Class))
-		{
-			return Token;
-		}
+		return const_cast<UFaerieItemToken*>(TokensByClass[Range->Start]);
 	}
 
 	return nullptr;
@@ -167,15 +194,7 @@ TArray<UFaerieItemToken*> UFaerieItem::GetMutableTokens(const TSubclassOf<UFaeri
 		return {};
 	}
 
-	TArray<UFaerieItemToken*> OutTokens;
-
-	Algo::CopyIf(Tokens, OutTokens,
-		[Class](const UFaerieItemToken* Token)
-		{
-			return IsValid(Token) && Token->IsA(Class);
-		});
-
-	return OutTokens;
+	return Type::Cast<TArray<UFaerieItemToken*>>(TArray<const UFaerieItemToken*>(GetTokensView(Class)));
 }
 
 bool UFaerieItem::Compare(const UFaerieItem* A, const UFaerieItem* B)
@@ -243,6 +262,20 @@ bool UFaerieItem::CompareWith(const UFaerieItem* Other) const
 	return true;
 }
 
+uint32 UFaerieItem::GetContentHash() const
+{
+	// CompareWith matches tokens by class regardless of their order, so token hashes are summed instead of combined.
+	uint32 Hash = Tokens.Num();
+	for (auto&& Token : Tokens)
+	{
+		if (IsValid(Token))
+		{
+			Hash += Token->GetCompareHash();
+		}
+	}
+	return Hash;
+}
+
 bool UFaerieItem::FindToken(const TSubclassOf<UFaerieItemToken> Class, UFaerieItemToken*& FoundToken) const
 {
 	if (!IsValid(Class))
@@ -290,6 +323,7 @@ void UFaerieItem::AddToken(UFaerieItemToken* Token)
 	Tokens.Add(Token);
 
 	CacheTokenMutability();
+	RebuildTokenLookup();
 }
 
 bool UFaerieItem::RemoveToken(UFaerieItemToken* Token)
@@ -307,6 +341,7 @@ bool UFaerieItem::RemoveToken(UFaerieItemToken* Token)
 	if (!!Tokens.Remove(Token))
 	{
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Tokens, this);
+		RebuildTokenLookup();
 
 		LastModified = FDateTime::UtcNow();
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, LastModified, this);
@@ -341,6 +376,7 @@ int32 UFaerieItem::RemoveTokensByClass(const TSubclassOf<UFaerieItemToken> Class
 		}))
 	{
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Tokens, this);
+		RebuildTokenLookup();
 
 		LastModified = FDateTime::UtcNow();
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, LastModified, this);
@@ -391,4 +427,56 @@ void UFaerieItem::CacheTokenMutability()
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, MutabilityFlags, this);
 		EnumRemoveFlags(MutabilityFlags, EFaerieItemMutabilityFlags::TokenMutability);
 	}
-}
\ No newline at end of file
+}
+
+void UFaerieItem::RebuildTokenLookup()
+{
+	TokenClassRanges.Reset();
+	TokensByClass.Reset();
+
+	// Gather the class of each token, and all parents up to the base token class, which cannot be queried.
+	for (auto&& Token : Tokens)
+	{
+		if (!IsValid(Token)) continue;
+
+		for (const UClass* Class = Token->GetClass(); Class && Class != UFaerieItemToken::StaticClass(); Class = Class->GetSuperClass())
+		{
+			if (!TokenClassRanges.ContainsByPredicate([Class](const FTokenClassRange& Range) { return Range.Class == Class; }))
+			{
+				TokenClassRanges.Add({ Class, 0, 0 });
+			}
+		}
+	}
+
+	TokenClassRanges.Sort([](const FTokenClassRange& A, const FTokenClassRange& B) { return A.Class < B.Class; });
+
+	// Group tokens by class, keeping the order they are in Tokens.
+	for (FTokenClassRange& Range : TokenClassRanges)
+	{
+		Range.Start = TokensByClass.Num();
+		for (auto&& Token : Tokens)
+		{
+			if (IsValid(Token) && Token->IsA(Range.Class))
+			{
+				TokensByClass.Add(Token);
+			}
+		}
+		Range.Num = TokensByClass.Num() - Range.Start;
+	}
+
+	TokenLookupNum = Tokens.Num();
+}
+
+void UFaerieItem::OnRep_Tokens()
+{
+	RebuildTokenLookup();
+}
+
+const UFaerieItem::FTokenClassRange* UFaerieItem::FindTokenClassRange(const UClass* Class) const
+{
+	// Lookups never rebuild the table, as they may be made from several threads at once.
+	ensureMsgf(TokenLookupNum == Tokens.Num(), TEXT("Tokens on '%s' were changed without rebuilding the token lookup!"), *GetName());
+
+	const int32 Index = Algo::BinarySearchBy(TokenClassRanges, Class, &FTokenClassRange::Class);
+	return Index != INDEX_NONE ? &TokenClassRanges[Index] : nullptr;
+}
@@ -28,6 +28,7 @@ void UFaerieItemAsset::PreSave(FObjectPreSaveContext SaveContext)
 	{
 		Item->Tokens.Add(DuplicateObject(Token, Item));
 	}
+	Item->RebuildTokenLookup();
 #endif
 
 	Super::PreSave(SaveContext);
@@ -91,6 +92,12 @@ bool UFaerieItemAsset::CanBeMutable() const
 	return false;
 }
 
+bool UFaerieItemAsset::IsDeterministic() const
+{
+	// Immutable items are never duplicated, so every instance is the same object.
+	return IsValid(Item) && !Item->IsDataMutable();
+}
+
 FFaerieAssetInfo UFaerieItemAsset::GetSourceInfo() const
 {
 	if (!IsValidChecked(Item)) return FFaerieAssetInfo();
@@ -0,0 +1,24 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieItemDataComparator.h"
+#include "FaerieItemDataProxy.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FaerieItemDataComparator)
+
+bool UFaerieItemDataComparator::ExecView(const FFaerieItemStackView A, const FFaerieItemStackView B) const
+{
+	// Comparators that only implement Exec are given proxies of the views. This is slow, as it creates two objects per
+	// comparison, so comparators that can read views directly should override this.
+	const UFaerieItemDataStackLiteral* LiteralA = UFaerieItemDataStackLiteral::CreateItemDataStackLiteral(
+		FFaerieItemStack(const_cast<UFaerieItem*>(A.Item.Get()), A.Copies));
+	const UFaerieItemDataStackLiteral* LiteralB = UFaerieItemDataStackLiteral::CreateItemDataStackLiteral(
+		FFaerieItemStack(const_cast<UFaerieItem*>(B.Item.Get()), B.Copies));
+	return Exec(LiteralA, LiteralB);
+}
+
+FFaerieItemSortKey UFaerieItemDataComparator::MakeSortKey(const FFaerieItemStackView View) const
+{
+	// Comparators that can't make keys give every item the same one. Sorted views then keep these items in key order,
+	// the same as a view without a sort rule.
+	return FFaerieItemSortKey();
+}
@@ -0,0 +1,368 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieItemDataFilterProgram.h"
+#include "FaerieItemDataFilter.h"
+
+namespace Faerie::ItemData
+{
+	static EItemDataMutabilityStatus MakeMutabilityStatus(const bool Mutable)
+	{
+		return Mutable ? EItemDataMutabilityStatus::KnownMutable : EItemDataMutabilityStatus::KnownImmutable;
+	}
+
+	const UFaerieItemToken* FFilterContext::FindToken(const TSubclassOf<UFaerieItemToken> Class)
+	{
+		for (auto&& Cached : TokenCache)
+		{
+			if (Cached.Key == Class.Get())
+			{
+				return Cached.Value;
+			}
+		}
+
+		const UFaerieItemToken* Token = IsValid(Item) ? Item->GetToken(Class) : nullptr;
+		TokenCache.Emplace(Class.Get(), Token);
+		return Token;
+	}
+
+	FFilterProgram FFilterProgram::Compile(const UFaerieItemDataFilter* Rule, const EItemDataMutabilityStatus KnownMutability)
+	{
+		FFilterProgram Program;
+		FFilterCompiler Compiler(Program, KnownMutability);
+		Compiler.Emit(Rule);
+		return Program;
+	}
+
+	bool FFilterProgram::IsConstant(bool& OutResult) const
+	{
+		if (Ops.Num() == 1 && Ops[0].Type == EFilterOp::Constant)
+		{
+			OutResult = Ops[0].Value;
+			return true;
+		}
+		return false;
+	}
+
+	bool FFilterProgram::Exec(const FFaerieItemStackView View) const
+	{
+		FFilterContext Context(View);
+		return Run(Context);
+	}
+
+	void FFilterProgram::ExecBatch(const TConstArrayView<FFaerieItemStackView> Views, TBitArray<>& OutResults) const
+	{
+		if (bool Value; IsConstant(Value))
+		{
+			OutResults.Init(Value, Views.Num());
+			return;
+		}
+
+		OutResults.Init(false, Views.Num());
+		for (int32 i = 0; i < Views.Num(); ++i)
+		{
+			FFilterContext Context(Views[i]);
+			if (Run(Context))
+			{
+				OutResults[i] = true;
+			}
+		}
+	}
+
+	bool FFilterProgram::ExecAll(const TConstArrayView<FFaerieItemStackView> Views) const
+	{
+		if (bool Value; IsConstant(Value))
+		{
+			return Value || Views.IsEmpty();
+		}
+
+		for (const FFaerieItemStackView& View : Views)
+		{
+			FFilterContext Context(View);
+			if (!Run(Context))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool FFilterProgram::Run(FFilterContext& Context) const
+	{
+		bool Result = false;
+
+		const int32 NumOps = Ops.Num();
+		for (int32 i = 0; i < NumOps;)
+		{
+			const FFilterOp& Op = Ops[i];
+			switch (Op.Type)
+			{
+			case EFilterOp::Constant:
+				Result = Op.Value;
+				break;
+			case EFilterOp::Mutability:
+				Result = IsValid(Context.Item) && Context.Item->IsDataMutable() == Op.Value;
+				break;
+			case EFilterOp::Predicate:
+				Result = Predicates[Op.Operand](Context);
+				break;
+			case EFilterOp::Rule:
+				Result = Rules[Op.Operand]->Exec(Context.View);
+				break;
+			case EFilterOp::Not:
+				Result = !Result;
+				break;
+			case EFilterOp::Jump:
+				i = Op.Operand;
+				continue;
+			case EFilterOp::JumpIfFalse:
+				if (!Result)
+				{
+					i = Op.Operand;
+					continue;
+				}
+				break;
+			case EFilterOp::JumpIfTrue:
+				if (Result)
+				{
+					i = Op.Operand;
+					continue;
+				}
+				break;
+			default:
+				checkNoEntry();
+			}
+
+			++i;
+		}
+
+		return Result;
+	}
+
+	void FFilterCompiler::Emit(const UFaerieItemDataFilter* Rule)
+	{
+		if (IsValid(Rule))
+		{
+			Rule->Compile(*this);
+		}
+		else
+		{
+			EmitConstant(false);
+		}
+	}
+
+	void FFilterCompiler::EmitConstant(const bool Value)
+	{
+		Program.Ops.Add({EFilterOp::Constant, Value});
+	}
+
+	void FFilterCompiler::EmitMutabilityTest(const bool RequireMutable)
+	{
+		switch (AssumedMutability)
+		{
+		case EItemDataMutabilityStatus::KnownMutable:
+			EmitConstant(RequireMutable);
+			break;
+		case EItemDataMutabilityStatus::KnownImmutable:
+			EmitConstant(!RequireMutable);
+			break;
+		default:
+			Program.Ops.Add({EFilterOp::Mutability, RequireMutable});
+		}
+	}
+
+	void FFilterCompiler::EmitPredicate(FFilterPredicate&& Predicate)
+	{
+		Program.Ops.Add({EFilterOp::Predicate, false, Program.Predicates.Add(MoveTemp(Predicate))});
+	}
+
+	void FFilterCompiler::EmitRuleCall(const UFaerieItemDataFilter* Rule)
+	{
+		if (!IsValid(Rule))
+		{
+			EmitConstant(false);
+			return;
+		}
+
+		Program.Ops.Add({EFilterOp::Rule, false, Program.Rules.Add(Rule)});
+	}
+
+	void FFilterCompiler::EmitAll(const TConstArrayView<TObjectPtr<UFaerieItemDataFilter>> Rules)
+	{
+		TGuardValue<EItemDataMutabilityStatus> MutabilityGuard(AssumedMutability, AssumedMutability);
+
+		const int32 Start = Num();
+		TArray<int32, TInlineAllocator<8>> Exits;
+
+		for (const TObjectPtr<UFaerieItemDataFilter>& Rule : Rules)
+		{
+			const int32 RuleStart = Num();
+			Emit(Rule);
+
+			if (bool Value; IsConstantSince(RuleStart, Value))
+			{
+				Truncate(RuleStart);
+				if (!Value)
+				{
+					// One rule always fails, so the others don't matter.
+					Truncate(Start);
+					EmitConstant(false);
+					return;
+				}
+				continue;
+			}
+
+			// Rules after a mutability test only see stacks that passed it.
+			if (bool RequireMutable; IsMutabilityTestSince(RuleStart, RequireMutable))
+			{
+				AssumedMutability = MakeMutabilityStatus(RequireMutable);
+			}
+
+			Exits.Add(EmitJump(EFilterOp::JumpIfFalse));
+		}
+
+		if (Exits.IsEmpty())
+		{
+			EmitConstant(true);
+			return;
+		}
+
+		// The last rule's result is the result of the group, so it doesn't need to jump.
+		Truncate(Exits.Pop());
+		for (const int32 Exit : Exits)
+		{
+			PatchJump(Exit);
+		}
+	}
+
+	void FFilterCompiler::EmitAny(const TConstArrayView<TObjectPtr<UFaerieItemDataFilter>> Rules)
+	{
+		TGuardValue<EItemDataMutabilityStatus> MutabilityGuard(AssumedMutability, AssumedMutability);
+
+		const int32 Start = Num();
+		TArray<int32, TInlineAllocator<8>> Exits;
+
+		for (const TObjectPtr<UFaerieItemDataFilter>& Rule : Rules)
+		{
+			const int32 RuleStart = Num();
+			Emit(Rule);
+
+			if (bool Value; IsConstantSince(RuleStart, Value))
+			{
+				Truncate(RuleStart);
+				if (Value)
+				{
+					// One rule always passes, so the others don't matter.
+					Truncate(Start);
+					EmitConstant(true);
+					return;
+				}
+				continue;
+			}
+
+			// Rules after a failed mutability test learn nothing: the test also fails for invalid items.
+			Exits.Add(EmitJump(EFilterOp::JumpIfTrue));
+		}
+
+		if (Exits.IsEmpty())
+		{
+			EmitConstant(false);
+			return;
+		}
+
+		Truncate(Exits.Pop());
+		for (const int32 Exit : Exits)
+		{
+			PatchJump(Exit);
+		}
+	}
+
+	void FFilterCompiler::EmitNot(const UFaerieItemDataFilter* Rule)
+	{
+		const int32 Start = Num();
+		Emit(Rule);
+
+		if (bool Value; IsConstantSince(Start, Value))
+		{
+			Truncate(Start);
+			EmitConstant(!Value);
+			return;
+		}
+
+		// A mutability test is not inverted into the opposite test, as both fail for invalid items.
+		Program.Ops.Add({EFilterOp::Not});
+	}
+
+	void FFilterCompiler::EmitSelect(const UFaerieItemDataFilter* Condition,
+		const TFunctionRef<void(FFilterCompiler&)> EmitTrue, const TFunctionRef<void(FFilterCompiler&)> EmitFalse)
+	{
+		const int32 Start = Num();
+		Emit(Condition);
+
+		if (bool Value; IsConstantSince(Start, Value))
+		{
+			// Only one branch can ever run.
+			Truncate(Start);
+			if (Value)
+			{
+				EmitTrue(*this);
+			}
+			else
+			{
+				EmitFalse(*this);
+			}
+			return;
+		}
+
+		bool RequireMutable = false;
+		const bool IsMutabilityTest = IsMutabilityTestSince(Start, RequireMutable);
+
+		const int32 ElseJump = EmitJump(EFilterOp::JumpIfFalse);
+		{
+			TGuardValue<EItemDataMutabilityStatus> MutabilityGuard(AssumedMutability,
+				IsMutabilityTest ? MakeMutabilityStatus(RequireMutable) : AssumedMutability);
+			EmitTrue(*this);
+		}
+
+		const int32 EndJump = EmitJump(EFilterOp::Jump);
+		PatchJump(ElseJump);
+
+		// Stacks that failed a mutability test may just be invalid, so nothing new is known about them.
+		EmitFalse(*this);
+		PatchJump(EndJump);
+	}
+
+	bool FFilterCompiler::IsConstantSince(const int32 Start, bool& OutValue) const
+	{
+		if (Num() - Start == 1 && Program.Ops[Start].Type == EFilterOp::Constant)
+		{
+			OutValue = Program.Ops[Start].Value;
+			return true;
+		}
+		return false;
+	}
+
+	bool FFilterCompiler::IsMutabilityTestSince(const int32 Start, bool& OutRequireMutable) const
+	{
+		if (Num() - Start == 1 && Program.Ops[Start].Type == EFilterOp::Mutability)
+		{
+			OutRequireMutable = Program.Ops[Start].Value;
+			return true;
+		}
+		return false;
+	}
+
+	void FFilterCompiler::Truncate(const int32 Start)
+	{
+		Program.Ops.SetNum(Start, EAllowShrinking::No);
+	}
+
+	int32 FFilterCompiler::EmitJump(const EFilterOp Type)
+	{
+		return Program.Ops.Add({Type});
+	}
+
+	void FFilterCompiler::PatchJump(const int32 Index)
+	{
+		Program.Ops[Index].Operand = Num();
+	}
+}
@@ -15,6 +15,11 @@ bool UFaerieItemToken::CompareWithImpl(const UFaerieItemToken* Other) const
 	return true;
 }
 
+uint32 UFaerieItemToken::GetCompareHashImpl() const
+{
+	return 0;
+}
+
 bool UFaerieItemToken::IsOuterItemMutable() const
 {
 	auto&& OuterItem = GetOuterItem();
@@ -49,6 +54,11 @@ bool UFaerieItemToken::CompareWith(const UFaerieItemToken* Other) const
 	return CompareWithImpl(Other);
 }
 
+uint32 UFaerieItemToken::GetCompareHash() const
+{
+	return HashCombineFast(GetTypeHash(GetClass()), GetCompareHashImpl());
+}
+
 void UFaerieItemToken::EditToken(const TFunctionRef<bool(UFaerieItemToken*)>& EditFunc)
 {
 	if (EditFunc(this))
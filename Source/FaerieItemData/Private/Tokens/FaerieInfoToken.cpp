@@ -27,6 +27,12 @@ bool UFaerieInfoToken::CompareWithImpl(const UFaerieItemToken* Other) const
 	return true;
 }
 
+uint32 UFaerieInfoToken::GetCompareHashImpl() const
+{
+	// Identical texts always share a display string, so hashing it is safe for CompareWithImpl.
+	return GetTypeHash(Info.ObjectName.ToString());
+}
+
 const FFaerieAssetInfo& UFaerieInfoToken::GetAssetInfo() const
 {
 	return Info;
@@ -18,6 +18,8 @@ namespace Faerie::Hash
 	// Get the hash of a FProperty's value on a specific object
 	FAERIEITEMDATA_API [[nodiscard]] uint32 HashFProperty(const void* Ptr, const FProperty* Property);
 
+	// Hash all properties of a struct or object. The properties of each type are compiled into a plan the first time
+	// it is hashed, so later calls do not walk reflection data.
 	FAERIEITEMDATA_API [[nodiscard]] uint32 HashStructByProps(const void* Ptr, const UScriptStruct* Struct, bool IncludeSuper);
 	FAERIEITEMDATA_API [[nodiscard]] uint32 HashObjectByProps(const UObject* Obj, bool IncludeSuper);
 
@@ -40,6 +40,12 @@ class FAERIEITEMDATA_API UFaerieItem : public UNetSupportedObject
 public:
 	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
 	virtual void PostLoad() override;
+	virtual void PostDuplicate(EDuplicateMode::Type DuplicateMode) override;
+	virtual void Serialize(FArchive& Ar) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
+#endif
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	// Iterates over each contained token. Return true in the delegate to continue iterating.
@@ -55,14 +61,11 @@ public:
 	>
 	void ForEachToken(const TFunctionRef<bool(const TFaerieItemToken*)>& Iter) const
 	{
-		for (auto&& Token : Tokens)
+		for (const TFaerieItemToken* Token : GetTokensView<TFaerieItemToken>())
 		{
-			if (IsValid(Token) && Token->IsA<TFaerieItemToken>())
+			if (!Iter(Token))
 			{
-				if (!Iter(Cast<TFaerieItemToken>(Token)))
-				{
-					return;
-				}
+				return;
 			}
 		}
 	}
@@ -77,6 +80,10 @@ public:
 
 	const UFaerieItemToken* GetToken(TSubclassOf<UFaerieItemToken> Class) const;
 	TArray<const UFaerieItemToken*> GetTokens(TSubclassOf<UFaerieItemToken> Class) const;
+
+	// Get all tokens of a class without allocating. The view is invalidated when tokens are added or removed.
+	TConstArrayView<const UFaerieItemToken*> GetTokensView(TSubclassOf<UFaerieItemToken> Class) const;
+
 	UFaerieItemToken* GetMutableToken(TSubclassOf<UFaerieItemToken> Class);
 	TArray<UFaerieItemToken*> GetMutableTokens(TSubclassOf<UFaerieItemToken> Class);
 
@@ -98,6 +105,15 @@ public:
 		return Type::Cast<TArray<const TFaerieItemToken*>>(GetTokens(TFaerieItemToken::StaticClass()));
 	}
 
+	template <
+		typename TFaerieItemToken
+		UE_REQUIRES(TIsDerivedFrom<TFaerieItemToken, UFaerieItemToken>::Value)
+	>
+	TConstArrayView<const TFaerieItemToken*> GetTokensView() const
+	{
+		return Type::Cast<TConstArrayView<const TFaerieItemToken*>>(GetTokensView(TFaerieItemToken::StaticClass()));
+	}
+
 	template <
 		typename TFaerieItemToken
 		UE_REQUIRES(TIsDerivedFrom<TFaerieItemToken, UFaerieItemToken>::Value)
@@ -119,6 +135,11 @@ public:
 	static bool Compare(const UFaerieItem* A, const UFaerieItem* B);
 	bool CompareWith(const UFaerieItem* Other) const;
 
+	// Get an order-independent hash of this item's tokens. Items that pass CompareWith are guaranteed to have the same
+	// content hash, so this can be used to bucket items before comparing them. Only meaningful for data-immutable items,
+	// and only stable for the lifetime of the process.
+	uint32 GetContentHash() const;
+
 protected:
 	// @todo this isn't const safe
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "FaerieItem", meta = (DeterminesOutputType = Class, DynamicOutputParam = FoundToken, ExpandBoolAsExecs = ReturnValue))
@@ -154,11 +175,27 @@ protected:
 
 	void CacheTokenMutability();
 
+	// Rebuilds the lookup table from token class to tokens. Must be called whenever Tokens is changed.
+	void RebuildTokenLookup();
+
+	UFUNCTION()
+	void OnRep_Tokens();
+
+private:
+	struct FTokenClassRange
+	{
+		const UClass* Class;
+		int32 Start;
+		int32 Num;
+	};
+
+	const FTokenClassRange* FindTokenClassRange(const UClass* Class) const;
+
 public:
 	FNotifyOwnerOfSelfMutation& GetNotifyOwnerOfSelfMutation() { return NotifyOwnerOfSelfMutation; }
 
 protected:
-	UPROPERTY(Replicated, VisibleInstanceOnly, Category = "FaerieItem")
+	UPROPERTY(ReplicatedUsing = "OnRep_Tokens", VisibleInstanceOnly, Category = "FaerieItem")
 	TArray<TObjectPtr<UFaerieItemToken>> Tokens;
 
 	// Keeps track of the last time this item was modified. Allows, for example, sorting items by recently touched.
@@ -174,4 +211,15 @@ protected:
 
 	// Delegate for owners to bind to, for detecting when tokens are mutated outside their knowledge
 	FNotifyOwnerOfSelfMutation NotifyOwnerOfSelfMutation;
+
+private:
+	// Every class (and parent class) of our tokens, sorted by pointer, with the range of TokensByClass that holds
+	// the tokens of that class.
+	TArray<FTokenClassRange, TInlineAllocator<8>> TokenClassRanges;
+
+	// Tokens grouped by class for TokenClassRanges. Tokens appear once for each class in their hierarchy.
+	TArray<const UFaerieItemToken*, TInlineAllocator<8>> TokensByClass;
+
+	// Number of tokens when the lookup was last built. Used to catch Tokens changing without a rebuild.
+	int32 TokenLookupNum = 0;
 };
\ No newline at end of file
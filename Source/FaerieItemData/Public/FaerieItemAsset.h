@@ -28,6 +28,7 @@ public:
 
 	//~ IFaerieItemSource
 	virtual bool CanBeMutable() const override;
+	virtual bool IsDeterministic() const override;
 	virtual FFaerieAssetInfo GetSourceInfo() const override;
 	virtual UFaerieItem* CreateItemInstance(UObject* Outer) const override;
 	//~ IFaerieItemSource
@@ -4,8 +4,32 @@
 
 #include "UObject/Object.h"
 #include "FaerieItemProxy.h"
+#include "FaerieItemStackView.h"
 #include "FaerieItemDataComparator.generated.h"
 
+/**
+ * A value that items are ordered by, so that a comparator's work can be done once per item, instead of once per
+ * comparison. Ordered by Number, then by Text.
+ */
+struct FFaerieItemSortKey
+{
+	int64 Number = 0;
+	FString Text;
+
+	friend bool operator<(const FFaerieItemSortKey& A, const FFaerieItemSortKey& B)
+	{
+		if (A.Number != B.Number)
+		{
+			return A.Number < B.Number;
+		}
+		return A.Text < B.Text;
+	}
+
+	friend bool operator==(const FFaerieItemSortKey& A, const FFaerieItemSortKey& B)
+	{
+		return A.Number == B.Number && A.Text == B.Text;
+	}
+};
 
 /**
  * Compares two item proxies. Used to create sorting functionality.
@@ -18,6 +42,22 @@ class FAERIEITEMDATA_API UFaerieItemDataComparator : public UObject
 public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|ItemDataComparator")
 	virtual bool Exec(FFaerieItemProxy A, FFaerieItemProxy B) const PURE_VIRTUAL(UFaerieItemDataComparator::Exec, return false; )
+
+	// Can this comparator run on stack views, without proxies? Comparators that only read item data should return true
+	// and implement ExecView, which allows storage queries to sort without creating proxy objects.
+	virtual bool SupportsStackViews() const { return false; }
+
+	// Compares two stack views. The default wraps the views in proxies and calls Exec, so it is always safe to call, but
+	// only cheap if SupportsStackViews returns true.
+	virtual bool ExecView(FFaerieItemStackView A, FFaerieItemStackView B) const;
+
+	// Can this comparator project items into sort keys? Comparators that return true must implement MakeSortKey, and
+	// the keys must order items the same way that ExecView does. Lets sorted views cache one key per item.
+	virtual bool SupportsSortKeys() const { return false; }
+
+	// Project a stack view into the key it is sorted by. The default returns the same empty key for every item, so only
+	// comparators that return true from SupportsSortKeys give a meaningful order.
+	virtual FFaerieItemSortKey MakeSortKey(FFaerieItemStackView View) const;
 };
 
 /*
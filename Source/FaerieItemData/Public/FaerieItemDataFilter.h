@@ -9,6 +9,8 @@
 
 namespace Faerie::ItemData
 {
+	class FFilterCompiler;
+
 	class FFilterLogger
 	{
 	public:
@@ -37,6 +39,10 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Faerie|ItemDataFilter")
 	virtual bool Exec(FFaerieItemStackView View) const PURE_VIRTUAL(UFaerieItemDataFilter::Exec, return false; )
+
+	// Emit this rule into a filter program (see FaerieItemDataFilterProgram.h). By default, the program calls Exec.
+	// Rules that override this must emit ops that give the same result as Exec.
+	virtual void Compile(Faerie::ItemData::FFilterCompiler& Compiler) const;
 };
 
 USTRUCT(BlueprintType)
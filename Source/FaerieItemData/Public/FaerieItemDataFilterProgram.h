@@ -0,0 +1,163 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "FaerieItemStackView.h"
+#include "FaerieItemDataTypes.h"
+#include "Templates/SubclassOf.h"
+
+class UFaerieItemDataFilter;
+class UFaerieItemToken;
+
+namespace Faerie::ItemData
+{
+	/**
+	 * The state of a filter program while it runs on one stack. Token lookups are resolved once, and shared by every
+	 * op that asks for the same class.
+	 */
+	class FAERIEITEMDATA_API FFilterContext
+	{
+	public:
+		explicit FFilterContext(const FFaerieItemStackView View)
+		  : View(View),
+			Item(View.Item.Get()) {}
+
+		const FFaerieItemStackView View;
+
+		// The view's item, resolved once for every op.
+		const UFaerieItem* const Item;
+
+		const UFaerieItemToken* FindToken(TSubclassOf<UFaerieItemToken> Class);
+
+		template <typename TFaerieItemToken>
+		const TFaerieItemToken* FindToken()
+		{
+			return static_cast<const TFaerieItemToken*>(FindToken(TFaerieItemToken::StaticClass()));
+		}
+
+	private:
+		TArray<TPair<const UClass*, const UFaerieItemToken*>, TInlineAllocator<4>> TokenCache;
+	};
+
+	using FFilterPredicate = TFunction<bool(FFilterContext&)>;
+
+	enum class EFilterOp : uint8
+	{
+		// Result = Value
+		Constant,
+
+		// Result = Item->IsDataMutable() == Value
+		Mutability,
+
+		// Result = Predicates[Operand](Context)
+		Predicate,
+
+		// Result = Rules[Operand]->Exec(View). Used for rules that don't compile themselves.
+		Rule,
+
+		// Result = !Result
+		Not,
+
+		// Continue at Operand
+		Jump,
+		JumpIfFalse,
+		JumpIfTrue,
+	};
+
+	struct FFilterOp
+	{
+		EFilterOp Type;
+		bool Value = false;
+		int32 Operand = INDEX_NONE;
+	};
+
+	/**
+	 * A filter rule tree flattened into a list of ops with a single result register. Logical rules become jumps, so
+	 * evaluation is a loop over the ops instead of a virtual call per node.
+	 * Rules that are called by the program are not owned by it. Whoever compiled it must keep the rule tree alive.
+	 */
+	class FAERIEITEMDATA_API FFilterProgram
+	{
+		friend class FFilterCompiler;
+
+	public:
+		// Compile a rule tree. Invalid rules compile to a program that fails everything.
+		static FFilterProgram Compile(const UFaerieItemDataFilter* Rule,
+			EItemDataMutabilityStatus KnownMutability = EItemDataMutabilityStatus::Unknown);
+
+		bool IsEmpty() const { return Ops.IsEmpty(); }
+
+		// Does this program return the same result for every stack? If so, returns that result in OutResult.
+		bool IsConstant(bool& OutResult) const;
+
+		bool Exec(FFaerieItemStackView View) const;
+
+		// Run the program on each view. OutResults is reset, and will have one bit per view.
+		void ExecBatch(TConstArrayView<FFaerieItemStackView> Views, TBitArray<>& OutResults) const;
+
+		// Run the program on each view, stopping at the first failure. Returns true if every view passed.
+		bool ExecAll(TConstArrayView<FFaerieItemStackView> Views) const;
+
+	private:
+		bool Run(FFilterContext& Context) const;
+
+		TArray<FFilterOp> Ops;
+		TArray<FFilterPredicate> Predicates;
+		TArray<const UFaerieItemDataFilter*> Rules;
+	};
+
+	/**
+	 * Builds a filter program. Rules implement UFaerieItemDataFilter::Compile by calling the Emit functions. Children
+	 * that turn out to be constant are folded into their parents, and mutability tests that are already decided by an
+	 * earlier test that passed along a branch are folded away.
+	 */
+	class FAERIEITEMDATA_API FFilterCompiler
+	{
+	public:
+		explicit FFilterCompiler(FFilterProgram& Program, const EItemDataMutabilityStatus KnownMutability = EItemDataMutabilityStatus::Unknown)
+		  : Program(Program), AssumedMutability(KnownMutability) {}
+
+		// What is known about the mutability of stacks that reach the op being emitted.
+		EItemDataMutabilityStatus GetAssumedMutability() const { return AssumedMutability; }
+
+		// Compile a child rule. Missing rules fail.
+		void Emit(const UFaerieItemDataFilter* Rule);
+
+		void EmitConstant(bool Value);
+		void EmitMutabilityTest(bool RequireMutable);
+		void EmitPredicate(FFilterPredicate&& Predicate);
+
+		// Call Exec on a rule that cannot be compiled into ops.
+		void EmitRuleCall(const UFaerieItemDataFilter* Rule);
+
+		// Passes when all rules pass. Passes when there are no rules.
+		void EmitAll(TConstArrayView<TObjectPtr<UFaerieItemDataFilter>> Rules);
+
+		// Passes when any rule passes. Fails when there are no rules.
+		void EmitAny(TConstArrayView<TObjectPtr<UFaerieItemDataFilter>> Rules);
+
+		void EmitNot(const UFaerieItemDataFilter* Rule);
+
+		// Run one of two branches, depending on the result of a condition.
+		void EmitSelect(const UFaerieItemDataFilter* Condition,
+			TFunctionRef<void(FFilterCompiler&)> EmitTrue, TFunctionRef<void(FFilterCompiler&)> EmitFalse);
+
+	private:
+		int32 Num() const { return Program.Ops.Num(); }
+
+		// Did the ops emitted since Start turn out to be a single constant?
+		bool IsConstantSince(int32 Start, bool& OutValue) const;
+
+		// Did the ops emitted since Start turn out to be a single mutability test?
+		bool IsMutabilityTestSince(int32 Start, bool& OutRequireMutable) const;
+
+		// Discard the ops emitted since Start.
+		void Truncate(int32 Start);
+
+		int32 EmitJump(EFilterOp Type);
+		void PatchJump(int32 Index);
+
+		FFilterProgram& Program;
+		EItemDataMutabilityStatus AssumedMutability;
+	};
+}
@@ -37,6 +37,14 @@ public:
 	// Can this source create mutable items?
 	virtual bool CanBeMutable() const { return false; }
 
+	// Does this source always create the same item, no matter the context? Immutable items from these sources only
+	// need to be created once, however many copies are wanted.
+	virtual bool IsDeterministic() const { return false; }
+
+	// Can CreateItemInstance(Outer) be called from several worker threads at once? It is only called this way for drops
+	// with no squirrel and no slot inputs, so it must create the same items as CreateItemInstance with such a context.
+	virtual bool IsThreadSafe() const { return false; }
+
 	// Allows sources to give info about generation results
 	UFUNCTION(BlueprintCallable, Category = "Faerie|ItemSource")
 	virtual FFaerieAssetInfo GetSourceInfo() const { return FFaerieAssetInfo(); }
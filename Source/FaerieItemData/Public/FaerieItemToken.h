@@ -34,6 +34,13 @@ protected:
 	 */
 	virtual bool CompareWithImpl(const UFaerieItemToken* Other) const;
 
+	/*
+	 * Hash the data considered by CompareWithImpl. Tokens that implement CompareWithImpl should implement this as well,
+	 * so that any two tokens that compare as equal also produce the same hash. The default returns 0, which is always
+	 * safe, but makes every token of a class collide.
+	 */
+	virtual uint32 GetCompareHashImpl() const;
+
 	// Are we in an item that is mutable?
 	bool IsOuterItemMutable() const;
 
@@ -45,6 +52,10 @@ public:
 	// Compare the data of this token to another
 	bool CompareWith(const UFaerieItemToken* Other) const;
 
+	// Get a hash of this token's class and comparable data. Tokens that pass CompareWith will have matching hashes.
+	// Only stable for the lifetime of the process; never save or replicate this value.
+	uint32 GetCompareHash() const;
+
 	void EditToken(const TFunctionRef<bool(UFaerieItemToken*)>& EditFunc);
 
 	template <
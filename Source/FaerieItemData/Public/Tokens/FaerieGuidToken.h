@@ -21,6 +21,11 @@ protected:
 		return CastChecked<ThisClass>(Other)->Guid == Guid;
 	}
 
+	virtual uint32 GetCompareHashImpl() const override
+	{
+		return GetTypeHash(Guid);
+	}
+
 public:
 	const FGuid& GetGuid() const { return Guid; }
 
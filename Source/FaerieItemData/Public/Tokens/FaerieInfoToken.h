@@ -20,6 +20,7 @@ protected:
 	// Info tokens are inherently immutable, and they must be since they are used to identify items.
 	// This doesn't mean that an item *cannot* be renamed, just that if it is, it's considered a separate item.
 	virtual bool CompareWithImpl(const UFaerieItemToken* Other) const override;
+	virtual uint32 GetCompareHashImpl() const override;
 
 public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|InfoToken")
@@ -26,6 +26,17 @@ protected:
 		return CastChecked<ThisClass>(Other)->Tags == Tags;
 	}
 
+	virtual uint32 GetCompareHashImpl() const override
+	{
+		// Container equality ignores tag order, so the hash must as well.
+		uint32 Hash = 0;
+		for (const FGameplayTag& Tag : Tags)
+		{
+			Hash ^= GetTypeHash(Tag);
+		}
+		return Hash;
+	}
+
 public:
 	const FGameplayTagContainer& GetTags() const { return Tags; }
 
@@ -12,6 +12,7 @@ public class FaerieItemGenerator : ModuleRules
             new []
             {
                 "Core",
+                "DeveloperSettings",
                 "GameplayTags"
             }
         );
@@ -0,0 +1,10 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieCraftingSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FaerieCraftingSettings)
+
+FName UFaerieCraftingSettings::GetCategoryName() const
+{
+	return FApp::GetProjectName();
+}
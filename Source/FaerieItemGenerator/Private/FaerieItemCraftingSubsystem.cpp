@@ -2,6 +2,7 @@
 
 #include "FaerieItemCraftingSubsystem.h"
 
+#include "FaerieCraftingSettings.h"
 #include "FaerieItemTemplate.h"
 #include "ItemCraftingConfig.h"
 #include "ItemUpgradeConfig.h"
@@ -12,10 +13,20 @@
 #include "GenerationAction_GenerateItems.h"
 #include "GenerationAction_UpgradeItems.h"
 
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FaerieItemCraftingSubsystem)
 
 DEFINE_LOG_CATEGORY(LogItemGeneratorSubsystem)
 
+DECLARE_STATS_GROUP(TEXT("FaerieItemCrafting"), STATGROUP_FaerieItemCrafting, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending actions"), STAT_Crafting_QueueDepth, STATGROUP_FaerieItemCrafting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Running actions"), STAT_Crafting_Running, STATGROUP_FaerieItemCrafting);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last wait time (ms)"), STAT_Crafting_WaitTime, STATGROUP_FaerieItemCrafting);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last run time (ms)"), STAT_Crafting_RunTime, STATGROUP_FaerieItemCrafting);
+
 void UFaerieItemCraftingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -23,40 +34,176 @@ void UFaerieItemCraftingSubsystem::Initialize(FSubsystemCollectionBase& Collecti
 	Initialized = true;
 }
 
+void UFaerieItemCraftingSubsystem::Deinitialize()
+{
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PreloadTimer);
+	}
+
+	PendingActions.Empty();
+	RunningActions.Empty();
+	RunStartTimes.Empty();
+	UpdateQueueStats();
+
+	Super::Deinitialize();
+}
+
 void UFaerieItemCraftingSubsystem::BeginRunningAction(UCraftingActionBase* Action)
 {
 	check(Action);
-	ActiveAction = Action;
-	ActiveAction->OnCompletedCallback.BindUObject(this, &ThisClass::OnActionCompleted);
-	ActiveAction->Start();
+
+	// Add before starting, as actions may complete synchronously inside Start.
+	RunningActions.Add(Action);
+	RunStartTimes.Add(Action, FPlatformTime::Seconds());
+	UpdateQueueStats();
+
+	Action->OnCompletedCallback.BindUObject(this, &ThisClass::OnActionCompleted, Action);
+	Action->Start();
 }
 
 void UFaerieItemCraftingSubsystem::EnqueueAction_Internal(UCraftingActionBase* NewAction)
 {
-	if (!IsValid(ActiveAction))
+	FPendingAction& Pending = PendingActions.AddDefaulted_GetRef();
+	Pending.Action = TStrongObjectPtr<UCraftingActionBase>(NewAction);
+	Pending.EnqueueTime = FPlatformTime::Seconds();
+
+	// Assets are only preloaded during play. In the editor, actions load synchronously when started.
+	if (const UWorld* World = GetWorld();
+		World && World->HasBegunPlay() && !NewAction->GetAssetsToLoad().IsEmpty())
+	{
+		// Wait until next tick, so that every action submitted this frame shares one load request.
+		if (!PreloadTimer.IsValid())
+		{
+			PreloadTimer = World->GetTimerManager().SetTimerForNextTick(
+				FTimerDelegate::CreateUObject(this, &ThisClass::PreloadPendingAssets));
+		}
+	}
+	else
+	{
+		Pending.PreloadRequested = true;
+	}
+
+	StartPendingActions();
+}
+
+void UFaerieItemCraftingSubsystem::PreloadPendingAssets()
+{
+	PreloadTimer.Invalidate();
+
+	TSet<FSoftObjectPath> Batch;
+
+	// Actions are recorded instead of their pending entries, as the request may complete immediately, and start
+	// actions, which moves the entries around.
+	TSet<const UCraftingActionBase*> Batched;
+
+	for (FPendingAction& Pending : PendingActions)
+	{
+		if (!Pending.PreloadRequested)
+		{
+			// Marked before the request is made, so a load that completes immediately can start the action.
+			Pending.PreloadRequested = true;
+			Batch.Append(Pending.Action->GetAssetsToLoad());
+			Batched.Add(Pending.Action.Get());
+		}
+	}
+
+	if (Batched.IsEmpty())
 	{
-		BeginRunningAction(NewAction);
 		return;
 	}
 
-	PendingActions.Enqueue(TStrongObjectPtr<UCraftingActionBase>(NewAction));
+	UE_LOG(LogItemGeneratorSubsystem, Log, TEXT("Preloading %i assets for %i crafting actions"), Batch.Num(), Batched.Num());
+
+	const TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Batch.Array(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::StartPendingActions));
+
+	for (FPendingAction& Pending : PendingActions)
+	{
+		if (Batched.Contains(Pending.Action.Get()))
+		{
+			Pending.PreloadHandle = Handle;
+		}
+	}
+
+	// The load may already be complete if everything was resident.
+	StartPendingActions();
 }
 
-void UFaerieItemCraftingSubsystem::OnActionCompleted(EGenerationActionResult /*Result*/)
+void UFaerieItemCraftingSubsystem::StartPendingActions()
 {
-	if (!PendingActions.IsEmpty())
+	if (IsStartingActions)
 	{
-		TStrongObjectPtr<UCraftingActionBase> Next;
-		PendingActions.Dequeue(Next);
-		if (Next.IsValid())
+		// An action completed while we were starting others. Run another pass once this one finishes.
+		NeedsStartPass = true;
+		return;
+	}
+
+	TGuardValue<bool> StartingGuard(IsStartingActions, true);
+
+	const int32 MaxConcurrent = FMath::Max(1, GetDefault<UFaerieCraftingSettings>()->MaxConcurrentActions);
+
+	do
+	{
+		NeedsStartPass = false;
+
+		// Executors that already have an action running or waiting ahead of this one.
+		TSet<const UObject*> BlockedExecutors;
+		for (const UCraftingActionBase* Running : RunningActions)
+		{
+			BlockedExecutors.Add(Running->GetExecutor());
+		}
+
+		for (int32 i = 0; i < PendingActions.Num() && RunningActions.Num() < MaxConcurrent; )
 		{
-			BeginRunningAction(Next.Get());
+			FPendingAction& Pending = PendingActions[i];
+			const UObject* Executor = Pending.Action->GetExecutor();
+
+			const bool Loaded = Pending.PreloadRequested &&
+				(!Pending.PreloadHandle.IsValid() || Pending.PreloadHandle->HasLoadCompleted());
+
+			if (!Loaded || BlockedExecutors.Contains(Executor))
+			{
+				BlockedExecutors.Add(Executor);
+				++i;
+				continue;
+			}
+
+			BlockedExecutors.Add(Executor);
+
+			const FPendingAction Next = MoveTemp(Pending);
+			PendingActions.RemoveAt(i);
+
+			SET_FLOAT_STAT(STAT_Crafting_WaitTime, (FPlatformTime::Seconds() - Next.EnqueueTime) * 1000.0);
+
+			if (Next.Action.IsValid())
+			{
+				BeginRunningAction(Next.Action.Get());
+			}
 		}
 	}
-	else
+	while (NeedsStartPass);
+
+	UpdateQueueStats();
+}
+
+void UFaerieItemCraftingSubsystem::OnActionCompleted(EGenerationActionResult /*Result*/, UCraftingActionBase* Action)
+{
+	if (double StartTime;
+		RunStartTimes.RemoveAndCopyValue(Action, StartTime))
 	{
-		ActiveAction = nullptr;
+		SET_FLOAT_STAT(STAT_Crafting_RunTime, (FPlatformTime::Seconds() - StartTime) * 1000.0);
 	}
+
+	RunningActions.Remove(Action);
+
+	StartPendingActions();
+}
+
+void UFaerieItemCraftingSubsystem::UpdateQueueStats() const
+{
+	SET_DWORD_STAT(STAT_Crafting_QueueDepth, PendingActions.Num());
+	SET_DWORD_STAT(STAT_Crafting_Running, RunningActions.Num());
 }
 
 void UFaerieItemCraftingSubsystem::SubmitGenerationRequest(const FGenerationRequest& Request)
@@ -39,6 +39,180 @@ const FTableDrop* FFaerieWeightedDropPool::GetDrop(const double RanWeight) const
 	return &DropList[BinarySearchResult].Drop;
 }
 
+const FTableDrop* FFaerieWeightedDropPool::GetDrop_Seeded(USquirrel* Squirrel) const
+{
+	const int32 Index = GetDropIndex_Seeded(Squirrel);
+	if (Index == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Exiting generation: Empty Table"));
+		return nullptr;
+	}
+	return &DropList[Index].Drop;
+}
+
+int32 FFaerieWeightedDropPool::GetDropIndex_Seeded(USquirrel* Squirrel) const
+{
+	check(Squirrel);
+
+	if (DropList.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	// The roll is always consumed, even when there is only one possible result, so the squirrel advances the same
+	// amount regardless of the table's contents.
+	const double RanWeight = Squirrel->NextReal();
+
+	if (DropList.Num() == 1)
+	{
+		return 0;
+	}
+
+	// Tables modified without rebuilding the alias table fall back to searching.
+	if (AliasProbability.Num() != DropList.Num())
+	{
+		return FMath::Min(Algo::LowerBoundBy(DropList, RanWeight, &FWeightedDrop::AdjustedWeight), DropList.Num() - 1);
+	}
+
+	return SampleAliasTable(RanWeight);
+}
+
+double FFaerieWeightedDropPool::GetDropChance(const int32 Index) const
+{
+	if (!DropList.IsValidIndex(Index))
+	{
+		return 0.0;
+	}
+
+#if WITH_EDITORONLY_DATA
+	return DropList[Index].PercentageChanceToDrop / 100.0;
+#else
+	// AdjustedWeight is cumulative, so each drop's chance is the step from the one before it.
+	const double Previous = Index > 0 ? DropList[Index - 1].AdjustedWeight : 0.0;
+	return DropList[Index].AdjustedWeight - Previous;
+#endif
+}
+
+void FFaerieWeightedDropPool::GenerateDrops(USquirrel* Squirrel, const int32 Num, TArray<int32>& OutIndices) const
+{
+	check(Squirrel);
+
+	if (DropList.IsEmpty() || Num <= 0)
+	{
+		return;
+	}
+
+	const int32 StartIndex = OutIndices.AddUninitialized(Num);
+	int32* Out = OutIndices.GetData() + StartIndex;
+
+	if (DropList.Num() == 1)
+	{
+		// Consume a roll per drop, to match GetDropIndex_Seeded.
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Squirrel->NextReal();
+			Out[i] = 0;
+		}
+		return;
+	}
+
+	if (AliasProbability.Num() != DropList.Num())
+	{
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Out[i] = FMath::Min(Algo::LowerBoundBy(DropList, Squirrel->NextReal(), &FWeightedDrop::AdjustedWeight), DropList.Num() - 1);
+		}
+		return;
+	}
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Out[i] = SampleAliasTable(Squirrel->NextReal());
+	}
+}
+
+int32 FFaerieWeightedDropPool::SampleAliasTable(const double RanWeight) const
+{
+	// A single random value picks both the column, and the side of the column.
+	const int32 Num = AliasProbability.Num();
+	const double Scaled = FMath::Clamp(RanWeight, 0.0, 1.0) * Num;
+	const int32 Column = FMath::Min(static_cast<int32>(Scaled), Num - 1);
+	return (Scaled - Column) < AliasProbability[Column] ? Column : AliasIndex[Column];
+}
+
+void FFaerieWeightedDropPool::BuildAliasTable()
+{
+	const int32 Num = DropList.Num();
+
+	AliasProbability.SetNumUninitialized(Num);
+	AliasIndex.SetNumUninitialized(Num);
+
+	if (Num == 0)
+	{
+		return;
+	}
+
+	// Recover each drop's probability from the cumulative AdjustedWeight.
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(Num);
+
+	double Total = 0.0;
+	double Previous = 0.0;
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Scaled[i] = FMath::Max(DropList[i].AdjustedWeight - Previous, 0.0);
+		Previous = FMath::Max(DropList[i].AdjustedWeight, Previous);
+		Total += Scaled[i];
+	}
+
+	if (Total <= 0.0)
+	{
+		// No usable weights. Fall back to a uniform distribution.
+		for (int32 i = 0; i < Num; ++i)
+		{
+			AliasProbability[i] = 1.0;
+			AliasIndex[i] = i;
+		}
+		return;
+	}
+
+	TArray<int32> Small;
+	TArray<int32> Large;
+	Small.Reserve(Num);
+	Large.Reserve(Num);
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Scaled[i] *= Num / Total;
+		(Scaled[i] < 1.0 ? Small : Large).Add(i);
+	}
+
+	// Vose's method: pair each under-full column with an over-full one that tops it up.
+	while (!Small.IsEmpty() && !Large.IsEmpty())
+	{
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+
+		AliasProbability[Less] = Scaled[Less];
+		AliasIndex[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		(Scaled[More] < 1.0 ? Small : Large).Add(More);
+	}
+
+	// Anything left is full, give or take floating point error.
+	for (const int32 i : Large)
+	{
+		AliasProbability[i] = 1.0;
+		AliasIndex[i] = i;
+	}
+	for (const int32 i : Small)
+	{
+		AliasProbability[i] = 1.0;
+		AliasIndex[i] = i;
+	}
+}
+
 #if WITH_EDITOR
 void FFaerieWeightedDropPool::CalculatePercentages()
 {
@@ -59,6 +233,8 @@ void FFaerieWeightedDropPool::CalculatePercentages()
 		Entry.AdjustedWeight /= WeightSum;
 		Entry.PercentageChanceToDrop = 100.f * (static_cast<float>(Entry.Weight) / static_cast<float>(WeightSum));
 	}
+
+	BuildAliasTable();
 }
 
 void FFaerieWeightedDropPool::SortTable()
@@ -79,6 +255,9 @@ void UFaerieItemPool::PreSave(FObjectPreSaveContext SaveContext)
 #if WITH_EDITOR
 	DropPool.SortTable();
 
+	// Sorting reorders drops, so the cumulative weights must be recalculated before they are saved.
+	DropPool.CalculatePercentages();
+
 	HasMutableDrops = Algo::AnyOf(DropPool.DropList,
 		[](const FWeightedDrop& Drop)
 		{
@@ -93,6 +272,8 @@ void UFaerieItemPool::PostLoad()
 	Super::PostLoad();
 #if WITH_EDITOR
 	DropPool.CalculatePercentages();
+#else
+	DropPool.BuildAliasTable();
 #endif
 }
 
@@ -164,20 +345,14 @@ UFaerieItem* UFaerieItemPool::CreateItemInstance(const UItemInstancingContext* C
 		return nullptr;
 	}
 
-	FTableDrop Drop;
+	// Resolve the drop in place, rather than a copy, so resolvers can cache it across calls.
+	const FTableDrop* Drop = IsValid(CraftingContent->Squirrel)
+		? GetDrop_Seeded(CraftingContent->Squirrel)
+		: GetDrop(FMath::FRand());
 
-	if (IsValid(CraftingContent->Squirrel))
+	if (Drop && Drop->IsValid())
 	{
-		Drop = GenerateDrop(CraftingContent->Squirrel->NextReal());
-	}
-	else
-	{
-		Drop = GenerateDrop(FMath::FRand());
-	}
-
-	if (Drop.IsValid())
-	{
-		return Drop.Resolve(CraftingContent);
+		return Drop->Resolve(CraftingContent);
 	}
 
 	return nullptr;
@@ -190,7 +365,12 @@ const FTableDrop* UFaerieItemPool::GetDrop(const double RanWeight) const
 
 const FTableDrop* UFaerieItemPool::GetDrop_Seeded(USquirrel* Squirrel) const
 {
-	return DropPool.GetDrop(Squirrel->NextReal());
+	return DropPool.GetDrop_Seeded(Squirrel);
+}
+
+void UFaerieItemPool::GenerateDrops(USquirrel* Squirrel, const int32 Num, TArray<int32>& OutIndices) const
+{
+	DropPool.GenerateDrops(Squirrel, Num, OutIndices);
 }
 
 FTableDrop UFaerieItemPool::GenerateDrop(const double RanWeight) const
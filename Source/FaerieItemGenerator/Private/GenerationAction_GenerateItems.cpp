@@ -2,15 +2,22 @@
 
 #include "GenerationAction_GenerateItems.h"
 
+#include "FaerieCraftingSettings.h"
 #include "FaerieItem.h"
 #include "FaerieItemDataProxy.h"
 #include "ItemGeneratorConfig.h"
 #include "ItemInstancingContext_Crafting.h"
+#include "TableDropResolver.h"
+#include "Async/ParallelFor.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GenerationAction_GenerateItems)
 
 #define LOCTEXT_NAMESPACE "GenerationAction_GenerateItems"
 
+DECLARE_STATS_GROUP(TEXT("GenerationAction_GenerateItems"), STATGROUP_GenerateItems, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Generate Mutable (Serial)"), STAT_GenerateItems_Serial, STATGROUP_GenerateItems);
+DECLARE_CYCLE_STAT(TEXT("Generate Mutable (Parallel)"), STAT_GenerateItems_Parallel, STATGROUP_GenerateItems);
+
 void UGenerationAction_GenerateItems::Configure(FActionArgs& Args)
 {
 	check(!Args.Drivers.IsEmpty());
@@ -54,6 +61,16 @@ void UGenerationAction_GenerateItems::Run()
  	UItemInstancingContext_Crafting* Context = NewObject<UItemInstancingContext_Crafting>(this);
 	Context->Outer = Executor;
 
+	// Every drop in this run shares one resolver, so sources are loaded, and instancing objects created, only once.
+	Faerie::Generation::FTableDropResolver Resolver;
+	Context->Resolver = &Resolver;
+
+	// Stacks of immutable items, by item. Generations that resolve to the same immutable item share a stack.
+	TMap<const UFaerieItem*, int32> ImmutableStacks;
+
+	// Items already created by deterministic sources. These only need to be resolved once for the whole run.
+	TMap<const UObject*, UFaerieItem*> DeterministicItems;
+
 	for (auto&& Generation : PendingGenerations)
 	{
 		if (!Generation.IsValid())
@@ -62,42 +79,51 @@ void UGenerationAction_GenerateItems::Run()
 			continue;
 		}
 
+		const UObject* SourceObject = Generation.Drop.Asset.Object.Get();
+		const IFaerieItemSource* Source = Cast<IFaerieItemSource>(SourceObject);
+		if (!Source)
+		{
+			UE_LOG(LogItemGenConfig, Warning, TEXT("--- Generation drop is not a loaded item source!"));
+			continue;
+		}
+
 		// Set the squirrel used for this iteration
 		Context->Squirrel = Generation.Squirrel;
 
 		// Generate individual mutable entries when mutable, as each may be unique.
-		if (Cast<IFaerieItemSource>(Generation.Drop.Asset.Object.Get())->CanBeMutable())
+		if (Source->CanBeMutable())
+		{
+			GenerateMutable(Generation, *Source, Context, ImmutableStacks);
+			continue;
+		}
+
+		// Generate a single entry stack when immutable, as there is no change of uniqueness.
+		UFaerieItem* Item;
+		if (Source->IsDeterministic() && Generation.Drop.StaticResourceSlots.IsEmpty())
 		{
-			for (int32 i = 0; i < Generation.Count; ++i)
+			if (UFaerieItem** Found = DeterministicItems.Find(SourceObject))
 			{
-				FFaerieItemStack NewStack;
-				NewStack.Item = Generation.Drop.Resolve(Context);
-				NewStack.Copies = 1;
-
-				if (IsValid(NewStack.Item))
-				{
-					ProcessStacks.Add(NewStack);
-				}
-				else
-				{
-					UE_LOG(LogGenerationAction, Error, TEXT("FTableDrop::Resolve returned a bad instance! Crafting likely failed"))
-				}
+				Item = *Found;
+			}
+			else
+			{
+				Item = DeterministicItems.Add(SourceObject, Generation.Drop.Resolve(Context));
 			}
 		}
-		// Generate a single entry stack when immutable, as there is no change of uniqueness.
 		else
 		{
-			FFaerieItemStack NewStack;
-			NewStack.Item = Generation.Drop.Resolve(Context);
-			NewStack.Copies = Generation.Count;
+			Item = Generation.Drop.Resolve(Context);
+		}
 
-			if (IsValid(NewStack.Item))
-			{
-				ProcessStacks.Add(NewStack);
-			}
+		if (IsValid(Item))
+		{
+			AddGeneratedStack(Item, Generation.Count, ImmutableStacks);
 		}
 	}
 
+	// The resolver doesn't outlive this function, but the context might.
+	Context->Resolver = nullptr;
+
 	if (!ProcessStacks.IsEmpty())
 	{
 		UE_LOG(LogItemGenConfig, Log, TEXT("--- Generation success. Created '%i' stack(s)."), ProcessStacks.Num());
@@ -110,4 +136,73 @@ void UGenerationAction_GenerateItems::Run()
 	}
 }
 
+void UGenerationAction_GenerateItems::GenerateMutable(const FPendingItemGeneration& Generation,
+													  const IFaerieItemSource& Source,
+													  UItemInstancingContext_Crafting* Context,
+													  TMap<const UFaerieItem*, int32>& ImmutableStacks)
+{
+	TArray<UFaerieItem*> Items;
+	Items.SetNumZeroed(Generation.Count);
+
+	// Seeded generations draw from one squirrel in order, and static resource slots are resolved through the run's
+	// resolver, so both stay on the game thread. Without either, Drop.Resolve only passes the outer to the source, so
+	// thread-safe sources can be called with it directly, and nothing is shared between copies.
+	const int32 Threshold = GetDefault<UFaerieCraftingSettings>()->ParallelGenerationThreshold;
+	if (Threshold > 0 && Generation.Count >= Threshold &&
+		Source.IsThreadSafe() &&
+		!IsValid(Generation.Squirrel) &&
+		Generation.Drop.StaticResourceSlots.IsEmpty())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GenerateItems_Parallel);
+
+		UObject* Outer = Context->Outer;
+		ParallelFor(Generation.Count,
+			[&Items, &Source, Outer](const int32 i)
+			{
+				Items[i] = Source.CreateItemInstance(Outer);
+			});
+	}
+	else
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GenerateItems_Serial);
+
+		for (int32 i = 0; i < Generation.Count; ++i)
+		{
+			Items[i] = Generation.Drop.Resolve(Context);
+		}
+	}
+
+	// Stacks are added on the game thread, in copy order, whichever path created the items.
+	ProcessStacks.Reserve(ProcessStacks.Num() + Items.Num());
+	for (UFaerieItem* Item : Items)
+	{
+		if (IsValid(Item))
+		{
+			// Sources that can be mutable may still return an immutable item, which should share a stack.
+			AddGeneratedStack(Item, 1, ImmutableStacks);
+		}
+		else
+		{
+			UE_LOG(LogGenerationAction, Error, TEXT("FTableDrop::Resolve returned a bad instance! Crafting likely failed"))
+		}
+	}
+}
+
+void UGenerationAction_GenerateItems::AddGeneratedStack(UFaerieItem* Item, const int32 Copies,
+														TMap<const UFaerieItem*, int32>& ImmutableStacks)
+{
+	if (Item->IsDataMutable())
+	{
+		ProcessStacks.Add(FFaerieItemStack(Item, Copies));
+	}
+	else if (const int32* Existing = ImmutableStacks.Find(Item))
+	{
+		ProcessStacks[*Existing].Copies += Copies;
+	}
+	else
+	{
+		ImmutableStacks.Add(Item, ProcessStacks.Add(FFaerieItemStack(Item, Copies)));
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,54 +1,27 @@
 ﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "GenerationStructs.h"
-#include "FaerieItem.h"
-#include "FaerieItemAsset.h"
-#include "FaerieItemDataProxy.h"
 #include "ItemInstancingContext_Crafting.h"
 #include "Squirrel.h"
+#include "TableDropResolver.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GenerationStructs)
 
 UFaerieItem* FTableDrop::Resolve(const UItemInstancingContext_Crafting* Context) const
 {
-	auto&& DropObject = Asset.Object.LoadSynchronous();
-
-	if (!DropObject || !ensure(DropObject->Implements<UFaerieItemSource>()))
+	if (!::IsValid(Context))
 	{
 		return nullptr;
 	}
 
-	const IFaerieItemSource* ItemSource = Cast<IFaerieItemSource>(DropObject);
-	check(ItemSource);
-
-	UItemInstancingContext_Crafting* TempContext = DuplicateObject(Context, GetTransientPackage());
-
-	for (auto&& StaticResourceSlot : StaticResourceSlots)
+	// Share the resolver of whoever is resolving this, so nested drops reuse its sources and instancing objects.
+	if (Context->Resolver)
 	{
-		const FTableDrop& ChildDrop = StaticResourceSlot.Value.Drop.Get<FTableDrop>();
-
-		// @todo
-		// For Subgraph instances, automatically set the stack to the required amount for the filter.
-		//UFaerieItemTemplate* Slot;
-		//if (UFaerieItemSlotLibrary::FindSlot(DropObject, StaticResourceSlot.Key, Slot))
-		//{
-		//}
-
-		// Instead of creating millions of these, reuse them somehow. probably have Context contain a temp
-		UItemInstancingContext_Crafting* ChildContext = NewObject<UItemInstancingContext_Crafting>();
-		ChildContext->Outer = Context->Outer;
-		ChildContext->Squirrel = Context->Squirrel;
-
-		if (UFaerieItem* StaticInstanceItem = ChildDrop.Resolve(ChildContext))
-		{
-			UFaerieItemDataStackLiteral* Literal = NewObject<UFaerieItemDataStackLiteral>();
-			Literal->SetValue(StaticInstanceItem);
-			TempContext->InputEntryData.Add(StaticResourceSlot.Key, Literal);
-		}
+		return Context->Resolver->Resolve(*this, Context);
 	}
 
-	auto&& Item = ItemSource->CreateItemInstance(TempContext);
-	return Item;
+	Faerie::Generation::FTableDropResolver Resolver;
+	return Resolver.Resolve(*this, Context);
 }
 
 int32 FGeneratorAmount_Range::Resolve(USquirrel* Squirrel) const
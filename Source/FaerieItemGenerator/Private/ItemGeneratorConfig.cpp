@@ -21,6 +21,9 @@ void UItemGenerationConfig::PreSave(FObjectPreSaveContext SaveContext)
 
 #if WITH_EDITOR
 	DropPool.SortTable();
+
+	// Sorting reorders drops, so the cumulative weights must be recalculated before they are saved.
+	DropPool.CalculatePercentages();
 #endif
 }
 
@@ -29,6 +32,8 @@ void UItemGenerationConfig::PostLoad()
 	Super::PostLoad();
 #if WITH_EDITOR
 	DropPool.CalculatePercentages();
+#else
+	DropPool.BuildAliasTable();
 #endif
 }
 
@@ -52,18 +57,37 @@ FGeneratorAmountBase UItemGenerationConfig::GetAmountResolver() const
 }
 
 FPendingItemGeneration UItemGenerationConfig::Resolve() const
+{
+	FPendingItemGeneration Result = Resolve(Squirrel);
+
+	UE_LOG(LogItemGenConfig, Log, TEXT("Chosen Drop: %s"), *Result.Drop.Asset.Object.ToString());
+
+	return Result;
+}
+
+FPendingItemGeneration UItemGenerationConfig::Resolve(USquirrel* InSquirrel) const
 {
 	FPendingItemGeneration Result;
 
-	if (auto&& Drop = DropPool.GetDrop(Squirrel->NextReal()))
+	if (const int32 Index = ResolveIndex(InSquirrel, Result.Count);
+		Index != INDEX_NONE)
 	{
-		Result.Drop = *Drop;
+		Result.Drop = DropPool.DropList[Index].Drop;
+	}
+	else
+	{
+		UE_LOG(LogItemGenConfig, Error, TEXT("Exiting generation: Empty Table"));
 	}
 
-	Result.Count = AmountResolver.Get<FGeneratorAmountBase>().Resolve(Squirrel);
-	Result.Squirrel = Squirrel;
-
-	UE_LOG(LogItemGenConfig, Log, TEXT("Chosen Drop: %s"), *Result.Drop.Asset.Object.ToString());
+	Result.Squirrel = InSquirrel;
 
 	return Result;
+}
+
+int32 UItemGenerationConfig::ResolveIndex(USquirrel* InSquirrel, int32& OutCount) const
+{
+	// The drop is rolled before the amount, so both come from the same positions in the squirrel as they always have.
+	const int32 Index = DropPool.GetDropIndex_Seeded(InSquirrel);
+	OutCount = AmountResolver.Get<FGeneratorAmountBase>().Resolve(InSquirrel);
+	return Index;
 }
\ No newline at end of file
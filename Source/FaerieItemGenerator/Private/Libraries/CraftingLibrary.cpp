@@ -12,6 +12,7 @@ UItemGenerationConfig* UCraftingLibrary::CreateGenerationDriver(const TArray<FWe
 {
     UItemGenerationConfig* NewDriver = NewObject<UItemGenerationConfig>();
     NewDriver->DropPool.DropList = DropList;
+    NewDriver->DropPool.BuildAliasTable();
     NewDriver->AmountResolver = TInstancedStruct<FGeneratorAmountBase>::Make(Amount);
     return NewDriver;
 }
@@ -0,0 +1,279 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "LootSimulation.h"
+#include "FaerieItemPool.h"
+#include "ItemGeneratorConfig.h"
+#include "ItemInstancingContext_Crafting.h"
+#include "Squirrel.h"
+#include "TableDropResolver.h"
+#include "Async/ParallelFor.h"
+#include "UObject/StrongObjectPtr.h"
+
+DECLARE_STATS_GROUP(TEXT("FaerieLootSimulation"), STATGROUP_FaerieLootSimulation, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Simulate Loot"), STAT_LootSimulation_Simulate, STATGROUP_FaerieLootSimulation);
+
+namespace Faerie::Generation
+{
+	namespace Private
+	{
+		struct FStreamResult
+		{
+			TArray<int64> DropCounts;
+			TMap<int32, int64> AmountCounts;
+		};
+
+		// Rolls a drop index and an amount with the stream's squirrel.
+		using FRollFunc = TFunctionRef<int32(USquirrel* Squirrel, int32& OutCount)>;
+
+		// Garbage is collected after this many items are created, as every item is thrown away once made.
+		static constexpr int64 ItemsPerCollection = 65536;
+
+		// Creates the items of chosen drops, through one resolver, as a crafting action does.
+		class FItemCreator
+		{
+		public:
+			FItemCreator()
+			  : Context(NewObject<UItemInstancingContext_Crafting>(GetTransientPackage()))
+			{
+				Context->Outer = GetTransientPackage();
+				Context->Resolver = &Resolver;
+			}
+
+			~FItemCreator()
+			{
+				Context->Resolver = nullptr;
+			}
+
+			void Create(const FTableDrop& Drop, USquirrel* Squirrel)
+			{
+				Context->Squirrel = Squirrel;
+				Drop.Resolve(Context.Get());
+			}
+
+		private:
+			FTableDropResolver Resolver;
+			TStrongObjectPtr<UItemInstancingContext_Crafting> Context;
+		};
+
+		static FLootSimulationResult Simulate(const FFaerieWeightedDropPool& DropPool, const FLootSimulationParams& Params, const FRollFunc Roll)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_LootSimulation_Simulate);
+			check(IsInGameThread());
+
+			FLootSimulationResult Result;
+
+			const int32 NumDrops = DropPool.DropList.Num();
+			const int32 NumStreams = FMath::Max(1, Params.NumStreams);
+			if (NumDrops == 0 || Params.NumResolutions <= 0)
+			{
+				return Result;
+			}
+
+			// Squirrels are UObjects, so they are made here, and only used by the stream that owns them. Streams start
+			// at evenly spaced positions, so their sequences don't overlap.
+			// Kept alive with strong pointers, as garbage is collected between batches when items are created.
+			const int64 Stride = MAX_int32 / NumStreams;
+			TArray<TStrongObjectPtr<USquirrel>> Squirrels;
+			for (int32 i = 0; i < NumStreams; ++i)
+			{
+				USquirrel* Squirrel = NewObject<USquirrel>(GetTransientPackage());
+				Squirrel->Jump(static_cast<int32>(static_cast<uint32>(Params.Seed + Stride * i)));
+				Squirrels.Emplace(Squirrel);
+			}
+
+			TArray<FStreamResult> StreamResults;
+			StreamResults.SetNum(NumStreams);
+			for (FStreamResult& StreamResult : StreamResults)
+			{
+				StreamResult.DropCounts.SetNumZeroed(NumDrops);
+			}
+
+			auto RunResolutions = [&](const int32 Stream, const int64 First, const int64 Last)
+				{
+					FStreamResult& StreamResult = StreamResults[Stream];
+					USquirrel* Squirrel = Squirrels[Stream].Get();
+					for (int64 i = First; i < Last; ++i)
+					{
+						int32 Count = 0;
+						if (const int32 Index = Roll(Squirrel, Count);
+							StreamResult.DropCounts.IsValidIndex(Index))
+						{
+							StreamResult.DropCounts[Index]++;
+						}
+						StreamResult.AmountCounts.FindOrAdd(Count)++;
+					}
+				};
+
+			const double StartTime = FPlatformTime::Seconds();
+			double CollectionSeconds = 0.0;
+
+			if (Params.CreateItems)
+			{
+				for (int32 Stream = 0; Stream < NumStreams; ++Stream)
+				{
+					const int64 Last = Params.NumResolutions * (Stream + 1) / NumStreams;
+					for (int64 First = Params.NumResolutions * Stream / NumStreams; First < Last; First += ItemsPerCollection)
+					{
+						RunResolutions(Stream, First, FMath::Min(First + ItemsPerCollection, Last));
+
+						const double CollectionStart = FPlatformTime::Seconds();
+						CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+						CollectionSeconds += FPlatformTime::Seconds() - CollectionStart;
+					}
+				}
+			}
+			else
+			{
+				ParallelFor(NumStreams,
+					[&](const int32 Stream)
+					{
+						RunResolutions(Stream,
+							Params.NumResolutions * Stream / NumStreams,
+							Params.NumResolutions * (Stream + 1) / NumStreams);
+					});
+			}
+
+			Result.Seconds = FPlatformTime::Seconds() - StartTime - CollectionSeconds;
+			Result.NumResolutions = Params.NumResolutions;
+			Result.CreatedItems = Params.CreateItems;
+
+			// Merge the streams in order, so the result doesn't depend on which finished first.
+			Result.DropCounts.SetNumZeroed(NumDrops);
+			for (const FStreamResult& StreamResult : StreamResults)
+			{
+				for (int32 i = 0; i < NumDrops; ++i)
+				{
+					Result.DropCounts[i] += StreamResult.DropCounts[i];
+				}
+				for (auto&& Amount : StreamResult.AmountCounts)
+				{
+					Result.AmountCounts.FindOrAdd(Amount.Key) += Amount.Value;
+				}
+			}
+			Result.AmountCounts.KeySort(TLess<int32>());
+
+			// Drops that can never be chosen are left out of the test, as they have no expected count to compare to.
+			Result.ExpectedChances.SetNumZeroed(NumDrops);
+			int32 NumPossibleDrops = 0;
+			for (int32 i = 0; i < NumDrops; ++i)
+			{
+				const double Chance = DropPool.GetDropChance(i);
+				Result.ExpectedChances[i] = Chance;
+
+				if (Chance > 0.0)
+				{
+					const double Expected = Chance * Result.NumResolutions;
+					const double Difference = Result.DropCounts[i] - Expected;
+					Result.ChiSquare += Difference * Difference / Expected;
+					NumPossibleDrops++;
+				}
+			}
+			Result.DegreesOfFreedom = FMath::Max(0, NumPossibleDrops - 1);
+
+			return Result;
+		}
+	}
+
+	double FLootSimulationResult::GetResolutionsPerSecond() const
+	{
+		return Seconds > 0.0 ? NumResolutions / Seconds : 0.0;
+	}
+
+	double FLootSimulationResult::GetObservedChance(const int32 Index) const
+	{
+		if (NumResolutions <= 0 || !DropCounts.IsValidIndex(Index))
+		{
+			return 0.0;
+		}
+		return static_cast<double>(DropCounts[Index]) / NumResolutions;
+	}
+
+	double FLootSimulationResult::GetChiSquareDeviation() const
+	{
+		if (DegreesOfFreedom <= 0)
+		{
+			return 0.0;
+		}
+
+		// A chi-square distribution has a mean of k, and a variance of 2k.
+		return (ChiSquare - DegreesOfFreedom) / FMath::Sqrt(2.0 * DegreesOfFreedom);
+	}
+
+	double FLootSimulationResult::GetMeanAmount() const
+	{
+		int64 Total = 0;
+		int64 Num = 0;
+		for (auto&& Amount : AmountCounts)
+		{
+			Total += static_cast<int64>(Amount.Key) * Amount.Value;
+			Num += Amount.Value;
+		}
+		return Num > 0 ? static_cast<double>(Total) / Num : 0.0;
+	}
+
+	FLootSimulationResult SimulateLoot(const UItemGenerationConfig* Config, const FLootSimulationParams& Params)
+	{
+		if (!IsValid(Config))
+		{
+			return FLootSimulationResult();
+		}
+
+		if (Params.CreateItems)
+		{
+			// Rooted, as garbage is collected while items are created.
+			const TStrongObjectPtr<UItemGenerationConfig> ConfigRoot(const_cast<UItemGenerationConfig*>(Config));
+			Private::FItemCreator Creator;
+			return Private::Simulate(Config->GetDropPool(), Params,
+				[Config, &Creator](USquirrel* Squirrel, int32& OutCount)
+				{
+					// The same rolls as Resolve, which then creates the chosen drop with the generation's squirrel.
+					const int32 Index = Config->ResolveIndex(Squirrel, OutCount);
+					if (Index != INDEX_NONE)
+					{
+						Creator.Create(Config->GetDropPool().DropList[Index].Drop, Squirrel);
+					}
+					return Index;
+				});
+		}
+
+		return Private::Simulate(Config->GetDropPool(), Params,
+			[Config](USquirrel* Squirrel, int32& OutCount)
+			{
+				return Config->ResolveIndex(Squirrel, OutCount);
+			});
+	}
+
+	FLootSimulationResult SimulateLoot(const UFaerieItemPool* Pool, const FLootSimulationParams& Params)
+	{
+		if (!IsValid(Pool))
+		{
+			return FLootSimulationResult();
+		}
+
+		const FFaerieWeightedDropPool& DropPool = Pool->GetDropPool();
+
+		if (Params.CreateItems)
+		{
+			const TStrongObjectPtr<UFaerieItemPool> PoolRoot(const_cast<UFaerieItemPool*>(Pool));
+			Private::FItemCreator Creator;
+			return Private::Simulate(DropPool, Params,
+				[&DropPool, &Creator](USquirrel* Squirrel, int32& OutCount)
+				{
+					OutCount = 1;
+					const int32 Index = DropPool.GetDropIndex_Seeded(Squirrel);
+					if (Index != INDEX_NONE)
+					{
+						Creator.Create(DropPool.DropList[Index].Drop, Squirrel);
+					}
+					return Index;
+				});
+		}
+
+		return Private::Simulate(DropPool, Params,
+			[&DropPool](USquirrel* Squirrel, int32& OutCount)
+			{
+				OutCount = 1;
+				return DropPool.GetDropIndex_Seeded(Squirrel);
+			});
+	}
+}
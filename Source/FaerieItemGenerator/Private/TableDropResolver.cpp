@@ -0,0 +1,141 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "TableDropResolver.h"
+#include "FaerieItemDataProxy.h"
+#include "FaerieItemSource.h"
+#include "GenerationStructs.h"
+#include "ItemInstancingContext_Crafting.h"
+
+DECLARE_STATS_GROUP(TEXT("FaerieItemGenerator"), STATGROUP_FaerieItemGenerator, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Resolve Table Drop"), STAT_Generator_ResolveTableDrop, STATGROUP_FaerieItemGenerator);
+DECLARE_CYCLE_STAT(TEXT("Build Table Drop Node"), STAT_Generator_BuildTableDropNode, STATGROUP_FaerieItemGenerator);
+
+namespace Faerie::Generation
+{
+	UFaerieItem* FTableDropResolver::Resolve(const FTableDrop& Drop, const UItemInstancingContext_Crafting* Context)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Generator_ResolveTableDrop);
+
+		if (!::IsValid(Context))
+		{
+			return nullptr;
+		}
+
+		const int32 Node = FindOrAddNode(Drop);
+		return ResolveNode(Node, Context->Outer, Context->Squirrel, &Context->InputEntryData);
+	}
+
+	void FTableDropResolver::AddReferencedObjects(FReferenceCollector& Collector)
+	{
+		for (FNode& Node : Nodes)
+		{
+			Collector.AddReferencedObject(Node.SourceObject);
+		}
+		Collector.AddReferencedObjects(Contexts);
+		Collector.AddReferencedObjects(Literals);
+	}
+
+	FString FTableDropResolver::GetReferencerName() const
+	{
+		return TEXT("FTableDropResolver");
+	}
+
+	int32 FTableDropResolver::FindOrAddNode(const FTableDrop& Drop)
+	{
+		if (const int32* Found = NodeIndices.Find(&Drop))
+		{
+			return *Found;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_Generator_BuildTableDropNode);
+
+		FNode Node;
+		if (UObject* DropObject = Drop.Asset.Object.LoadSynchronous();
+			DropObject && ensure(DropObject->Implements<UFaerieItemSource>()))
+		{
+			Node.SourceObject = DropObject;
+			Node.Source = Cast<IFaerieItemSource>(DropObject);
+		}
+
+		const int32 Index = Nodes.Add(Node);
+		NodeIndices.Add(&Drop, Index);
+
+		// Children add their own nodes and slots, so gather this node's slots first, and append them as one run.
+		TArray<FSlot, TInlineAllocator<4>> NodeSlots;
+		for (auto&& StaticResourceSlot : Drop.StaticResourceSlots)
+		{
+			if (const FTableDrop* ChildDrop = StaticResourceSlot.Value.Drop.GetPtr<FTableDrop>())
+			{
+				NodeSlots.Add({StaticResourceSlot.Key, FindOrAddNode(*ChildDrop)});
+			}
+		}
+
+		Nodes[Index].FirstSlot = Slots.Num();
+		Nodes[Index].NumSlots = NodeSlots.Num();
+		Slots.Append(NodeSlots);
+
+		return Index;
+	}
+
+	UFaerieItem* FTableDropResolver::ResolveNode(const int32 NodeIndex, UObject* Outer, USquirrel* Squirrel,
+												 const TMap<FFaerieItemSlotHandle, FFaerieItemProxy>* InputEntryData)
+	{
+		// Copy what's needed, as sources that resolve drops of their own may add nodes while this one is in use.
+		const FNode Node = Nodes[NodeIndex];
+		if (!Node.Source)
+		{
+			return nullptr;
+		}
+
+		if (!Contexts.IsValidIndex(Depth))
+		{
+			Contexts.Add(NewObject<UItemInstancingContext_Crafting>(GetTransientPackage()));
+		}
+		UItemInstancingContext_Crafting* TempContext = Contexts[Depth++];
+		TempContext->Outer = Outer;
+		TempContext->Squirrel = Squirrel;
+		TempContext->Resolver = this;
+		if (InputEntryData)
+		{
+			TempContext->InputEntryData = *InputEntryData;
+		}
+
+		const int32 LiteralStart = UsedLiterals;
+
+		for (int32 i = 0; i < Node.NumSlots; ++i)
+		{
+			// @todo
+			// For Subgraph instances, automatically set the stack to the required amount for the filter.
+
+			const FSlot Slot = Slots[Node.FirstSlot + i];
+
+			// Static resources are resolved with a blank context, sharing only the outer and squirrel.
+			if (UFaerieItem* StaticInstanceItem = ResolveNode(Slot.Node, Outer, Squirrel, nullptr))
+			{
+				if (!Literals.IsValidIndex(UsedLiterals))
+				{
+					Literals.Add(NewObject<UFaerieItemDataStackLiteral>(GetTransientPackage()));
+				}
+				UFaerieItemDataStackLiteral* Literal = Literals[UsedLiterals++];
+				Literal->SetValue(StaticInstanceItem);
+				TempContext->InputEntryData.Add(Slot.Handle, Literal);
+			}
+		}
+
+		UFaerieItem* Item = Node.Source->CreateItemInstance(TempContext);
+
+		// Release everything back to the pools, without holding on to the inputs.
+		for (int32 i = LiteralStart; i < UsedLiterals; ++i)
+		{
+			Literals[i]->SetValue(FFaerieItemStack());
+		}
+		UsedLiterals = LiteralStart;
+
+		TempContext->InputEntryData.Reset();
+		TempContext->Outer = nullptr;
+		TempContext->Squirrel = nullptr;
+		Depth--;
+
+		return Item;
+	}
+}
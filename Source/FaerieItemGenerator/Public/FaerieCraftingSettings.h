@@ -0,0 +1,30 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "FaerieCraftingSettings.generated.h"
+
+/**
+ * Project settings for UFaerieItemCraftingSubsystem.
+ */
+UCLASS(Config = "Project", defaultconfig, meta = (DisplayName = "Faerie Crafting"))
+class FAERIEITEMGENERATOR_API UFaerieCraftingSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// UDeveloperSettings implementation
+	virtual FName GetCategoryName() const override;
+	// End UDeveloperSettings implementation
+
+	// The maximum number of crafting actions that may run at once. Actions from the same executor always run one at a
+	// time, in the order they were submitted.
+	UPROPERTY(Config, EditAnywhere, Category = "Scheduling", meta = (ClampMin = 1, UIMin = 1))
+	int32 MaxConcurrentActions = 4;
+
+	// Unseeded generations of at least this many mutable copies create them on worker threads, when their item source
+	// is thread-safe, and their drop has no static resource slots. Set to 0 to always create items on the game thread.
+	UPROPERTY(Config, EditAnywhere, Category = "Generation", meta = (ClampMin = 0, UIMin = 0))
+	int32 ParallelGenerationThreshold = 32;
+};
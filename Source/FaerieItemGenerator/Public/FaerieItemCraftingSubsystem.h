@@ -5,12 +5,13 @@
 #include "Subsystems/WorldSubsystem.h"
 #include "CraftingRequests.h"
 #include "GenerationAction.h"
-#include "Containers/SpscQueue.h"
 
 #include "FaerieItemCraftingSubsystem.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogItemGeneratorSubsystem, Log, All)
 
+struct FStreamableHandle;
+
 /**
  *
  */
@@ -22,13 +23,23 @@ class FAERIEITEMGENERATOR_API UFaerieItemCraftingSubsystem : public UWorldSubsys
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
+	virtual void Deinitialize() override;
+
 private:
 	void BeginRunningAction(UCraftingActionBase* Action);
 
 	// Adds an action pointer that was created internally to the queue.
 	void EnqueueAction_Internal(UCraftingActionBase* NewAction);
 
-	void OnActionCompleted(EGenerationActionResult Success);
+	// Requests a single async load for the assets of every queued action that hasn't requested them yet.
+	void PreloadPendingAssets();
+
+	// Starts as many pending actions as the concurrency cap allows, keeping each executor's actions in FIFO order.
+	void StartPendingActions();
+
+	void OnActionCompleted(EGenerationActionResult Success, UCraftingActionBase* Action);
+
+	void UpdateQueueStats() const;
 
 	/**
 	 * Enqueues an Action to be executed in a FIFO queue.
@@ -82,13 +93,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|ItemGeneration")
 	void PreviewCraftingRequest(const FCraftingRequest& Request);
 
+	// Number of actions waiting to run.
+	UFUNCTION(BlueprintPure, Category = "Faerie|ItemGeneration")
+	int32 GetNumPendingActions() const { return PendingActions.Num(); }
+
+	// Number of actions currently running.
+	UFUNCTION(BlueprintPure, Category = "Faerie|ItemGeneration")
+	int32 GetNumRunningActions() const { return RunningActions.Num(); }
+
 private:
 	bool Initialized = false;
 
-	// The Action currently running.
+	// Actions currently running. Never more than UFaerieCraftingSettings::MaxConcurrentActions.
 	UPROPERTY(Transient)
-	TObjectPtr<UCraftingActionBase> ActiveAction;
+	TArray<TObjectPtr<UCraftingActionBase>> RunningActions;
+
+	struct FPendingAction
+	{
+		TStrongObjectPtr<UCraftingActionBase> Action;
+
+		// Time this action was enqueued, in platform seconds.
+		double EnqueueTime = 0.0;
+
+		// Load handle shared by every action in the same preload batch.
+		TSharedPtr<FStreamableHandle> PreloadHandle;
+
+		bool PreloadRequested = false;
+	};
+
+	// Actions waiting to run, in the order they were submitted.
+	TArray<FPendingAction> PendingActions;
+
+	// Time each running action was started, in platform seconds.
+	TMap<TObjectKey<UCraftingActionBase>, double> RunStartTimes;
+
+	FTimerHandle PreloadTimer;
 
-	// Actions waiting to run
-	TSpscQueue<TStrongObjectPtr<UCraftingActionBase>> PendingActions;
+	// Guards against re-entry when actions complete synchronously inside Start.
+	bool IsStartingActions = false;
+	bool NeedsStartPass = false;
 };
\ No newline at end of file
@@ -9,8 +9,10 @@
 
 #include "FaerieItemPool.generated.h"
 
+class USquirrel;
+
 USTRUCT()
-struct FFaerieWeightedDropPool
+struct FAERIEITEMGENERATOR_API FFaerieWeightedDropPool
 {
 	GENERATED_BODY()
 
@@ -20,6 +22,24 @@ struct FFaerieWeightedDropPool
 	// Generates a drop from this pool, using the provided random weight, which must be a value between 0 and 1.
 	const FTableDrop* GetDrop(double RanWeight) const;
 
+	// Generates a drop from this pool in constant time, using the next value from a squirrel.
+	const FTableDrop* GetDrop_Seeded(USquirrel* Squirrel) const;
+
+	// Picks the index of a drop in DropList in constant time, using the next value from a squirrel. Returns INDEX_NONE
+	// if the pool is empty.
+	int32 GetDropIndex_Seeded(USquirrel* Squirrel) const;
+
+	// Picks Num drops, appending their indices in DropList to OutIndices.
+	void GenerateDrops(USquirrel* Squirrel, int32 Num, TArray<int32>& OutIndices) const;
+
+	// Gets the chance, between 0 and 1, that the drop at an index in DropList is chosen. In editor builds, this is the
+	// configured PercentageChanceToDrop, otherwise it is read from AdjustedWeight.
+	double GetDropChance(int32 Index) const;
+
+	// Rebuilds the alias table used for constant time sampling from AdjustedWeight. Must be called after DropList is
+	// modified at runtime. Pool owners call this during PostLoad.
+	void BuildAliasTable();
+
 #if WITH_EDITOR
 	// Calculate the percentage each drop has to be chosen.
 	void CalculatePercentages();
@@ -27,9 +47,14 @@ struct FFaerieWeightedDropPool
 	// Keeps the table sorted by Weight.
 	void SortTable();
 #endif
-};
 
-class USquirrel;
+private:
+	int32 SampleAliasTable(double RanWeight) const;
+
+	// Walker/Vose alias table. For column i, keep i with AliasProbability[i], otherwise take AliasIndex[i].
+	TArray<double> AliasProbability;
+	TArray<int32> AliasIndex;
+};
 
 /**
  * A Faerie Item Pool is a list of possible item generations, each with a weight that determined its frequency.
@@ -62,6 +87,14 @@ public:
 	const FTableDrop* GetDrop(double RanWeight) const;
 	const FTableDrop* GetDrop_Seeded(USquirrel* Squirrel) const;
 
+	const FFaerieWeightedDropPool& GetDropPool() const { return DropPool; }
+
+	// Picks Num drops, appending their indices in the pool to OutIndices. See GetDropAt.
+	void GenerateDrops(USquirrel* Squirrel, int32 Num, TArray<int32>& OutIndices) const;
+
+	// Gets a drop by an index returned from GenerateDrops.
+	const FTableDrop& GetDropAt(const int32 Index) const { return DropPool.DropList[Index].Drop; }
+
 protected:
 	// Generates a drop from this table, using the provided random weight, which must be a value between 0 and 1.
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Faerie|ItemPool")
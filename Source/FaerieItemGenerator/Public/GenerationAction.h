@@ -48,6 +48,9 @@ class FAERIEITEMGENERATOR_API UCraftingActionBase : public UObject
 {
 	GENERATED_BODY()
 
+	// The subsystem gathers assets to preload across all queued actions.
+	friend class UFaerieItemCraftingSubsystem;
+
 public:
 	struct FActionArgs
 	{
@@ -90,6 +93,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|CraftingAction")
 	void Start();
 
+	UObject* GetExecutor() const { return Executor; }
+
 public:
 	FNativeGenerationActionCompletedCallback OnCompletedCallback;
 
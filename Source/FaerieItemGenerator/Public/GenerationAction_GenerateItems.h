@@ -6,7 +6,10 @@
 #include "ItemGeneratorConfig.h"
 #include "GenerationAction_GenerateItems.generated.h"
 
+class IFaerieItemSource;
+class UFaerieItem;
 class UItemGenerationConfig;
+class UItemInstancingContext_Crafting;
 
 /**
  * Contains the asynchronous generation logic for inventory entries.
@@ -30,6 +33,13 @@ protected:
 	virtual void Run() override;
 
 private:
+	// Create one item per copy, for sources that may create mutable items.
+	void GenerateMutable(const FPendingItemGeneration& Generation, const IFaerieItemSource& Source,
+						 UItemInstancingContext_Crafting* Context, TMap<const UFaerieItem*, int32>& ImmutableStacks);
+
+	// Add generated copies of an item to the results. Copies of an immutable item are merged into its existing stack.
+	void AddGeneratedStack(UFaerieItem* Item, int32 Copies, TMap<const UFaerieItem*, int32>& ImmutableStacks);
+
 	// Children items to generate.
 	TArray<FPendingItemGeneration> PendingGenerations;
 };
\ No newline at end of file
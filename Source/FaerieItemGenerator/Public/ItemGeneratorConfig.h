@@ -59,8 +59,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|GenerationDriver")
 	FGeneratorAmountBase GetAmountResolver() const;
 
+	// Resolves a generation with this config's squirrel, and logs the chosen drop.
 	FPendingItemGeneration Resolve() const;
 
+	// Resolves a generation with the given squirrel, without logging.
+	FPendingItemGeneration Resolve(USquirrel* InSquirrel) const;
+
+	// Rolls the index of a drop in the pool, and the amount to generate, the same way Resolve does, without copying the
+	// drop. Safe to call from any thread, as long as the squirrel is not shared with another.
+	int32 ResolveIndex(USquirrel* InSquirrel, int32& OutCount) const;
+
+	const FFaerieWeightedDropPool& GetDropPool() const { return DropPool; }
+
 protected:
 	UPROPERTY(EditAnywhere, Category = "Table", meta = (ShowOnlyInnerProperties))
 	FFaerieWeightedDropPool DropPool;
@@ -9,6 +9,11 @@
 
 class USquirrel;
 
+namespace Faerie::Generation
+{
+	class FTableDropResolver;
+}
+
 UCLASS()
 class FAERIEITEMGENERATOR_API UItemInstancingContext_Crafting : public UItemInstancingContext
 {
@@ -23,4 +28,7 @@ public:
 	// resolve to non-seeded output.
 	UPROPERTY()
 	TObjectPtr<USquirrel> Squirrel = nullptr;
+
+	// When set, table drops resolved with this context reuse this resolver's loaded sources and instancing objects.
+	Faerie::Generation::FTableDropResolver* Resolver = nullptr;
 };
\ No newline at end of file
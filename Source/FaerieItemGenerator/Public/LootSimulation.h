@@ -0,0 +1,71 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+class UFaerieItemPool;
+class UItemGenerationConfig;
+struct FFaerieWeightedDropPool;
+
+namespace Faerie::Generation
+{
+	struct FLootSimulationParams
+	{
+		// Total number of resolutions to run.
+		int64 NumResolutions = 1000000;
+
+		int32 Seed = 0;
+
+		// Number of squirrel streams the resolutions are split between. Results only depend on the seed and the number
+		// of streams, not on how many threads run them, so this is fixed instead of matching the core count.
+		int32 NumStreams = 64;
+
+		// By default, only the drop index and amount are rolled, which checks rates quickly, on every core. When set,
+		// the item of every chosen drop is also created, the same way crafting actions create them, so the rate
+		// measures the whole generator. Items are UObjects, so streams then run one after another on the game thread.
+		// Drops may use the squirrel while creating items, so results differ from the roll-only mode.
+		bool CreateItems = false;
+	};
+
+	struct FAERIEITEMGENERATOR_API FLootSimulationResult
+	{
+		int64 NumResolutions = 0;
+
+		// Time spent resolving, without the garbage collection between batches of created items.
+		double Seconds = 0.0;
+
+		// Were items created for each resolution, or only drop indices rolled. See FLootSimulationParams::CreateItems.
+		bool CreatedItems = false;
+
+		// Times each drop in the pool was chosen, by index in its DropList.
+		TArray<int64> DropCounts;
+
+		// The configured chance of each drop, between 0 and 1.
+		TArray<double> ExpectedChances;
+
+		// Times each amount was resolved. Pools have no amount, and always count 1.
+		TMap<int32, int64> AmountCounts;
+
+		// Pearson's chi-square of the drop counts against the expected chances.
+		double ChiSquare = 0.0;
+		int32 DegreesOfFreedom = 0;
+
+		double GetResolutionsPerSecond() const;
+
+		double GetObservedChance(int32 Index) const;
+
+		// How many standard deviations the chi-square is from its mean, for the degrees of freedom. Values past ~3
+		// mean the pool does not drop at the configured rates.
+		double GetChiSquareDeviation() const;
+
+		double GetMeanAmount() const;
+	};
+
+	/**
+	 * Runs seeded resolutions of a drop table on every core, to check its drop rates and amounts, and to measure how
+	 * fast it resolves, either as a drop roll rate, or as full generator throughput when items are created.
+	 * Each stream has its own squirrel, so runs with the same params give the same result.
+	 * Must be called from the game thread, and blocks until all streams are done.
+	 */
+	FAERIEITEMGENERATOR_API FLootSimulationResult SimulateLoot(const UItemGenerationConfig* Config, const FLootSimulationParams& Params);
+	FAERIEITEMGENERATOR_API FLootSimulationResult SimulateLoot(const UFaerieItemPool* Pool, const FLootSimulationParams& Params);
+}
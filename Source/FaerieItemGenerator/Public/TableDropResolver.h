@@ -0,0 +1,67 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "FaerieItemProxy.h"
+#include "ItemSlotHandle.h"
+#include "UObject/GCObject.h"
+
+class IFaerieItemSource;
+class UFaerieItem;
+class UFaerieItemDataStackLiteral;
+class UItemInstancingContext_Crafting;
+class USquirrel;
+struct FTableDrop;
+
+namespace Faerie::Generation
+{
+	/**
+	 * Resolves table drops, and the drops in their static resource slots, without allocating anything but the items.
+	 * Each drop is turned into a node the first time it's seen. The node holds the loaded item source and the nodes of
+	 * its slots, so later resolves don't touch soft pointers. Instancing contexts are kept per recursion depth, and
+	 * stack literals for slot inputs are kept on a stack, and both are reused by every resolve.
+	 * Nodes are keyed by the address of their drop, so drops must outlive the resolver, and not be moved while it's used.
+	 */
+	class FAERIEITEMGENERATOR_API FTableDropResolver : public FGCObject
+	{
+	public:
+		UFaerieItem* Resolve(const FTableDrop& Drop, const UItemInstancingContext_Crafting* Context);
+
+		//~ FGCObject
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+		virtual FString GetReferencerName() const override;
+		//~ FGCObject
+
+	private:
+		struct FNode
+		{
+			TObjectPtr<UObject> SourceObject;
+			const IFaerieItemSource* Source = nullptr;
+			int32 FirstSlot = 0;
+			int32 NumSlots = 0;
+		};
+
+		struct FSlot
+		{
+			FFaerieItemSlotHandle Handle;
+			int32 Node = INDEX_NONE;
+		};
+
+		int32 FindOrAddNode(const FTableDrop& Drop);
+
+		UFaerieItem* ResolveNode(int32 NodeIndex, UObject* Outer, USquirrel* Squirrel,
+								 const TMap<FFaerieItemSlotHandle, FFaerieItemProxy>* InputEntryData);
+
+		TMap<const FTableDrop*, int32> NodeIndices;
+		TArray<FNode> Nodes;
+		TArray<FSlot> Slots;
+
+		// One context per recursion depth. Depth is the number in use.
+		TArray<TObjectPtr<UItemInstancingContext_Crafting>> Contexts;
+		int32 Depth = 0;
+
+		// Literals holding slot inputs. UsedLiterals is the number in use.
+		TArray<TObjectPtr<UFaerieItemDataStackLiteral>> Literals;
+		int32 UsedLiterals = 0;
+	};
+}
@@ -0,0 +1,94 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieLootSimulationCommandlet.h"
+#include "FaerieItemPool.h"
+#include "ItemGeneratorConfig.h"
+#include "LootSimulation.h"
+#include "Misc/FileHelper.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FaerieLootSimulationCommandlet)
+
+DEFINE_LOG_CATEGORY(LogFaerieLootSimulation)
+
+UFaerieLootSimulationCommandlet::UFaerieLootSimulationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UFaerieLootSimulationCommandlet::Main(const FString& Params)
+{
+	FString AssetPath;
+	if (!FParse::Value(*Params, TEXT("Asset="), AssetPath))
+	{
+		UE_LOG(LogFaerieLootSimulation, Error, TEXT("Missing -Asset=. Pass the path of an item generation config or item pool."));
+		return 1;
+	}
+
+	Faerie::Generation::FLootSimulationParams SimulationParams;
+	FParse::Value(*Params, TEXT("Resolutions="), SimulationParams.NumResolutions);
+	FParse::Value(*Params, TEXT("Seed="), SimulationParams.Seed);
+	FParse::Value(*Params, TEXT("Streams="), SimulationParams.NumStreams);
+	SimulationParams.CreateItems = FParse::Param(*Params, TEXT("CreateItems"));
+
+	const UObject* Asset = LoadObject<UObject>(nullptr, *AssetPath);
+
+	const FFaerieWeightedDropPool* DropPool = nullptr;
+	Faerie::Generation::FLootSimulationResult Result;
+	if (const UItemGenerationConfig* Config = Cast<UItemGenerationConfig>(Asset))
+	{
+		DropPool = &Config->GetDropPool();
+		Result = Faerie::Generation::SimulateLoot(Config, SimulationParams);
+	}
+	else if (const UFaerieItemPool* Pool = Cast<UFaerieItemPool>(Asset))
+	{
+		DropPool = &Pool->GetDropPool();
+		Result = Faerie::Generation::SimulateLoot(Pool, SimulationParams);
+	}
+	else
+	{
+		UE_LOG(LogFaerieLootSimulation, Error, TEXT("'%s' is not an item generation config or item pool."), *AssetPath);
+		return 1;
+	}
+
+	UE_LOG(LogFaerieLootSimulation, Display, TEXT("Simulated %lld resolutions of '%s' (seed %i, %i streams) in %.3fs: %.0f %s/s"),
+		Result.NumResolutions, *AssetPath, SimulationParams.Seed, SimulationParams.NumStreams, Result.Seconds, Result.GetResolutionsPerSecond(),
+		Result.CreatedItems ? TEXT("items") : TEXT("drop rolls"));
+
+	FString Csv = TEXT("Drop,Count,Observed,Expected\n");
+
+	UE_LOG(LogFaerieLootSimulation, Display, TEXT("Drops:"));
+	for (int32 i = 0; i < Result.DropCounts.Num(); ++i)
+	{
+		const FString DropName = DropPool->DropList[i].Drop.Asset.Object.ToString();
+		UE_LOG(LogFaerieLootSimulation, Display, TEXT("  [%i] %s: %lld (%.4f%%, expected %.4f%%)"),
+			i, *DropName, Result.DropCounts[i], Result.GetObservedChance(i) * 100.0, Result.ExpectedChances[i] * 100.0);
+		Csv += FString::Printf(TEXT("%s,%lld,%f,%f\n"),
+			*DropName, Result.DropCounts[i], Result.GetObservedChance(i), Result.ExpectedChances[i]);
+	}
+
+	UE_LOG(LogFaerieLootSimulation, Display, TEXT("Amounts (mean %.3f):"), Result.GetMeanAmount());
+	Csv += TEXT("\nAmount,Count\n");
+	for (auto&& Amount : Result.AmountCounts)
+	{
+		UE_LOG(LogFaerieLootSimulation, Display, TEXT("  %i: %lld"), Amount.Key, Amount.Value);
+		Csv += FString::Printf(TEXT("%i,%lld\n"), Amount.Key, Amount.Value);
+	}
+
+	UE_LOG(LogFaerieLootSimulation, Display, TEXT("Chi-square: %.3f with %i degrees of freedom (%.2f standard deviations from expected)"),
+		Result.ChiSquare, Result.DegreesOfFreedom, Result.GetChiSquareDeviation());
+
+	if (FString CsvPath;
+		FParse::Value(*Params, TEXT("Csv="), CsvPath))
+	{
+		if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+		{
+			UE_LOG(LogFaerieLootSimulation, Error, TEXT("Failed to write '%s'."), *CsvPath);
+			return 1;
+		}
+	}
+
+	return 0;
+}
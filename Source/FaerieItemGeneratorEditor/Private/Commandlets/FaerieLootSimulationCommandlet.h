@@ -0,0 +1,28 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FaerieLootSimulationCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogFaerieLootSimulation, Log, All);
+
+/**
+ * Runs seeded resolutions of an item generation config or item pool, and reports how often each drop was chosen, the
+ * amounts resolved, how far the drop rates are from the configured chances, and how many resolutions ran per second.
+ * By default only drops are rolled, so the rate is a drop roll rate. Pass -CreateItems to also create each chosen item,
+ * which measures the throughput of the whole generator.
+ *
+ * Usage:
+ * -run=FaerieLootSimulation -Asset=/Game/Path/To/Asset.Asset [-Resolutions=1000000] [-Seed=0] [-Streams=64] [-CreateItems] [-Csv=Path.csv]
+ */
+UCLASS()
+class UFaerieLootSimulationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFaerieLootSimulationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
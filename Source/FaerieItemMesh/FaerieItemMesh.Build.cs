@@ -25,6 +25,7 @@ public class FaerieItemMesh : ModuleRules
             new []
             {
                 "CoreUObject",
+                "DeveloperSettings",
                 "Engine",
                 "SkeletalMerging"
             });
@@ -33,7 +34,9 @@ public class FaerieItemMesh : ModuleRules
             new[]
             {
                 "GeometryScriptingCore",
-                "GeometryFramework"
+                "GeometryFramework",
+                "GeometryCore",
+                "DynamicMesh"
             });
     }
 }
\ No newline at end of file
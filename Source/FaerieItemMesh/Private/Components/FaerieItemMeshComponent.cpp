@@ -2,6 +2,7 @@
 
 #include "Components/FaerieItemMeshComponent.h"
 #include "FaerieMeshStructs.h"
+#include "FaerieMeshSubsystem.h"
 #include "Components/DynamicMeshComponent.h"
 #include "GeometryScript/MeshQueryFunctions.h"
 #include "Libraries/FaerieMeshStructsLibrary.h"
@@ -24,6 +25,39 @@ void UFaerieItemMeshComponent::DestroyComponent(const bool bPromoteChildren)
 	Super::DestroyComponent(bPromoteChildren);
 }
 
+void UFaerieItemMeshComponent::OnComponentDestroyed(const bool bDestroyingHierarchy)
+{
+	ReleaseRetainedMesh();
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+void UFaerieItemMeshComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Release while the world, and its mesh subsystem, still exists.
+	ReleaseRetainedMesh();
+	Super::EndPlay(EndPlayReason);
+}
+
+UFaerieMeshSubsystem* UFaerieItemMeshComponent::GetMeshSubsystem() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UFaerieMeshSubsystem>() : nullptr;
+}
+
+void UFaerieItemMeshComponent::ReleaseRetainedMesh()
+{
+	if (!bRetainedMesh)
+	{
+		return;
+	}
+	bRetainedMesh = false;
+
+	if (UFaerieMeshSubsystem* MeshSubsystem = GetMeshSubsystem())
+	{
+		MeshSubsystem->ReleaseMesh(MeshData);
+	}
+}
+
 void UFaerieItemMeshComponent::RebuildMesh()
 {
 	EItemMeshType NewMeshType = EItemMeshType::None;
@@ -166,6 +200,18 @@ void UFaerieItemMeshComponent::SetItemMesh(const FFaerieItemMesh& InMeshData)
 {
 	if (MeshData != InMeshData)
 	{
+		// Retain the new mesh first, so that releasing the old one can't evict it, if they share a generated mesh.
+		if (UFaerieMeshSubsystem* MeshSubsystem = GetMeshSubsystem())
+		{
+			MeshSubsystem->RetainMesh(InMeshData);
+			ReleaseRetainedMesh();
+			bRetainedMesh = true;
+		}
+		else
+		{
+			ReleaseRetainedMesh();
+		}
+
 		MeshData = InMeshData;
 		RebuildMesh();
 	}
@@ -174,6 +220,8 @@ void UFaerieItemMeshComponent::SetItemMesh(const FFaerieItemMesh& InMeshData)
 void UFaerieItemMeshComponent::ClearItemMesh()
 {
 	ActualType = EItemMeshType::None;
+
+	ReleaseRetainedMesh();
 	MeshData = FFaerieItemMesh();
 
 	if (IsValid(MeshComponent))
@@ -0,0 +1,10 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "FaerieMeshSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FaerieMeshSettings)
+
+FName UFaerieMeshSettings::GetCategoryName() const
+{
+	return FApp::GetProjectName();
+}
@@ -2,6 +2,7 @@
 
 #include "FaerieMeshStructs.h"
 #include "UDynamicMesh.h"
+#include "Hash/xxhash.h"
 
 namespace Faerie::ItemMesh::Tags
 {
@@ -10,6 +11,91 @@ namespace Faerie::ItemMesh::Tags
 	UE_DEFINE_GAMEPLAY_TAG_COMMENT(MeshPurpose_Equipped, FName{TEXTVIEW("MeshPurpose.Equipped")}, "Mesh for item when used as active equipment")
 }
 
+namespace Faerie::ItemMesh
+{
+	namespace Private
+	{
+		// Tags the kind of mesh data hashed, so static and skeletal data never share a hash.
+		enum class EMeshDataType : uint8
+		{
+			Static,
+			Skeletal
+		};
+
+		template <typename T>
+		static void HashValue(FXxHash64Builder& Builder, const T& Value)
+		{
+			Builder.Update(&Value, sizeof(T));
+		}
+
+		static void HashName(FXxHash64Builder& Builder, const FName Name)
+		{
+			HashValue(Builder, Name.GetComparisonIndex().ToUnstableInt());
+			HashValue(Builder, Name.GetNumber());
+		}
+
+		static void HashPath(FXxHash64Builder& Builder, const FSoftObjectPath& Path)
+		{
+			HashName(Builder, Path.GetAssetPath().GetPackageName());
+			HashName(Builder, Path.GetAssetPath().GetAssetName());
+
+			const FString SubPath = Path.GetSubPathString();
+			HashValue(Builder, SubPath.Len());
+			Builder.Update(*SubPath, SubPath.Len() * sizeof(TCHAR));
+		}
+
+		static void HashMaterials(FXxHash64Builder& Builder, const TArray<FFaerieItemMaterial>& Materials)
+		{
+			HashValue(Builder, Materials.Num());
+			for (const FFaerieItemMaterial& Material : Materials)
+			{
+				HashPath(Builder, Material.Material.ToSoftObjectPath());
+			}
+		}
+
+		static void HashAttachment(FXxHash64Builder& Builder, const FSocketAttachment& Attachment)
+		{
+			HashName(Builder, Attachment.Socket);
+			HashValue(Builder, Attachment.Offset.GetTranslation());
+			HashValue(Builder, Attachment.Offset.GetRotation());
+			HashValue(Builder, Attachment.Offset.GetScale3D());
+		}
+	}
+
+	uint64 HashMeshData(const FFaerieDynamicStaticMesh& MeshData)
+	{
+		FXxHash64Builder Builder;
+		Private::HashValue(Builder, Private::EMeshDataType::Static);
+		Private::HashValue(Builder, MeshData.Fragments.Num());
+
+		for (const FFaerieDynamicStaticMeshFragment& Fragment : MeshData.Fragments)
+		{
+			Private::HashPath(Builder, Fragment.StaticMesh.ToSoftObjectPath());
+			Private::HashMaterials(Builder, Fragment.Materials);
+			Private::HashAttachment(Builder, Fragment.Attachment);
+		}
+
+		return Builder.Finalize().Hash;
+	}
+
+	uint64 HashMeshData(const FFaerieDynamicSkeletalMesh& MeshData)
+	{
+		FXxHash64Builder Builder;
+		Private::HashValue(Builder, Private::EMeshDataType::Skeletal);
+		Private::HashValue(Builder, MeshData.Fragments.Num());
+
+		for (const FFaerieDynamicSkeletalMeshFragment& Fragment : MeshData.Fragments)
+		{
+			Private::HashPath(Builder, Fragment.SkeletonAndAnimClass.Mesh.ToSoftObjectPath());
+			Private::HashPath(Builder, Fragment.SkeletonAndAnimClass.AnimClass.ToSoftObjectPath());
+			Private::HashMaterials(Builder, Fragment.Materials);
+			Private::HashAttachment(Builder, Fragment.Attachment);
+		}
+
+		return Builder.Finalize().Hash;
+	}
+}
+
 FFaerieDynamicStaticMesh::FFaerieDynamicStaticMesh(const FFaerieStaticMeshData& EditorStaticMesh)
 {
 	if (!EditorStaticMesh.StaticMesh.IsValid())
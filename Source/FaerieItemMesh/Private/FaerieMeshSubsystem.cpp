@@ -4,6 +4,7 @@
 
 #include "FaerieItem.h"
 #include "FaerieItemDataProxy.h"
+#include "FaerieMeshSettings.h"
 #include "FaerieMeshStructs.h"
 #include "SkeletalMergingLibrary.h"
 #include "Tokens/FaerieMeshToken.h"
@@ -13,96 +14,268 @@
 
 #include "UDynamicMesh.h" // For creating static meshes at runtime
 
+#include "DynamicMeshEditor.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "TransformTypes.h"
 #include "GeometryScript/MeshAssetFunctions.h"
-#include "GeometryScript/MeshBasicEditFunctions.h"
-#include "GeometryScript/MeshMaterialFunctions.h"
 
-void UFaerieMeshSubsystem::Initialize(FSubsystemCollectionBase& Collection)
-{
-	Super::Initialize(Collection);
-
-	FallbackPurpose = Faerie::ItemMesh::Tags::MeshPurpose_Default;
-}
-
-FFaerieItemMesh UFaerieMeshSubsystem::GetDynamicStaticMeshForData(const FFaerieDynamicStaticMesh& MeshData)
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "Engine/SkeletalMesh.h"
+#include "Tasks/Task.h"
+
+DECLARE_STATS_GROUP(TEXT("FaerieMeshSubsystem"), STATGROUP_FaerieMeshSubsystem, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Prepare Fragments"), STAT_MeshSubsystem_PrepareFragments, STATGROUP_FaerieMeshSubsystem);
+DECLARE_CYCLE_STAT(TEXT("Assemble Fragments"), STAT_MeshSubsystem_AssembleFragments, STATGROUP_FaerieMeshSubsystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache Hits"), STAT_MeshCache_Hits, STATGROUP_FaerieMeshSubsystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache Misses"), STAT_MeshCache_Misses, STATGROUP_FaerieMeshSubsystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache Evictions"), STAT_MeshCache_Evictions, STATGROUP_FaerieMeshSubsystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cached Meshes"), STAT_MeshCache_NumMeshes, STATGROUP_FaerieMeshSubsystem);
+DECLARE_MEMORY_STAT(TEXT("Cache Resident Bytes"), STAT_MeshCache_ResidentBytes, STATGROUP_FaerieMeshSubsystem);
+
+namespace Faerie::ItemMesh::Private
 {
-	if (MeshData.Fragments.IsEmpty())
+	// Streams in objects, and runs the delegate once they are loaded, or immediately, if there is nothing to load.
+	static void RequestAsyncLoad(TArray<FSoftObjectPath>&& ObjectsToLoad, const FStreamableDelegate& Delegate)
 	{
-		return FFaerieItemMesh();
+		if (ObjectsToLoad.IsEmpty())
+		{
+			Delegate.ExecuteIfBound();
+			return;
+		}
+
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(ObjectsToLoad), Delegate);
 	}
 
-	// The final mesh we will return.
-	UDynamicMesh* OutMesh = NewObject<UDynamicMesh>();
-	TArray<FFaerieItemMaterial> Materials;
+	// A fragment of a dynamic static mesh, copied out of its asset, that can be appended on any thread.
+	struct FMeshFragment
+	{
+		UE::Geometry::FDynamicMesh3 Mesh;
+		FTransform Transform;
 
-	TMap<FName, UStaticMeshSocket*> Sockets;
+		// Maps the fragment's material IDs to material indices in the assembled mesh. IDs past the end are kept.
+		TArray<int32> MaterialRemap;
+	};
 
-	for (const FFaerieDynamicStaticMeshFragment& Fragment : MeshData.Fragments)
+	// Copies the geometry of each fragment out of its static mesh, and works out where it goes and which materials it
+	// uses. Fragment meshes must already be loaded. Assets can only be read on the game thread.
+	static void PrepareFragments(const FFaerieDynamicStaticMesh& MeshData, TArray<FMeshFragment>& OutFragments,
+								 TArray<FFaerieItemMaterial>& OutMaterials)
 	{
-		if (!Fragment.StaticMesh.IsValid())
+		SCOPE_CYCLE_COUNTER(STAT_MeshSubsystem_PrepareFragments);
+		check(IsInGameThread());
+
+		// Each asset is copied into this, and its geometry moved out after.
+		UDynamicMesh* CopyMesh = NewObject<UDynamicMesh>();
+
+		TMap<FName, UStaticMeshSocket*> Sockets;
+
+		for (const FFaerieDynamicStaticMeshFragment& Fragment : MeshData.Fragments)
 		{
-			UE_LOG(LogTemp, Error, TEXT("Invalid Static Mesh detected while building dynamic mesh!"))
-			continue;
-		}
+			UStaticMesh* StaticMesh = Fragment.StaticMesh.Get();
+			if (!IsValid(StaticMesh))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Invalid Static Mesh detected while building dynamic mesh!"))
+				continue;
+			}
 
-		// Copy mesh data
+			FMeshFragment& OutFragment = OutFragments.AddDefaulted_GetRef();
 
-		UDynamicMesh* AppendMesh = NewObject<UDynamicMesh>();
+			// Copy mesh data
 
-		const FGeometryScriptCopyMeshFromAssetOptions AssetOptions;
-		const FGeometryScriptMeshReadLOD RequestedLOD;
-		EGeometryScriptOutcomePins Outcome;
-		UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromStaticMesh(Fragment.StaticMesh.LoadSynchronous(), AppendMesh, AssetOptions, RequestedLOD, Outcome);
+			const FGeometryScriptCopyMeshFromAssetOptions AssetOptions;
+			const FGeometryScriptMeshReadLOD RequestedLOD;
+			EGeometryScriptOutcomePins Outcome;
+			UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromStaticMesh(StaticMesh, CopyMesh, AssetOptions, RequestedLOD, Outcome);
 
-		for (auto&& Socket : Fragment.StaticMesh->Sockets)
-		{
-			Sockets.Add(Socket->SocketName, Socket);
+			CopyMesh->EditMesh([&OutFragment](UE::Geometry::FDynamicMesh3& EditMesh)
+				{
+					OutFragment.Mesh = MoveTemp(EditMesh);
+					EditMesh.Clear();
+				}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::Unknown, true);
+
+			for (auto&& Socket : StaticMesh->Sockets)
+			{
+				Sockets.Add(Socket->SocketName, Socket);
+			}
+
+			// Figure out mesh transform
+
+			OutFragment.Transform = Fragment.Attachment.Offset;
+
+			if (!Fragment.Attachment.Socket.IsNone())
+			{
+				if (auto&& Socket = Sockets.Find(Fragment.Attachment.Socket);
+					Socket && IsValid(*Socket))
+				{
+					OutFragment.Transform *= FTransform((*Socket)->RelativeRotation, (*Socket)->RelativeLocation, (*Socket)->RelativeScale);
+				}
+			}
+
+			// Align material IDs
+
+			const int32 NumStaticMaterials = StaticMesh->GetStaticMaterials().Num();
+			const int32 NumDynamicMaterials = Fragment.Materials.Num();
+			const int32 MaterialOverrideNum = FMath::Min(NumStaticMaterials, NumDynamicMaterials);
+
+			OutFragment.MaterialRemap.SetNumUninitialized(MaterialOverrideNum);
+			for (int32 MatOverrideIndex = 0; MatOverrideIndex < MaterialOverrideNum; ++MatOverrideIndex)
+			{
+				if (const int32 ExistingIndex = OutMaterials.IndexOfByPredicate(
+					[&](const FFaerieItemMaterial& IndexedMat)
+					{
+						return IndexedMat.Material == StaticMesh->GetMaterial(MatOverrideIndex);
+					});
+					ExistingIndex != INDEX_NONE)
+				{
+					OutFragment.MaterialRemap[MatOverrideIndex] = ExistingIndex;
+				}
+				else
+				{
+					OutFragment.MaterialRemap[MatOverrideIndex] = OutMaterials.Add(Fragment.Materials[MatOverrideIndex]);
+				}
+			}
 		}
+	}
 
-		// Figure out mesh transform
+	// Appends all fragments into one mesh. Only touches the CPU-side meshes, so it can run on any thread.
+	static UE::Geometry::FDynamicMesh3 AssembleFragments(TArray<FMeshFragment>& Fragments)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_MeshSubsystem_AssembleFragments);
 
-		FTransform AppendTransform = Fragment.Attachment.Offset;
+		UE::Geometry::FDynamicMesh3 OutMesh;
+		UE::Geometry::FDynamicMeshEditor Editor(&OutMesh);
 
-		if (!Fragment.Attachment.Socket.IsNone())
+		for (FMeshFragment& Fragment : Fragments)
 		{
-			if (auto&& Socket = Sockets.Find(Fragment.Attachment.Socket);
-				Socket && IsValid(*Socket))
+			if (Fragment.Mesh.HasAttributes() && Fragment.Mesh.Attributes()->HasMaterialID())
 			{
-				AppendTransform *= FTransform((*Socket)->RelativeRotation, (*Socket)->RelativeLocation, (*Socket)->RelativeScale);
+				UE::Geometry::FDynamicMeshMaterialAttribute* MaterialIDs = Fragment.Mesh.Attributes()->GetMaterialID();
+				for (const int32 TriangleID : Fragment.Mesh.TriangleIndicesItr())
+				{
+					if (const int32 MaterialID = MaterialIDs->GetValue(TriangleID);
+						Fragment.MaterialRemap.IsValidIndex(MaterialID))
+					{
+						MaterialIDs->SetValue(TriangleID, Fragment.MaterialRemap[MaterialID]);
+					}
+				}
 			}
+
+			OutMesh.EnableMatchingAttributes(Fragment.Mesh, false);
+
+			const UE::Geometry::FTransformSRT3d Transform(Fragment.Transform);
+			UE::Geometry::FMeshIndexMappings Mappings;
+			Editor.AppendMesh(&Fragment.Mesh, Mappings,
+				[&Transform](int32, const FVector3d& Position) { return Transform.TransformPosition(Position); },
+				[&Transform](int32, const FVector3d& Normal) { return Transform.TransformNormal(Normal); });
 		}
 
-		// Align material IDs
+		return OutMesh;
+	}
 
-		const int32 NumStaticMaterials = Fragment.StaticMesh->GetStaticMaterials().Num();
-		const int32 NumDynamicMaterials = Fragment.Materials.Num();
-		const int32 MaterialOverrideNum = FMath::Min(NumStaticMaterials, NumDynamicMaterials);
+	// The object generated for a mesh, which identifies it in the cache.
+	static const UObject* GetGeneratedObject(const FFaerieItemMesh& Mesh)
+	{
+		if (const UDynamicMesh* DynamicMesh = Mesh.GetDynamic())
+		{
+			return DynamicMesh;
+		}
+		return Mesh.GetSkeletal().Mesh;
+	}
 
-		for (int32 MatOverrideIndex = 0; MatOverrideIndex < MaterialOverrideNum; ++MatOverrideIndex)
+	// Approximate memory used by the geometry and attributes of a mesh.
+	static SIZE_T GetDynamicMeshBytes(const UE::Geometry::FDynamicMesh3& Mesh)
+	{
+		const SIZE_T NumVertices = Mesh.MaxVertexID();
+		const SIZE_T NumTriangles = Mesh.MaxTriangleID();
+
+		// Positions, and triangle vertices and edges. Each edge stores two vertices and two triangles.
+		SIZE_T Bytes = NumVertices * sizeof(FVector3d)
+					 + NumTriangles * sizeof(UE::Geometry::FIndex3i) * 2
+					 + Mesh.MaxEdgeID() * sizeof(int32) * 4;
+
+		if (const UE::Geometry::FDynamicMeshAttributeSet* Attributes = Mesh.Attributes())
 		{
-			if (const int32 ExistingIndex = Materials.IndexOfByPredicate(
-				[&](const FFaerieItemMaterial& IndexedMat)
-				{
-					return IndexedMat.Material == Fragment.StaticMesh->GetMaterial(MatOverrideIndex);
-				});
-				ExistingIndex != INDEX_NONE)
+			for (int32 i = 0; i < Attributes->NumUVLayers(); ++i)
 			{
-				UGeometryScriptLibrary_MeshMaterialFunctions::RemapMaterialIDs(AppendMesh, MatOverrideIndex, ExistingIndex);
+				Bytes += Attributes->GetUVLayer(i)->ElementCount() * sizeof(FVector2f) + NumTriangles * sizeof(UE::Geometry::FIndex3i);
 			}
-			else
+			for (int32 i = 0; i < Attributes->NumNormalLayers(); ++i)
 			{
-				const int32 NewIndex = Materials.Add(Fragment.Materials[MatOverrideIndex]);
-				UGeometryScriptLibrary_MeshMaterialFunctions::RemapMaterialIDs(AppendMesh, MatOverrideIndex, NewIndex);
+				Bytes += Attributes->GetNormalLayer(i)->ElementCount() * sizeof(FVector3f) + NumTriangles * sizeof(UE::Geometry::FIndex3i);
 			}
+			if (Attributes->HasMaterialID())
+			{
+				Bytes += NumTriangles * sizeof(int32);
+			}
+		}
+
+		return Bytes;
+	}
+
+	static SIZE_T GetGeneratedMeshBytes(const FFaerieItemMesh& Mesh)
+	{
+		if (const UDynamicMesh* DynamicMesh = Mesh.GetDynamic())
+		{
+			SIZE_T Bytes = 0;
+			DynamicMesh->ProcessMesh([&Bytes](const UE::Geometry::FDynamicMesh3& ReadMesh)
+				{
+					Bytes = GetDynamicMeshBytes(ReadMesh);
+				});
+			return Bytes;
 		}
 
-		// Commit new mesh
-		UGeometryScriptLibrary_MeshBasicEditFunctions::AppendMesh(OutMesh, AppendMesh, AppendTransform);
+		if (USkeletalMesh* SkeletalMesh = Mesh.GetSkeletal().Mesh)
+		{
+			return SkeletalMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+
+		return 0;
+	}
+}
+
+void UFaerieMeshSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FallbackPurpose = Faerie::ItemMesh::Tags::MeshPurpose_Default;
+}
+
+void UFaerieMeshSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_MeshCache_NumMeshes, CacheStats.NumMeshes);
+	DEC_MEMORY_STAT_BY(STAT_MeshCache_ResidentBytes, CacheStats.ResidentBytes);
+
+	GeneratedMeshes.Empty();
+	GeneratedMeshHashes.Empty();
+	UnusedMeshes.Empty();
+	PendingLoads.Empty();
+	CacheStats.NumMeshes = 0;
+	CacheStats.ResidentBytes = 0;
+
+	Super::Deinitialize();
+}
+
+FFaerieItemMesh UFaerieMeshSubsystem::GetDynamicStaticMeshForData(const FFaerieDynamicStaticMesh& MeshData)
+{
+	if (MeshData.Fragments.IsEmpty())
+	{
+		return FFaerieItemMesh();
+	}
 
-		// Trash temp dynamic mesh.
-		AppendMesh->MarkAsGarbage();
+	for (const FFaerieDynamicStaticMeshFragment& Fragment : MeshData.Fragments)
+	{
+		Fragment.StaticMesh.LoadSynchronous();
 	}
 
+	TArray<Faerie::ItemMesh::Private::FMeshFragment> Fragments;
+	TArray<FFaerieItemMaterial> Materials;
+	Faerie::ItemMesh::Private::PrepareFragments(MeshData, Fragments, Materials);
+
+	// The final mesh we will return.
+	UDynamicMesh* OutMesh = NewObject<UDynamicMesh>();
+	OutMesh->SetMesh(Faerie::ItemMesh::Private::AssembleFragments(Fragments));
+
 	return FFaerieItemMesh::MakeDynamic(OutMesh, Materials);
 }
 
@@ -130,25 +303,7 @@ bool UFaerieMeshSubsystem::LoadMeshFromTokenSynchronous(const UFaerieMeshTokenBa
 		return false;
 	}
 
-	const FFaerieCachedMeshKey Key = {Token, Purpose};
-
-	// If we have already generated this mesh, just return that one.
-	if (auto&& CachedMesh = GeneratedMeshes.Find(Key))
-	{
-		Mesh = *CachedMesh;
-		return true;
-	}
-
-	FGameplayTagContainer PurposeHierarchy;
-	if (Purpose != Faerie::ItemMesh::Tags::MeshPurpose_Default)
-	{
-		PurposeHierarchy.AddTagFast(Purpose);
-	}
-	if (FallbackPurpose.IsValid() && FallbackPurpose != Faerie::ItemMesh::Tags::MeshPurpose_Default)
-	{
-		PurposeHierarchy.AddTagFast(FallbackPurpose);
-	}
-	PurposeHierarchy.AddTagFast(Faerie::ItemMesh::Tags::MeshPurpose_Default);
+	const FGameplayTagContainer PurposeHierarchy = MakePurposeHierarchy(Purpose);
 
 	// Check for the presence of a custom dynamic mesh to build.
 
@@ -158,11 +313,18 @@ bool UFaerieMeshSubsystem::LoadMeshFromTokenSynchronous(const UFaerieMeshTokenBa
 		{
 			if (SkeletalMesh.Purpose.HasAnyExact(PurposeHierarchy))
 			{
+				// If we have already generated this mesh, just return that one.
+				const uint64 Hash = Faerie::ItemMesh::HashMeshData(SkeletalMesh);
+				if (FindCachedMesh(Hash, Mesh))
+				{
+					return true;
+				}
+
 				Mesh = GetDynamicSkeletalMeshForData(SkeletalMesh);
 
 				if (Mesh.IsSkeletal())
 				{
-					GeneratedMeshes.Add(Key, Mesh);
+					AddCachedMesh(Hash, Mesh);
 					return true;
 				}
 			}
@@ -170,13 +332,21 @@ bool UFaerieMeshSubsystem::LoadMeshFromTokenSynchronous(const UFaerieMeshTokenBa
 
 		for (auto&& StaticMesh : DynamicMeshToken->DynamicMeshContainer.StaticMeshes)
 		{
-			if (StaticMesh.Purpose.HasAnyExact(PurposeHierarchy))
+			if (StaticMesh.Purpose.HasAnyExact(PurposeHierarchy) &&
+				!StaticMesh.Fragments.IsEmpty())
 			{
+				// If we have already generated this mesh, just return that one.
+				const uint64 Hash = Faerie::ItemMesh::HashMeshData(StaticMesh);
+				if (FindCachedMesh(Hash, Mesh))
+				{
+					return true;
+				}
+
 				Mesh = GetDynamicStaticMeshForData(StaticMesh);
 
 				if (Mesh.IsDynamic())
 				{
-					GeneratedMeshes.Add(Key, Mesh);
+					AddCachedMesh(Hash, Mesh);
 					return true;
 				}
 			}
@@ -184,13 +354,12 @@ bool UFaerieMeshSubsystem::LoadMeshFromTokenSynchronous(const UFaerieMeshTokenBa
 	}
 
 
-	// Otherwise, scan and load pre-defined mesh data.
+	// Otherwise, scan and load pre-defined mesh data. These are assets already shared by every item, so they aren't cached.
 
 	if (FFaerieSkeletalMeshData SkelMeshData;
 		Token->GetSkeletalItemMesh(PurposeHierarchy, SkelMeshData))
 	{
 		Mesh = FFaerieItemMesh::MakeSkeletal(SkelMeshData.SkeletonAndAnimClass.LoadSynchronous(), SkelMeshData.Materials);
-		GeneratedMeshes.Add(Key, Mesh);
 		return true;
 	}
 
@@ -198,7 +367,6 @@ bool UFaerieMeshSubsystem::LoadMeshFromTokenSynchronous(const UFaerieMeshTokenBa
 		Token->GetStaticItemMesh(PurposeHierarchy, StaticMeshData))
 	{
 		Mesh = FFaerieItemMesh::MakeStatic(StaticMeshData.StaticMesh.LoadSynchronous(), StaticMeshData.Materials);
-		GeneratedMeshes.Add(Key, Mesh);
 		return true;
 	}
 
@@ -230,4 +398,363 @@ bool UFaerieMeshSubsystem::LoadMeshFromProxySynchronous(const FFaerieItemProxy P
 		return LoadMeshFromTokenSynchronous(MeshToken, Purpose, Mesh);
 	}
 	return false;
+}
+
+void UFaerieMeshSubsystem::LoadMeshFromTokenAsync(const UFaerieMeshTokenBase* Token, const FGameplayTag Purpose,
+												  const FFaerieMeshLoadResult& Callback)
+{
+	if (!IsValid(Token))
+	{
+		UE_LOG(LogTemp, Warning, __FUNCTION__ TEXT(": No MeshToken on entry"))
+		Callback.ExecuteIfBound(false, FFaerieItemMesh());
+		return;
+	}
+
+	const FGameplayTagContainer PurposeHierarchy = MakePurposeHierarchy(Purpose);
+
+	// Check for the presence of a custom dynamic mesh to build.
+
+	if (auto&& DynamicMeshToken = Cast<UFaerieMeshToken_Dynamic>(Token))
+	{
+		for (auto&& SkeletalMesh : DynamicMeshToken->DynamicMeshContainer.SkeletalMeshes)
+		{
+			if (SkeletalMesh.Purpose.HasAnyExact(PurposeHierarchy))
+			{
+				// If we have already generated this mesh, just return that one.
+				const uint64 Hash = Faerie::ItemMesh::HashMeshData(SkeletalMesh);
+				if (FFaerieItemMesh Mesh;
+					FindCachedMesh(Hash, Mesh))
+				{
+					Callback.ExecuteIfBound(true, Mesh);
+					return;
+				}
+
+				// Skeletal merging doesn't stream anything, so this completes immediately.
+				if (const FFaerieItemMesh Mesh = GetDynamicSkeletalMeshForData(SkeletalMesh);
+					Mesh.IsSkeletal())
+				{
+					AddCachedMesh(Hash, Mesh);
+					Callback.ExecuteIfBound(true, Mesh);
+					return;
+				}
+			}
+		}
+
+		for (auto&& StaticMesh : DynamicMeshToken->DynamicMeshContainer.StaticMeshes)
+		{
+			if (StaticMesh.Purpose.HasAnyExact(PurposeHierarchy) &&
+				!StaticMesh.Fragments.IsEmpty())
+			{
+				// If we have already generated this mesh, just return that one.
+				const uint64 Hash = Faerie::ItemMesh::HashMeshData(StaticMesh);
+				if (FFaerieItemMesh Mesh;
+					FindCachedMesh(Hash, Mesh))
+				{
+					Callback.ExecuteIfBound(true, Mesh);
+					return;
+				}
+
+				// If this mesh is already being loaded, wait for that load to finish.
+				if (auto&& Pending = PendingLoads.Find(Hash))
+				{
+					Pending->Add(Callback);
+					return;
+				}
+
+				PendingLoads.Add(Hash).Add(Callback);
+
+				TArray<FSoftObjectPath> ObjectsToLoad;
+				for (const FFaerieDynamicStaticMeshFragment& Fragment : StaticMesh.Fragments)
+				{
+					if (!Fragment.StaticMesh.IsNull())
+					{
+						ObjectsToLoad.AddUnique(Fragment.StaticMesh.ToSoftObjectPath());
+					}
+				}
+
+				Faerie::ItemMesh::Private::RequestAsyncLoad(MoveTemp(ObjectsToLoad),
+					FStreamableDelegate::CreateUObject(this, &ThisClass::OnDynamicStaticMeshLoaded, Hash, StaticMesh));
+				return;
+			}
+		}
+	}
+
+	// Otherwise, stream in pre-defined mesh data.
+
+	if (FFaerieSkeletalMeshData SkelMeshData;
+		Token->GetSkeletalItemMesh(PurposeHierarchy, SkelMeshData))
+	{
+		TArray<FSoftObjectPath> ObjectsToLoad;
+		if (!SkelMeshData.SkeletonAndAnimClass.Mesh.IsNull())
+		{
+			ObjectsToLoad.Add(SkelMeshData.SkeletonAndAnimClass.Mesh.ToSoftObjectPath());
+		}
+		if (!SkelMeshData.SkeletonAndAnimClass.AnimClass.IsNull())
+		{
+			ObjectsToLoad.Add(SkelMeshData.SkeletonAndAnimClass.AnimClass.ToSoftObjectPath());
+		}
+
+		Faerie::ItemMesh::Private::RequestAsyncLoad(MoveTemp(ObjectsToLoad),
+			FStreamableDelegate::CreateWeakLambda(this, [Callback, SkelMeshData]
+			{
+				const FFaerieItemMesh Mesh = FFaerieItemMesh::MakeSkeletal(SkelMeshData.SkeletonAndAnimClass.LoadSynchronous(), SkelMeshData.Materials);
+				Callback.ExecuteIfBound(Mesh.IsSkeletal(), Mesh);
+			}));
+		return;
+	}
+
+	if (FFaerieStaticMeshData StaticMeshData;
+		Token->GetStaticItemMesh(PurposeHierarchy, StaticMeshData))
+	{
+		TArray<FSoftObjectPath> ObjectsToLoad;
+		if (!StaticMeshData.StaticMesh.IsNull())
+		{
+			ObjectsToLoad.Add(StaticMeshData.StaticMesh.ToSoftObjectPath());
+		}
+
+		Faerie::ItemMesh::Private::RequestAsyncLoad(MoveTemp(ObjectsToLoad),
+			FStreamableDelegate::CreateWeakLambda(this, [Callback, StaticMeshData]
+			{
+				const FFaerieItemMesh Mesh = FFaerieItemMesh::MakeStatic(StaticMeshData.StaticMesh.Get(), StaticMeshData.Materials);
+				Callback.ExecuteIfBound(Mesh.IsStatic(), Mesh);
+			}));
+		return;
+	}
+
+	UE_LOG(LogTemp, Error, __FUNCTION__ TEXT(": Asset does not contain a mesh suitable for the purpose."))
+	Callback.ExecuteIfBound(false, FFaerieItemMesh());
+}
+
+void UFaerieMeshSubsystem::LoadMeshFromProxyAsync(const FFaerieItemProxy Proxy, const FGameplayTag Purpose,
+												  const FFaerieMeshLoadResult& Callback)
+{
+	if (!ensure(Proxy.IsValid()))
+	{
+		UE_LOG(LogTemp, Warning, __FUNCTION__ TEXT(": Invalid proxy!"))
+		Callback.ExecuteIfBound(false, FFaerieItemMesh());
+		return;
+	}
+
+	if (!IsValid(Proxy->GetItemObject()))
+	{
+		UE_LOG(LogTemp, Error, __FUNCTION__ TEXT(": Invalid item object!"))
+		Callback.ExecuteIfBound(false, FFaerieItemMesh());
+		return;
+	}
+
+	LoadMeshFromTokenAsync(Proxy->GetItemObject()->GetToken<UFaerieMeshTokenBase>(), Purpose, Callback);
+}
+
+void UFaerieMeshSubsystem::BP_LoadMeshFromTokenAsync(const UFaerieMeshTokenBase* Token, const FGameplayTag Purpose,
+													 const FFaerieMeshLoadResultDynamic& Callback)
+{
+	LoadMeshFromTokenAsync(Token, Purpose, FFaerieMeshLoadResult::CreateWeakLambda(Callback.GetUObject(),
+		[Callback](const bool Success, const FFaerieItemMesh& Mesh)
+		{
+			Callback.ExecuteIfBound(Success, Mesh);
+		}));
+}
+
+void UFaerieMeshSubsystem::BP_LoadMeshFromProxyAsync(const FFaerieItemProxy Proxy, const FGameplayTag Purpose,
+													 const FFaerieMeshLoadResultDynamic& Callback)
+{
+	LoadMeshFromProxyAsync(Proxy, Purpose, FFaerieMeshLoadResult::CreateWeakLambda(Callback.GetUObject(),
+		[Callback](const bool Success, const FFaerieItemMesh& Mesh)
+		{
+			Callback.ExecuteIfBound(Success, Mesh);
+		}));
+}
+
+FGameplayTagContainer UFaerieMeshSubsystem::MakePurposeHierarchy(const FGameplayTag Purpose) const
+{
+	FGameplayTagContainer PurposeHierarchy;
+	if (Purpose != Faerie::ItemMesh::Tags::MeshPurpose_Default)
+	{
+		PurposeHierarchy.AddTagFast(Purpose);
+	}
+	if (FallbackPurpose.IsValid() && FallbackPurpose != Faerie::ItemMesh::Tags::MeshPurpose_Default)
+	{
+		PurposeHierarchy.AddTagFast(FallbackPurpose);
+	}
+	PurposeHierarchy.AddTagFast(Faerie::ItemMesh::Tags::MeshPurpose_Default);
+	return PurposeHierarchy;
+}
+
+void UFaerieMeshSubsystem::OnDynamicStaticMeshLoaded(const uint64 Hash, const FFaerieDynamicStaticMesh MeshData)
+{
+	TArray<Faerie::ItemMesh::Private::FMeshFragment> Fragments;
+	TArray<FFaerieItemMaterial> Materials;
+	Faerie::ItemMesh::Private::PrepareFragments(MeshData, Fragments, Materials);
+
+	if (Fragments.IsEmpty())
+	{
+		FinishAsyncLoad(Hash, FFaerieItemMesh());
+		return;
+	}
+
+	// Append the fragments on a worker, then come back to the game thread to wrap the result in a UDynamicMesh.
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis = TWeakObjectPtr<ThisClass>(this), Hash, Fragments = MoveTemp(Fragments), Materials = MoveTemp(Materials)]() mutable
+		{
+			UE::Geometry::FDynamicMesh3 Assembled = Faerie::ItemMesh::Private::AssembleFragments(Fragments);
+
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, Hash, Assembled = MoveTemp(Assembled), Materials = MoveTemp(Materials)]() mutable
+				{
+					if (ThisClass* This = WeakThis.Get())
+					{
+						UDynamicMesh* OutMesh = NewObject<UDynamicMesh>();
+						OutMesh->SetMesh(MoveTemp(Assembled));
+						This->FinishAsyncLoad(Hash, FFaerieItemMesh::MakeDynamic(OutMesh, Materials));
+					}
+				});
+		});
+}
+
+void UFaerieMeshSubsystem::FinishAsyncLoad(const uint64 Hash, const FFaerieItemMesh& Mesh)
+{
+	FFaerieItemMesh Result = Mesh;
+
+	// A synchronous load may have generated the same mesh while this one was loading, so use that one instead.
+	if (const FFaerieCachedMesh* CachedMesh = GeneratedMeshes.Find(Hash))
+	{
+		Result = CachedMesh->Mesh;
+	}
+	else if (Result.IsDynamic())
+	{
+		AddCachedMesh(Hash, Result);
+	}
+
+	const bool Success = Result.IsDynamic();
+
+	TArray<FFaerieMeshLoadResult> Callbacks;
+	PendingLoads.RemoveAndCopyValue(Hash, Callbacks);
+	for (const FFaerieMeshLoadResult& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(Success, Result);
+	}
+}
+
+void UFaerieMeshSubsystem::RetainMesh(const FFaerieItemMesh& Mesh)
+{
+	const uint64* Hash = GeneratedMeshHashes.Find(Faerie::ItemMesh::Private::GetGeneratedObject(Mesh));
+	if (!Hash)
+	{
+		return;
+	}
+
+	FFaerieCachedMesh& CachedMesh = GeneratedMeshes[*Hash];
+	if (CachedMesh.RefCount++ == 0 && CachedMesh.UnusedNode)
+	{
+		UnusedMeshes.RemoveNode(CachedMesh.UnusedNode);
+		CachedMesh.UnusedNode = nullptr;
+	}
+}
+
+void UFaerieMeshSubsystem::ReleaseMesh(const FFaerieItemMesh& Mesh)
+{
+	const uint64* Hash = GeneratedMeshHashes.Find(Faerie::ItemMesh::Private::GetGeneratedObject(Mesh));
+	if (!Hash)
+	{
+		return;
+	}
+
+	FFaerieCachedMesh& CachedMesh = GeneratedMeshes[*Hash];
+	if (!ensure(CachedMesh.RefCount > 0))
+	{
+		return;
+	}
+
+	if (--CachedMesh.RefCount == 0)
+	{
+		UnusedMeshes.AddTail(*Hash);
+		CachedMesh.UnusedNode = UnusedMeshes.GetTail();
+
+		// Meshes being displayed may have put the cache over budget, so it's trimmed as soon as one is free.
+		EvictUnusedMeshes(0);
+	}
+}
+
+bool UFaerieMeshSubsystem::FindCachedMesh(const uint64 Hash, FFaerieItemMesh& OutMesh)
+{
+	FFaerieCachedMesh* CachedMesh = GeneratedMeshes.Find(Hash);
+	if (!CachedMesh)
+	{
+		CacheStats.Misses++;
+		INC_DWORD_STAT(STAT_MeshCache_Misses);
+		return false;
+	}
+
+	CacheStats.Hits++;
+	INC_DWORD_STAT(STAT_MeshCache_Hits);
+
+	// Unused meshes that are found again go to the back of the eviction order.
+	if (CachedMesh->UnusedNode)
+	{
+		UnusedMeshes.RemoveNode(CachedMesh->UnusedNode);
+		UnusedMeshes.AddTail(Hash);
+		CachedMesh->UnusedNode = UnusedMeshes.GetTail();
+	}
+
+	OutMesh = CachedMesh->Mesh;
+	return true;
+}
+
+void UFaerieMeshSubsystem::AddCachedMesh(const uint64 Hash, const FFaerieItemMesh& Mesh)
+{
+	const UObject* GeneratedObject = Faerie::ItemMesh::Private::GetGeneratedObject(Mesh);
+	if (!GeneratedObject || GeneratedMeshes.Contains(Hash))
+	{
+		return;
+	}
+
+	const SIZE_T Bytes = Faerie::ItemMesh::Private::GetGeneratedMeshBytes(Mesh);
+	EvictUnusedMeshes(Bytes);
+
+	// New meshes start unused. Whoever displays them is expected to retain them.
+	FFaerieCachedMesh& CachedMesh = GeneratedMeshes.Add(Hash);
+	CachedMesh.Mesh = Mesh;
+	CachedMesh.Bytes = Bytes;
+	UnusedMeshes.AddTail(Hash);
+	CachedMesh.UnusedNode = UnusedMeshes.GetTail();
+	GeneratedMeshHashes.Add(GeneratedObject, Hash);
+
+	CacheStats.NumMeshes++;
+	CacheStats.ResidentBytes += Bytes;
+	INC_DWORD_STAT(STAT_MeshCache_NumMeshes);
+	INC_MEMORY_STAT_BY(STAT_MeshCache_ResidentBytes, Bytes);
+}
+
+void UFaerieMeshSubsystem::EvictUnusedMeshes(const SIZE_T IncomingBytes)
+{
+	const int64 Budget = static_cast<int64>(GetDefault<UFaerieMeshSettings>()->GeneratedMeshBudget) * 1024 * 1024;
+
+	while (UnusedMeshes.Num() > 0 &&
+		   CacheStats.ResidentBytes + static_cast<int64>(IncomingBytes) > Budget)
+	{
+		RemoveCachedMesh(UnusedMeshes.GetHead()->GetValue());
+
+		CacheStats.Evictions++;
+		INC_DWORD_STAT(STAT_MeshCache_Evictions);
+	}
+}
+
+void UFaerieMeshSubsystem::RemoveCachedMesh(const uint64 Hash)
+{
+	FFaerieCachedMesh CachedMesh;
+	if (!GeneratedMeshes.RemoveAndCopyValue(Hash, CachedMesh))
+	{
+		return;
+	}
+
+	if (CachedMesh.UnusedNode)
+	{
+		UnusedMeshes.RemoveNode(CachedMesh.UnusedNode);
+	}
+	GeneratedMeshHashes.Remove(Faerie::ItemMesh::Private::GetGeneratedObject(CachedMesh.Mesh));
+
+	CacheStats.NumMeshes--;
+	CacheStats.ResidentBytes -= CachedMesh.Bytes;
+	DEC_DWORD_STAT(STAT_MeshCache_NumMeshes);
+	DEC_MEMORY_STAT_BY(STAT_MeshCache_ResidentBytes, CachedMesh.Bytes);
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 #include "FaerieItemMeshComponent.generated.h"
 
+class UFaerieMeshSubsystem;
 
 UCLASS(ClassGroup = ("Faerie"), meta = (BlueprintSpawnableComponent))
 class FAERIEITEMMESH_API UFaerieItemMeshComponent : public USceneComponent
@@ -19,8 +20,16 @@ public:
 	UFaerieItemMeshComponent();
 
 	virtual void DestroyComponent(bool bPromoteChildren = false) override;
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
 protected:
+	// Meshes are retained in the mesh subsystem while this component displays them, so they aren't evicted.
+	UFaerieMeshSubsystem* GetMeshSubsystem() const;
+
+	// Release MeshData, if this component retained it. Copies of a component share its MeshData, but not its retain.
+	void ReleaseRetainedMesh();
+
 	// @todo this will LoadSync the meshes. Make an async version of RebuildMesh and expose a boolean to select between them
 	void RebuildMesh();
 
@@ -59,4 +68,8 @@ protected:
 	// Component generated at runtime to display the appropriate mesh from MeshData.
 	UPROPERTY(BlueprintReadOnly, Category = "State")
 	TObjectPtr<UMeshComponent> MeshComponent;
+
+private:
+	// Did SetItemMesh retain MeshData? Not a property, so duplicated components don't inherit it.
+	bool bRetainedMesh = false;
 };
\ No newline at end of file
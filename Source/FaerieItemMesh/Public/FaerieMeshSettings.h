@@ -0,0 +1,25 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "FaerieMeshSettings.generated.h"
+
+/**
+ * Project settings for UFaerieMeshSubsystem.
+ */
+UCLASS(Config = "Project", defaultconfig, meta = (DisplayName = "Faerie Item Mesh"))
+class FAERIEITEMMESH_API UFaerieMeshSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// UDeveloperSettings implementation
+	virtual FName GetCategoryName() const override;
+	// End UDeveloperSettings implementation
+
+	// Each world's cache of generated meshes is kept under this many megabytes, by evicting the least recently used
+	// meshes that nothing is displaying. Meshes that are being displayed are never evicted, even when over budget.
+	UPROPERTY(Config, EditAnywhere, Category = "Cache", meta = (ClampMin = 0, UIMin = 0, Units = "Megabytes"))
+	int32 GeneratedMeshBudget = 64;
+};
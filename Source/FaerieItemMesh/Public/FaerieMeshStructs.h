@@ -144,6 +144,14 @@ FORCEINLINE uint32 GetTypeHash(const FFaerieDynamicSkeletalMesh& FaerieDynamicSk
 	return FCrc::MemCrc32(&FaerieDynamicSkeletalMesh, sizeof(FFaerieDynamicSkeletalMesh));
 }
 
+namespace Faerie::ItemMesh
+{
+	// Hashes the assets, materials, and attachments of each fragment, so that equal mesh data on different items has
+	// the same hash. Purpose is not included, as it only decides which mesh is used, not what it looks like.
+	FAERIEITEMMESH_API uint64 HashMeshData(const FFaerieDynamicStaticMesh& MeshData);
+	FAERIEITEMMESH_API uint64 HashMeshData(const FFaerieDynamicSkeletalMesh& MeshData);
+}
+
 /**
  * A mesh data container for editor defined static and skeletal meshes.
  */
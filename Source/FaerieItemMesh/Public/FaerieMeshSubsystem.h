@@ -4,51 +4,71 @@
 
 #include "FaerieItemProxy.h"
 #include "GameplayTagContainer.h"
+#include "Containers/List.h"
 #include "FaerieMeshStructs.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "FaerieMeshSubsystem.generated.h"
 
 class UFaerieMeshTokenBase;
 
+using FFaerieMeshLoadResult = TDelegate<void(bool, const FFaerieItemMesh&)>;
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FFaerieMeshLoadResultDynamic, bool, Success, const FFaerieItemMesh&, Mesh);
+
 /**
- *
+ * A generated mesh in the mesh subsystem's cache.
  */
 USTRUCT()
-struct FFaerieCachedMeshKey
+struct FFaerieCachedMesh
 {
 	GENERATED_BODY()
 
 	UPROPERTY()
-	TWeakObjectPtr<const UFaerieMeshTokenBase> Token;
+	FFaerieItemMesh Mesh;
 
-	UPROPERTY()
-	FGameplayTag Purpose;
+	// Approximate memory used by the mesh.
+	SIZE_T Bytes = 0;
 
-	bool IsTokenValid() const
-	{
-		return Token.IsValid();
-	}
+	// Number of consumers displaying this mesh. Only meshes without consumers can be evicted.
+	int32 RefCount = 0;
 
-	friend bool operator==(const FFaerieCachedMeshKey& Lhs, const FFaerieCachedMeshKey& Rhs)
-	{
-		return Lhs.Token == Rhs.Token &&
-			   Lhs.Purpose == Rhs.Purpose;
-	}
-
-	friend bool operator!=(const FFaerieCachedMeshKey& Lhs, const FFaerieCachedMeshKey& Rhs)
-	{
-		return !(Lhs == Rhs);
-	}
+	// Position in the eviction order, while nothing is displaying this mesh.
+	TDoubleLinkedList<uint64>::TDoubleLinkedListNode* UnusedNode = nullptr;
 };
 
-FORCEINLINE uint32 GetTypeHash(const FFaerieCachedMeshKey& Key)
+/**
+ * Counters for the mesh subsystem's cache.
+ */
+USTRUCT(BlueprintType)
+struct FFaerieMeshCacheStats
 {
-	return HashCombine(GetTypeHash(Key.Token), GetTypeHash(Key.Purpose));
-}
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Mesh Cache Stats")
+	int64 Hits = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Mesh Cache Stats")
+	int64 Misses = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Mesh Cache Stats")
+	int64 Evictions = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Mesh Cache Stats")
+	int32 NumMeshes = 0;
 
+	UPROPERTY(BlueprintReadOnly, Category = "Mesh Cache Stats")
+	int64 ResidentBytes = 0;
+
+	double GetHitRate() const
+	{
+		return Hits + Misses > 0 ? static_cast<double>(Hits) / (Hits + Misses) : 0.0;
+	}
+};
 
 /**
  * This is a world subsystem that stored dynamically generated meshes for items.
+ * Generated meshes are cached by a hash of their mesh data, so items with equal mesh data share one mesh. Consumers
+ * that display a mesh hold a reference to it with RetainMesh and ReleaseMesh. Meshes that nothing references are
+ * evicted, least recently used first, when the cache is over the budget in UFaerieMeshSettings.
  */
 UCLASS()
 class FAERIEITEMMESH_API UFaerieMeshSubsystem : public UWorldSubsystem
@@ -57,6 +77,7 @@ class FAERIEITEMMESH_API UFaerieMeshSubsystem : public UWorldSubsystem
 
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
 
 public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem")
@@ -65,18 +86,61 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem")
 	FFaerieItemMesh GetDynamicSkeletalMeshForData(const FFaerieDynamicSkeletalMesh& MeshData) const;
 
-	// todo make async version of this function? In practice this function hasn't been "that" slow, but for more complex meshes it might be.
 	// Immediately retrieves the mesh for an item.
-	// WARNING: This can cause a hitch if the mesh is not cached and it requires a lengthy assembly.
+	// WARNING: This can cause a hitch if the mesh is not cached and it requires a lengthy assembly. See LoadMeshFromTokenAsync.
 	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem", meta = (GameplayTagFilter = "MeshPurpose", ExpandBoolAsExecs = "ReturnValue"))
 	bool LoadMeshFromTokenSynchronous(const UFaerieMeshTokenBase* Token, const FGameplayTag Purpose, FFaerieItemMesh& Mesh);
 
-	// todo make async version of this function? In practice this function hasn't been "that" slow, but for more complex meshes it might be.
 	// Immediately retrieves the mesh for an item.
-	// WARNING: This can cause a hitch if the mesh is not cached and it requires a lengthy assembly.
+	// WARNING: This can cause a hitch if the mesh is not cached and it requires a lengthy assembly. See LoadMeshFromProxyAsync.
 	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem", meta = (GameplayTagFilter = "MeshPurpose", ExpandBoolAsExecs = "ReturnValue"))
 	bool LoadMeshFromProxySynchronous(FFaerieItemProxy Proxy, const FGameplayTag Purpose, FFaerieItemMesh& Mesh);
 
+	// Retrieves the mesh for an item without blocking. Mesh assets are streamed in, and dynamic meshes are assembled on
+	// a worker thread. The callback is run on the game thread, immediately if the mesh is already cached. Requests for
+	// a mesh that is already loading wait for that load, instead of starting another.
+	void LoadMeshFromTokenAsync(const UFaerieMeshTokenBase* Token, FGameplayTag Purpose, const FFaerieMeshLoadResult& Callback);
+	void LoadMeshFromProxyAsync(FFaerieItemProxy Proxy, FGameplayTag Purpose, const FFaerieMeshLoadResult& Callback);
+
+	// Marks a mesh as being displayed, so it won't be evicted. Each call must be paired with a call to ReleaseMesh.
+	// Meshes that are not generated, or not cached, are ignored.
+	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem")
+	void RetainMesh(const FFaerieItemMesh& Mesh);
+
+	// Releases a mesh retained with RetainMesh. Meshes are kept after their last release, until the cache needs room.
+	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem")
+	void ReleaseMesh(const FFaerieItemMesh& Mesh);
+
+	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem")
+	FFaerieMeshCacheStats GetCacheStats() const { return CacheStats; }
+
+protected:
+	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem", meta = (GameplayTagFilter = "MeshPurpose", DisplayName = "Load Mesh From Token (Async)"))
+	void BP_LoadMeshFromTokenAsync(const UFaerieMeshTokenBase* Token, FGameplayTag Purpose, const FFaerieMeshLoadResultDynamic& Callback);
+
+	UFUNCTION(BlueprintCallable, Category = "Faerie|MeshSubsystem", meta = (GameplayTagFilter = "MeshPurpose", DisplayName = "Load Mesh From Proxy (Async)"))
+	void BP_LoadMeshFromProxyAsync(FFaerieItemProxy Proxy, FGameplayTag Purpose, const FFaerieMeshLoadResultDynamic& Callback);
+
+private:
+	// The purpose, then the fallback purpose, then the default purpose.
+	FGameplayTagContainer MakePurposeHierarchy(FGameplayTag Purpose) const;
+
+	void OnDynamicStaticMeshLoaded(uint64 Hash, FFaerieDynamicStaticMesh MeshData);
+
+	// Caches the mesh of a finished async load, and runs the callbacks waiting for it.
+	void FinishAsyncLoad(uint64 Hash, const FFaerieItemMesh& Mesh);
+
+	// Finds a cached mesh by the hash of its mesh data, and marks it as recently used.
+	bool FindCachedMesh(uint64 Hash, FFaerieItemMesh& OutMesh);
+
+	// Adds a generated mesh to the cache, evicting unused meshes to make room for it.
+	void AddCachedMesh(uint64 Hash, const FFaerieItemMesh& Mesh);
+
+	// Evicts unused meshes, least recently used first, until there is room for IncomingBytes more.
+	void EvictUnusedMeshes(SIZE_T IncomingBytes);
+
+	void RemoveCachedMesh(uint64 Hash);
+
 protected:
 	// If the purpose requested when loading a mesh is not available, the tag "MeshPurpose.Default" is normally used as
 	// a fallback. If this is set to a tag other than that, then this will be tried first, before the default.
@@ -85,8 +149,19 @@ protected:
 
 private:
 	/**
-	 * Stored meshes for quick lookup
+	 * Stored meshes for quick lookup, by the hash of the mesh data they were generated from.
 	 */
 	UPROPERTY(Transient)
-	TMap<FFaerieCachedMeshKey, FFaerieItemMesh> GeneratedMeshes;
+	TMap<uint64, FFaerieCachedMesh> GeneratedMeshes;
+
+	// The hash of each cached mesh, by the object generated for it. Used to find meshes being retained and released.
+	TMap<const UObject*, uint64> GeneratedMeshHashes;
+
+	// Hashes of cached meshes that nothing is displaying, least recently used first.
+	TDoubleLinkedList<uint64> UnusedMeshes;
+
+	FFaerieMeshCacheStats CacheStats;
+
+	// Callbacks waiting for each mesh being loaded asynchronously.
+	TMap<uint64, TArray<FFaerieMeshLoadResult>> PendingLoads;
 };
\ No newline at end of file